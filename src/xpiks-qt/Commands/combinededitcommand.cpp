@@ -89,6 +89,7 @@ std::shared_ptr<Commands::ICommandResult> Commands::CombinedEditCommand::execute
         setKeywords(metadata);
         setDescription(metadata);
         setTitle(metadata);
+        artworksBackups.back().diffWith(metadata);
 
         // do not save if Сlear flag present
         // to be able to restore from .xpks
@@ -790,6 +790,7 @@ void Commands::CommandManager::beforeDestructionCallback() const {
 
     m_ArtworksRepository->stopListeningToUnavailableFiles();
 
+    m_ArtItemsModel->stopScanningDirectories();
     m_ArtItemsModel->disconnect();
     m_ArtItemsModel->deleteAllItems();
     m_FilteredItemsModel->disconnect();
@@ -803,6 +804,8 @@ void Commands::CommandManager::beforeDestructionCallback() const {
     m_MetadataSaverService->stopSaving();
     m_AutoCompleteService->stopService();
     m_TranslationService->stopService();
+    m_MetadataIOCoordinator->stopExiftool();
+    m_MetadataIOCoordinator->saveReadCache();
 
 #ifndef CORE_TESTS
 
@@ -55,6 +55,7 @@ namespace Commands {
             artworksBackups.emplace_back(metadata);
 
             if (metadata->removeKeywords(m_KeywordsSet, m_CaseSensitive)) {
+                artworksBackups.back().diffWith(metadata);
                 indicesToUpdate.append(info.getOriginalIndex());
                 affectedItems.append(metadata);
             } else {
@@ -55,6 +55,8 @@ namespace Commands {
                     affectedArtworks.append(metadata);
                 }
             }
+
+            artworksBackups.back().diffWith(metadata);
         }
 
         if (affectedArtworks.size() > 0) {
@@ -60,9 +60,12 @@ namespace Commands {
             bool succeeded = metadata->replace(m_ReplaceWhat, m_ReplaceTo, m_Flags);
             if (succeeded) {
                 LOG_FOR_TESTS << "Succeeded";
+                artworksBackups.back().diffWith(metadata);
                 itemsToSave.append(metadata);
                 indicesToUpdate.append(index);
             } else {
+                // backups should match indices to update
+                artworksBackups.pop_back();
                 LOG_INFO << "Failed to replace [" << m_ReplaceWhat << "] to [" << m_ReplaceTo << "] in" << metadata->getFilepath();
             }
         }
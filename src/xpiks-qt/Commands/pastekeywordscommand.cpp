@@ -53,6 +53,7 @@ std::shared_ptr<Commands::ICommandResult> Commands::PasteKeywordsCommand::execut
         artworksBackups.emplace_back(metadata);
 
         metadata->appendKeywords(m_KeywordsList);
+        artworksBackups.back().diffWith(metadata);
         affectedArtworks.append(metadata);
     }
 
@@ -23,6 +23,7 @@
 #include <QReadWriteLock>
 #include <QReadLocker>
 #include <QWriteLocker>
+#include <QStringMatcher>
 #include "../SpellCheck/spellcheckitem.h"
 #include "../SpellCheck/spellsuggestionsitem.h"
 #include "../SpellCheck/spellcheckiteminfo.h"
@@ -36,9 +37,15 @@
 namespace Common {
     BasicKeywordsModel::BasicKeywordsModel(Hold &hold, QObject *parent):
         AbstractListModel(parent),
-        m_Hold(hold)
+        m_Hold(hold),
+        m_Revision(0)
     {}
 
+    BasicKeywordsModel::~BasicKeywordsModel() {
+        // every id in the list holds a reference in the pool
+        KeywordsPool::getInstance().release(m_KeywordIDs);
+    }
+
     void BasicKeywordsModel::removeItemsAtIndices(const QVector<QPair<int, int> > &ranges) {
         LOG_INFO << "#";
 
@@ -95,7 +102,7 @@ namespace Common {
 
         Q_UNUSED(readLocker);
 
-        return m_KeywordsSet.count();
+        return m_KeywordsList.length();
     }
 
     QSet<QString> BasicKeywordsModel::getKeywordsSet() {
@@ -103,7 +110,22 @@ namespace Common {
 
         Q_UNUSED(readLocker);
 
-        return m_KeywordsSet;
+        QSet<QString> result;
+        result.reserve(m_KeywordsList.length());
+
+        for (auto &keyword: m_KeywordsList) {
+            result.insert(keyword.toLower());
+        }
+
+        return result;
+    }
+
+    QVector<KeywordID> BasicKeywordsModel::getKeywordIDs() {
+        QReadLocker readLocker(&m_KeywordsLock);
+
+        Q_UNUSED(readLocker);
+
+        return m_KeywordIDs;
     }
 
     QString BasicKeywordsModel::getKeywordsString() {
@@ -274,12 +296,17 @@ namespace Common {
         if (canBeAddedUnsafe(sanitizedKeyword)) {
             int keywordsCount = m_KeywordsList.length();
 
-            m_KeywordsSet.insert(sanitizedKeyword.toLower());
+            QString pooledKeyword;
+            KeywordsPool &pool = KeywordsPool::getInstance();
+            KeywordID id = pool.intern(sanitizedKeyword, pooledKeyword);
             m_SpellCheckResults.append(true);
+            m_KeywordIDs.append(id);
+            m_InvariantIDs.insert(pool.getInvariantID(id));
 
             beginInsertRows(QModelIndex(), keywordsCount, keywordsCount);
-            m_KeywordsList.append(sanitizedKeyword);
+            m_KeywordsList.append(pooledKeyword);
             endInsertRows();
+            bumpRevision();
             added = true;
         }
 
@@ -287,13 +314,15 @@ namespace Common {
     }
 
     void BasicKeywordsModel::takeKeywordAtUnsafe(int index, QString &removedKeyword, bool &wasCorrect) {
-        const QString &keyword = m_KeywordsList.at(index);
-        QString invariant = keyword.toLower();
-
-        m_KeywordsSet.remove(invariant);
-
         removedKeyword = m_KeywordsList.takeAt(index);
+        KeywordsPool &pool = KeywordsPool::getInstance();
+        const KeywordID id = m_KeywordIDs.at(index);
+        // keywords are unique case-insensitively so invariant is not shared
+        m_InvariantIDs.remove(pool.getInvariantID(id));
+        pool.release(id);
+        m_KeywordIDs.remove(index);
         wasCorrect = m_SpellCheckResults.takeAt(index);
+        bumpRevision();
     }
 
     void BasicKeywordsModel::setKeywordsUnsafe(const QStringList &keywordsList) {
@@ -324,17 +353,22 @@ namespace Common {
         Q_ASSERT(size == appendedCount);
 
         if (size > 0) {
+            KeywordsPool &pool = KeywordsPool::getInstance();
             int rowsCount = m_KeywordsList.length();
             beginInsertRows(QModelIndex(), rowsCount, rowsCount + size - 1);
 
             for (int i = 0; i < size; ++i) {
                 const QString &keywordToAdd = keywordsToAdd.at(i);
-                m_KeywordsSet.insert(keywordToAdd.toLower());
+                QString pooledKeyword;
+                KeywordID id = pool.intern(keywordToAdd, pooledKeyword);
                 m_SpellCheckResults.append(true);
-                m_KeywordsList.append(keywordToAdd);
+                m_KeywordIDs.append(id);
+                m_InvariantIDs.insert(pool.getInvariantID(id));
+                m_KeywordsList.append(pooledKeyword);
             }
 
             endInsertRows();
+            bumpRevision();
         }
 
         return appendedCount;
@@ -351,7 +385,7 @@ namespace Common {
             QString lowerCasedNew = sanitized.toLower();
             QString lowerCasedExisting = existing.toLower();
 
-            if (!m_KeywordsSet.contains(lowerCasedNew)) {
+            if (!containsKeywordInvariantUnsafe(lowerCasedNew)) {
                 result = true;
             } else if (lowerCasedNew == lowerCasedExisting) {
                 result = true;
@@ -373,16 +407,16 @@ namespace Common {
             QString lowerCasedNew = sanitized.toLower();
             QString lowerCasedExisting = existing.toLower();
 
-            if (!m_KeywordsSet.contains(lowerCasedNew)) {
-                m_KeywordsSet.insert(lowerCasedNew);
-                m_KeywordsList[index] = sanitized;
-                m_KeywordsSet.remove(lowerCasedExisting);
+            if (!containsKeywordInvariantUnsafe(lowerCasedNew)) {
+                replaceKeywordIDUnsafe(index, sanitized);
+                bumpRevision();
                 LOG_INFO << "common case edit:" << existing << "->" << sanitized;
 
                 result = true;
             } else if (lowerCasedNew == lowerCasedExisting) {
                 LOG_INFO << "changing case in same keyword";
-                m_KeywordsList[index] = sanitized;
+                replaceKeywordIDUnsafe(index, sanitized);
+                bumpRevision();
 
                 result = true;
             } else {
@@ -393,6 +427,16 @@ namespace Common {
         return result;
     }
 
+    void BasicKeywordsModel::replaceKeywordIDUnsafe(int index, const QString &keyword) {
+        KeywordsPool &pool = KeywordsPool::getInstance();
+        const KeywordID previousID = m_KeywordIDs.at(index);
+        const KeywordID id = pool.intern(keyword, m_KeywordsList[index]);
+        m_KeywordIDs[index] = id;
+        m_InvariantIDs.remove(pool.getInvariantID(previousID));
+        m_InvariantIDs.insert(pool.getInvariantID(id));
+        pool.release(previousID);
+    }
+
     bool BasicKeywordsModel::replaceKeywordUnsafe(int index, const QString &existing, const QString &replacement) {
         bool result = false;
 
@@ -426,10 +470,14 @@ namespace Common {
             endResetModel();
 
             m_SpellCheckResults.clear();
-            m_KeywordsSet.clear();
+            KeywordsPool::getInstance().release(m_KeywordIDs);
+            m_KeywordIDs.clear();
+            m_InvariantIDs.clear();
+            bumpRevision();
         } else {
-            Q_ASSERT(m_KeywordsSet.isEmpty());
             Q_ASSERT(m_SpellCheckResults.isEmpty());
+            Q_ASSERT(m_KeywordIDs.isEmpty());
+            Q_ASSERT(m_InvariantIDs.isEmpty());
         }
 
         return anyKeywords;
@@ -552,7 +600,7 @@ namespace Common {
                     if (replacement.isEmpty()) {
                         LOG_INFO << "Replaced" << internal << "to empty";
                         indicesToRemove.append(i);
-                    } else if (m_KeywordsSet.contains(replacement.toLower())) {
+                    } else if (containsKeywordInvariantUnsafe(replacement)) {
                         LOG_INFO << "Replacing" << internal << "to" << replacement << "creates a duplicate";
                         indicesToRemove.append(i);
                     }
@@ -580,6 +628,24 @@ namespace Common {
         return containsKeywordUnsafe(searchTerm, searchFlags);
     }
 
+    bool BasicKeywordsModel::containsKeyword(const QStringMatcher &matcher) {
+        QReadLocker readLocker(&m_KeywordsLock);
+
+        Q_UNUSED(readLocker);
+
+        bool hasMatch = false;
+        const int length = m_KeywordsList.length();
+
+        for (int i = 0; i < length; ++i) {
+            if (matcher.indexIn(m_KeywordsList.at(i)) != -1) {
+                hasMatch = true;
+                break;
+            }
+        }
+
+        return hasMatch;
+    }
+
     bool BasicKeywordsModel::isEmpty() {
         QReadLocker readLocker(&m_KeywordsLock);
 
@@ -644,11 +710,24 @@ namespace Common {
 
     bool BasicKeywordsModel::canBeAddedUnsafe(const QString &keyword) const {
         bool isValid = Helpers::isValidKeyword(keyword);
-        bool result = isValid && !m_KeywordsSet.contains(keyword.toLower());
+        bool result = isValid && !containsKeywordInvariantUnsafe(keyword);
 
         return result;
     }
 
+    bool BasicKeywordsModel::containsKeywordInvariantUnsafe(const QString &keyword) const {
+        // one pool lookup for the keyword and then only the local set
+        bool found = false;
+        KeywordID invariantID;
+
+        // keyword unknown to the pool cannot be in any artwork
+        if (KeywordsPool::getInstance().tryGetInvariantID(keyword, invariantID)) {
+            found = m_InvariantIDs.contains(invariantID);
+        }
+
+        return found;
+    }
+
     bool BasicKeywordsModel::hasKeyword(const QString &keyword) {
         QReadLocker readLocker(&m_KeywordsLock);
 
@@ -865,7 +944,7 @@ namespace Common {
         const QString &existingCurrent = m_KeywordsList.at(index);
 
         if (existingCurrent == existingPrev) {
-            if (m_KeywordsSet.contains(replacement.toLower())) {
+            if (containsKeywordInvariantUnsafe(replacement)) {
                 isDuplicate = true;
                 LOG_INFO << "safe to remove duplicate [" << existingCurrent << "] at index" << index;
             } else {
@@ -875,7 +954,7 @@ namespace Common {
             QString existingFixed = existingCurrent;
             existingFixed.replace(existingPrev, replacement);
 
-            if (m_KeywordsSet.contains(existingFixed.toLower())) {
+            if (containsKeywordInvariantUnsafe(existingFixed)) {
                 isDuplicate = true;
                 LOG_INFO << "safe to remove composite duplicate [" << existingCurrent << "] at index" << index;
             } else {
@@ -30,11 +30,15 @@
 #include <QSet>
 #include <QVector>
 #include <QReadWriteLock>
+#include <QAtomicInt>
 #include "baseentity.h"
 #include "hold.h"
+#include "keywordspool.h"
 #include "../Common/flags.h"
 #include "../Common/imetadataoperator.h"
 
+class QStringMatcher;
+
 namespace SpellCheck {
     class SpellCheckQueryItem;
     class KeywordSpellSuggestions;
@@ -52,7 +56,7 @@ namespace Common {
     public:
         BasicKeywordsModel(Common::Hold &hold, QObject *parent=0);
 
-        virtual ~BasicKeywordsModel() {}
+        virtual ~BasicKeywordsModel();
 
     public:
         enum BasicKeywordsModel_Roles {
@@ -78,6 +82,10 @@ namespace Common {
     public:
         int getKeywordsCount();
         QSet<QString> getKeywordsSet();
+        // ids of keywords in the process-wide KeywordsPool
+        QVector<KeywordID> getKeywordIDs();
+        // changes every time keywords (or title and description in derived models) are modified
+        int getRevision() const { return m_Revision.load(); }
         virtual QString getKeywordsString();
 
     public:
@@ -100,6 +108,7 @@ namespace Common {
         int appendKeywordsUnsafe(const QStringList &keywordsList);
         bool canEditKeywordUnsafe(int index, const QString &replacement) const;
         bool editKeywordUnsafe(int index, const QString &replacement);
+        void replaceKeywordIDUnsafe(int index, const QString &keyword);
         bool replaceKeywordUnsafe(int index, const QString &existing, const QString &replacement);
         bool clearKeywordsUnsafe();
         bool containsKeywordUnsafe(const QString &searchTerm, Common::SearchFlags searchFlags=Common::SearchFlags::Keywords);
@@ -127,6 +136,7 @@ namespace Common {
 
     public:
         bool containsKeyword(const QString &searchTerm, Common::SearchFlags searchFlags=Common::SearchFlags::ExactKeywords);
+        bool containsKeyword(const QStringMatcher &matcher);
         virtual bool isEmpty();
         bool hasKeywordsSpellError();
 
@@ -145,6 +155,7 @@ namespace Common {
         const QVector<bool> &getSpellStatusesUnsafe() const { return m_SpellCheckResults; }
         void resetSpellCheckResultsUnsafe();
         bool canBeAddedUnsafe(const QString &keyword) const;
+        bool containsKeywordInvariantUnsafe(const QString &keyword) const;
 
     public:
         Q_INVOKABLE bool hasKeyword(const QString &keyword);
@@ -168,13 +179,17 @@ namespace Common {
 
     protected:
         virtual QHash<int, QByteArray> roleNames() const override;
+        void bumpRevision() { m_Revision.ref(); }
 
     private:
         Common::Hold &m_Hold;
         QStringList m_KeywordsList;
-        QSet<QString> m_KeywordsSet;
+        QVector<KeywordID> m_KeywordIDs;
+        // lower-cased forms of keywords for duplicates check without pool locks
+        QSet<KeywordID> m_InvariantIDs;
         QReadWriteLock m_KeywordsLock;
         QVector<bool> m_SpellCheckResults;
+        QAtomicInt m_Revision;
     };
 }
 
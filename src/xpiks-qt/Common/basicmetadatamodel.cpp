@@ -294,6 +294,7 @@ namespace Common {
         bool result = value != m_Description;
         if (result) {
             m_Description = value;
+            bumpRevision();
         }
 
         return result;
@@ -307,6 +308,7 @@ namespace Common {
         bool result = value != m_Title;
         if (result) {
             m_Title = value;
+            bumpRevision();
         }
 
         return result;
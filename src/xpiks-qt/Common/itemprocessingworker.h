@@ -27,6 +27,7 @@
 #include <deque>
 #include <memory>
 #include <vector>
+#include <functional>
 #include "../Common/defines.h"
 
 namespace Common {
@@ -36,7 +37,8 @@ namespace Common {
     public:
         ItemProcessingWorker():
             m_Cancel(false),
-            m_IsRunning(false)
+            m_IsRunning(false),
+            m_QueueDrained(false)
         { }
 
         virtual ~ItemProcessingWorker() { }
@@ -172,6 +174,32 @@ namespace Common {
         virtual void notifyQueueIsEmpty() = 0;
         virtual void workerStopped() = 0;
 
+        // moves items from the front of the queue while they match predicate
+        // returns true if queue has no more items
+        // should be called only from processOneItem()
+        bool takeQueuedItems(std::vector<std::shared_ptr<T> > &items, size_t maxCount,
+                             const std::function<bool (const std::shared_ptr<T> &)> &pred) {
+            QMutexLocker locker(&m_QueueMutex);
+            bool anyTaken = false;
+
+            while (!m_Queue.empty() && (items.size() < maxCount)) {
+                const std::shared_ptr<T> &item = m_Queue.front();
+                if (!item || !pred(item)) { break; }
+
+                items.push_back(item);
+                m_Queue.pop_front();
+                anyTaken = true;
+            }
+
+            bool isEmpty = m_Queue.empty();
+            // worker loop notifies about the queue emptied here after the batch
+            if (anyTaken && isEmpty) {
+                m_QueueDrained = true;
+            }
+
+            return isEmpty;
+        }
+
         void runWorkerLoop() {
             for (;;) {
                 if (m_Cancel) {
@@ -199,6 +227,8 @@ namespace Common {
 
                 if (item.get() == nullptr) { break; }
 
+                m_QueueDrained = false;
+
                 try {
                     processOneItem(item);
                 }
@@ -206,7 +236,7 @@ namespace Common {
                     LOG_WARNING << "Exception while processing item!";
                 }
 
-                if (noMoreItems) {
+                if (noMoreItems || m_QueueDrained) {
                     notifyQueueIsEmpty();
                 }
             }
@@ -218,6 +248,8 @@ namespace Common {
         std::deque<std::shared_ptr<T> > m_Queue;
         volatile bool m_Cancel;
         volatile bool m_IsRunning;
+        // accessed only from the worker thread
+        bool m_QueueDrained;
     };
 }
 
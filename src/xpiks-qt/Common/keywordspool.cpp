@@ -0,0 +1,277 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keywordspool.h"
+
+#define SHARD_MASK (KEYWORDS_POOL_SHARDS - 1)
+#define INVALID_KEYWORD_ID ((KeywordID)-1)
+
+namespace Common {
+    KeywordID makeKeywordID(quint32 index, int shardIndex) {
+        return (KeywordID)((index << KEYWORDS_POOL_SHARD_BITS) | (quint32)shardIndex);
+    }
+
+    int getShardOfID(KeywordID id) {
+        return (int)(id & SHARD_MASK);
+    }
+
+    quint32 getIndexOfID(KeywordID id) {
+        return id >> KEYWORDS_POOL_SHARD_BITS;
+    }
+
+    KeywordID KeywordsPool::intern(const QString &keyword, QString &pooledKeyword) {
+        const int shardIndex = getShardIndex(keyword);
+        PoolShard &shard = m_Shards[shardIndex];
+
+        KeywordID id;
+        if (tryAcquireExisting(shard, keyword, id, pooledKeyword)) {
+            return id;
+        }
+
+        const QString invariant = keyword.toLower();
+        const bool isInvariant = (invariant == keyword);
+
+        // lower-cased form is its own invariant and is held by every other form
+        KeywordID invariantID = INVALID_KEYWORD_ID;
+        if (!isInvariant) {
+            QString pooledInvariant;
+            invariantID = intern(invariant, pooledInvariant);
+        }
+
+        bool inserted = false;
+
+        shard.m_Lock.lockForWrite();
+        {
+            id = insertOrAcquireUnsafe(shardIndex, keyword, invariantID, pooledKeyword, inserted);
+        }
+        shard.m_Lock.unlock();
+
+        if (!inserted && !isInvariant) {
+            // same keyword was added by another thread meanwhile
+            release(invariantID);
+        }
+
+        return id;
+    }
+
+    void KeywordsPool::acquire(KeywordID id) {
+        const PoolShard &shard = m_Shards[getShardOfID(id)];
+
+        QReadLocker readLocker(&shard.m_Lock);
+        Q_UNUSED(readLocker);
+
+        const KeywordEntry &entry = getEntryUnsafe(id);
+        Q_ASSERT(entry.m_RefCount.load() > 0);
+        entry.m_RefCount.ref();
+    }
+
+    void KeywordsPool::acquire(const QVector<KeywordID> &ids) {
+        for (auto id: ids) {
+            acquire(id);
+        }
+    }
+
+    void KeywordsPool::release(KeywordID id) {
+        PoolShard &shard = m_Shards[getShardOfID(id)];
+        bool isUnused = false;
+
+        shard.m_Lock.lockForRead();
+        {
+            isUnused = !getEntryUnsafe(id).m_RefCount.deref();
+        }
+        shard.m_Lock.unlock();
+
+        if (!isUnused) { return; }
+
+        KeywordID invariantID = INVALID_KEYWORD_ID;
+
+        shard.m_Lock.lockForWrite();
+        {
+            const quint32 index = getIndexOfID(id);
+            KeywordEntry &entry = shard.m_Entries[index];
+
+            // keyword could be interned again before the write lock was taken
+            if ((entry.m_RefCount.load() == 0) && !entry.m_Keyword.isNull()) {
+                shard.m_KeywordsIDs.remove(entry.m_Keyword);
+                if (entry.m_InvariantID != id) {
+                    invariantID = entry.m_InvariantID;
+                }
+
+                entry.m_Keyword = QString();
+                entry.m_InvariantID = INVALID_KEYWORD_ID;
+                shard.m_FreeIndices.append(index);
+            }
+        }
+        shard.m_Lock.unlock();
+
+        if (invariantID != INVALID_KEYWORD_ID) {
+            release(invariantID);
+        }
+    }
+
+    void KeywordsPool::release(const QVector<KeywordID> &ids) {
+        for (auto id: ids) {
+            release(id);
+        }
+    }
+
+    bool KeywordsPool::tryGetInvariantID(const QString &keyword, KeywordID &invariantID) const {
+        bool found = findInvariantID(keyword, invariantID);
+
+        if (!found) {
+            found = findInvariantID(keyword.toLower(), invariantID);
+        }
+
+        return found;
+    }
+
+    KeywordID KeywordsPool::getInvariantID(KeywordID id) const {
+        const PoolShard &shard = m_Shards[getShardOfID(id)];
+
+        QReadLocker readLocker(&shard.m_Lock);
+        Q_UNUSED(readLocker);
+
+        return getEntryUnsafe(id).m_InvariantID;
+    }
+
+    QString KeywordsPool::getKeyword(KeywordID id) const {
+        const PoolShard &shard = m_Shards[getShardOfID(id)];
+
+        QReadLocker readLocker(&shard.m_Lock);
+        Q_UNUSED(readLocker);
+
+        return getEntryUnsafe(id).m_Keyword;
+    }
+
+    QStringList KeywordsPool::getKeywords(const QVector<KeywordID> &ids) const {
+        QStringList result;
+        result.reserve(ids.size());
+
+        for (auto id: ids) {
+            result.append(getKeyword(id));
+        }
+
+        return result;
+    }
+
+    bool KeywordsPool::containsInvariant(const QVector<KeywordID> &ids, KeywordID invariantID) const {
+        bool found = false;
+
+        for (auto id: ids) {
+            if (getInvariantID(id) == invariantID) {
+                found = true;
+                break;
+            }
+        }
+
+        return found;
+    }
+
+    int KeywordsPool::getKeywordsCount() const {
+        int count = 0;
+
+        for (int i = 0; i < KEYWORDS_POOL_SHARDS; ++i) {
+            const PoolShard &shard = m_Shards[i];
+
+            QReadLocker readLocker(&shard.m_Lock);
+            Q_UNUSED(readLocker);
+
+            count += shard.m_Entries.size() - shard.m_FreeIndices.size();
+        }
+
+        return count;
+    }
+
+    int KeywordsPool::getShardIndex(const QString &keyword) const {
+        return (int)(qHash(keyword) & SHARD_MASK);
+    }
+
+    const KeywordsPool::KeywordEntry &KeywordsPool::getEntryUnsafe(KeywordID id) const {
+        const PoolShard &shard = m_Shards[getShardOfID(id)];
+        const quint32 index = getIndexOfID(id);
+        Q_ASSERT(index < (quint32)shard.m_Entries.size());
+        return shard.m_Entries.at(index);
+    }
+
+    bool KeywordsPool::findInvariantID(const QString &keyword, KeywordID &invariantID) const {
+        const PoolShard &shard = m_Shards[getShardIndex(keyword)];
+
+        QReadLocker readLocker(&shard.m_Lock);
+        Q_UNUSED(readLocker);
+
+        auto it = shard.m_KeywordsIDs.constFind(keyword);
+        if (it == shard.m_KeywordsIDs.constEnd()) { return false; }
+
+        invariantID = getEntryUnsafe(it.value()).m_InvariantID;
+        return true;
+    }
+
+    bool KeywordsPool::tryAcquireExisting(PoolShard &shard, const QString &keyword, KeywordID &id, QString &pooledKeyword) {
+        QReadLocker readLocker(&shard.m_Lock);
+        Q_UNUSED(readLocker);
+
+        auto it = shard.m_KeywordsIDs.constFind(keyword);
+        if (it == shard.m_KeywordsIDs.constEnd()) { return false; }
+
+        id = it.value();
+        const KeywordEntry &entry = getEntryUnsafe(id);
+        // reference count is atomic so it is fine to change it under the read lock
+        entry.m_RefCount.ref();
+        pooledKeyword = entry.m_Keyword;
+
+        return true;
+    }
+
+    KeywordID KeywordsPool::insertOrAcquireUnsafe(int shardIndex, const QString &keyword, KeywordID invariantID,
+                                                  QString &pooledKeyword, bool &inserted) {
+        PoolShard &shard = m_Shards[shardIndex];
+
+        auto it = shard.m_KeywordsIDs.constFind(keyword);
+        if (it != shard.m_KeywordsIDs.constEnd()) {
+            const KeywordID id = it.value();
+            KeywordEntry &entry = shard.m_Entries[getIndexOfID(id)];
+            entry.m_RefCount.ref();
+            pooledKeyword = entry.m_Keyword;
+            inserted = false;
+            return id;
+        }
+
+        quint32 index;
+        if (!shard.m_FreeIndices.isEmpty()) {
+            index = shard.m_FreeIndices.takeLast();
+        } else {
+            index = (quint32)shard.m_Entries.size();
+            shard.m_Entries.append(KeywordEntry());
+        }
+
+        const KeywordID id = makeKeywordID(index, shardIndex);
+
+        KeywordEntry &entry = shard.m_Entries[index];
+        entry.m_Keyword = keyword;
+        entry.m_InvariantID = (invariantID == INVALID_KEYWORD_ID) ? id : invariantID;
+        entry.m_RefCount.store(1);
+        shard.m_KeywordsIDs.insert(keyword, id);
+
+        pooledKeyword = entry.m_Keyword;
+        inserted = true;
+        return id;
+    }
+}
@@ -0,0 +1,102 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEYWORDSPOOL_H
+#define KEYWORDSPOOL_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QVector>
+#include <QReadWriteLock>
+#include <QAtomicInt>
+
+#define KEYWORDS_POOL_SHARD_BITS 4
+#define KEYWORDS_POOL_SHARDS (1 << KEYWORDS_POOL_SHARD_BITS)
+
+namespace Common {
+    typedef quint32 KeywordID;
+
+    // process-wide table of unique keywords
+    // same keyword in different artworks shares one string
+    // and lower-cased form is computed only once
+    // keywords are reference counted and removed when nobody holds them
+    // table is split into shards so artworks on different threads rarely wait for each other
+    class KeywordsPool
+    {
+    public:
+        static KeywordsPool& getInstance()
+        {
+            static KeywordsPool instance; // Guaranteed to be destroyed.
+            // Instantiated on first use.
+            return instance;
+        }
+
+    public:
+        // returned id is acquired and should be released by the caller
+        KeywordID intern(const QString &keyword, QString &pooledKeyword);
+        KeywordID intern(const QString &keyword) { QString pooled; return intern(keyword, pooled); }
+        void acquire(KeywordID id);
+        void acquire(const QVector<KeywordID> &ids);
+        void release(KeywordID id);
+        void release(const QVector<KeywordID> &ids);
+        bool tryGetInvariantID(const QString &keyword, KeywordID &invariantID) const;
+        KeywordID getInvariantID(KeywordID id) const;
+        QString getKeyword(KeywordID id) const;
+        QStringList getKeywords(const QVector<KeywordID> &ids) const;
+        bool containsInvariant(const QVector<KeywordID> &ids, KeywordID invariantID) const;
+        int getKeywordsCount() const;
+
+    private:
+        struct KeywordEntry {
+            QString m_Keyword;
+            KeywordID m_InvariantID;
+            // changed under read lock of the shard
+            mutable QAtomicInt m_RefCount;
+        };
+
+        struct PoolShard {
+            mutable QReadWriteLock m_Lock;
+            QHash<QString, KeywordID> m_KeywordsIDs;
+            QVector<KeywordEntry> m_Entries;
+            // entries of released keywords are reused
+            QVector<quint32> m_FreeIndices;
+        };
+
+    private:
+        int getShardIndex(const QString &keyword) const;
+        const KeywordEntry &getEntryUnsafe(KeywordID id) const;
+        bool findInvariantID(const QString &keyword, KeywordID &invariantID) const;
+        bool tryAcquireExisting(PoolShard &shard, const QString &keyword, KeywordID &id, QString &pooledKeyword);
+        KeywordID insertOrAcquireUnsafe(int shardIndex, const QString &keyword, KeywordID invariantID,
+                                        QString &pooledKeyword, bool &inserted);
+
+    private:
+        KeywordsPool() {}
+        KeywordsPool(KeywordsPool const&);
+        void operator=(KeywordsPool const&);
+
+    private:
+        PoolShard m_Shards[KEYWORDS_POOL_SHARDS];
+    };
+}
+
+#endif // KEYWORDSPOOL_H
@@ -0,0 +1,70 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SHAREDWORKQUEUE_H
+#define SHAREDWORKQUEUE_H
+
+#include <QVector>
+#include <QAtomicInt>
+
+namespace Common {
+    // items are handed out one by one to whichever worker asks first
+    // so fast workers keep taking files while a slow one is busy
+    template<typename T>
+    class SharedWorkQueue
+    {
+    public:
+        SharedWorkQueue(const QVector<T> &items):
+            m_Items(items),
+            m_NextIndex(0),
+            m_ProcessedCount(0),
+            m_Cancel(false)
+        { }
+
+    public:
+        bool tryGetNext(T &item, int &index) {
+            if (m_Cancel) { return false; }
+
+            const int nextIndex = m_NextIndex.fetchAndAddOrdered(1);
+            if (nextIndex >= m_Items.size()) { return false; }
+
+            item = m_Items.at(nextIndex);
+            index = nextIndex;
+            return true;
+        }
+
+        // returns true if this was the last item
+        bool markProcessed() { return m_ProcessedCount.fetchAndAddOrdered(1) == (m_Items.size() - 1); }
+
+        void cancel() { m_Cancel = true; }
+        bool isCancelled() const { return m_Cancel; }
+        int size() const { return m_Items.size(); }
+        int getProcessedCount() const { return m_ProcessedCount.loadAcquire(); }
+
+    private:
+        QVector<T> m_Items;
+        QAtomicInt m_NextIndex;
+        QAtomicInt m_ProcessedCount;
+        volatile bool m_Cancel;
+    };
+}
+
+#endif // SHAREDWORKQUEUE_H
@@ -211,6 +211,13 @@ Item {
 
                         Connections {
                             target: metadataIOCoordinator
+                            onProcessedItemsCountChanged: {
+                                if (metadataExportComponent.isInProgress && (metadataIOCoordinator.processingItemsCount > 0)) {
+                                    var percent = Math.floor(value * 100 / metadataIOCoordinator.processingItemsCount)
+                                    exportButton.text = i18.n + qsTr("Exporting %1%...").arg(percent)
+                                }
+                            }
+
                             onMetadataWritingFinished: {
                                 metadataExportComponent.isInProgress = false
 
@@ -788,6 +788,58 @@ ApplicationWindow {
                         }
                     }
 
+                    RowLayout {
+                        width: parent.width
+                        spacing: 10
+
+                        StyledText {
+                            horizontalAlignment: Text.AlignRight
+                            text: i18.n + qsTr("Metadata threads:")
+                        }
+
+                        Rectangle {
+                            color: enabled ? Colors.inputBackgroundColor : Colors.inputInactiveBackground
+                            border.width: maxMetadataThreads.activeFocus ? 1 : 0
+                            border.color: Colors.artworkActiveColor
+                            width: 115
+                            height: UIConfig.textInputHeight
+                            clip: true
+
+                            StyledTextInput {
+                                id: maxMetadataThreads
+                                text: settingsModel.maxMetadataThreads
+                                anchors.left: parent.left
+                                anchors.right: parent.right
+                                anchors.leftMargin: 5
+                                anchors.rightMargin: 5
+                                anchors.verticalCenter: parent.verticalCenter
+                                onTextChanged: {
+                                    if (text.length > 0) {
+                                        settingsModel.maxMetadataThreads = parseInt(text)
+                                    }
+                                }
+
+                                function onResetRequested() {
+                                    text = settingsModel.maxMetadataThreads
+                                }
+
+                                Component.onCompleted: {
+                                    extTab.resetRequested.connect(maxMetadataThreads.onResetRequested)
+                                }
+
+                                validator: IntValidator {
+                                    bottom: 1
+                                    top: 16
+                                }
+                            }
+                        }
+
+                        StyledText {
+                            text: i18.n + qsTr("(used for reading without ExifTool)")
+                            isActive: false
+                        }
+                    }
+
                     StyledButton {
                         width: 200
                         text: i18.n + qsTr("Manage user dictionary")
@@ -95,6 +95,9 @@ namespace Helpers {
         Q_PROPERTY(QString maxParallelUploadsKey READ getMaxParallelUploadsKey CONSTANT)
         QString getMaxParallelUploadsKey() const { return QLatin1String(Constants::MAX_PARALLEL_UPLOADS); }
 
+        Q_PROPERTY(QString maxMetadataThreadsKey READ getMaxMetadataThreadsKey CONSTANT)
+        QString getMaxMetadataThreadsKey() const { return QLatin1String(Constants::MAX_METADATA_THREADS); }
+
         Q_PROPERTY(QString fitSmallPreviewKey READ getFitSmallPreviewKey CONSTANT)
         QString getFitSmallPreviewKey() const { return QLatin1String(Constants::FIT_SMALL_PREVIEW); }
 
@@ -65,8 +65,11 @@ namespace Constants {
     const char USE_CONFIRMATION_DIALOGS[] = "USE_CONFIRMATION_DIALOGS";
     const char RECENT_DIRECTORIES[] = "RECENT_DIRECTORIES";
     const char MAX_PARALLEL_UPLOADS[] = "MAX_PARALLEL_UPLOADS";
+    const char MAX_METADATA_THREADS[] = "MAX_METADATA_THREADS";
     const char USE_SPELL_CHECK[] = "USE_SPELL_CHECK";
     const char LIBRARY_FILENAME[] = "xpiks.v14.library";
+    const char METADATA_CACHE_FILENAME[] = "xpiks.v1.metadata.cache";
+    const char BACKUPS_JOURNAL_FILENAME[] = "xpiks.v1.backups.journal";
     const char USER_AGENT_ID[] = "USER_AGENT_ID";
     const char INSTALLED_VERSION[] = "INSTALLED_VERSION";
     const char USER_CONSENT[] = "USER_CONSENT_1_0";
@@ -76,10 +79,13 @@ namespace Constants {
     const char USE_EXIFTOOL[] = "USE_EXIFTOOL";
     const char IMAGES_CACHE_DIR[] = "imagescache";
     const char IMAGES_CACHE_INDEX[] = "imagescache.index";
+    const char SPELL_SUGGESTIONS_CACHE[] = "spellsuggestions.cache";
     const char CACHE_IMAGES_AUTOMATICALLY[] = "CACHE_IMAGES_AUTOMATICALLY";
     const char SCROLL_SPEED_SENSIVITY[] = "SCROLL_SPEED_SENSIVITY";
     const char AUTO_DOWNLOAD_UPDATES[] = "AUTO_DOWNLOAD_UPDATES";
     const char USER_DICT_FILENAME[] = "userdict.dic";
+    const char USER_DICT_COMPILED_FILENAME[] = "userdict.v1.compiled";
+    const char USER_DICT_JOURNAL_FILENAME[] = "userdict.v1.journal";
     const char PATH_TO_UPDATE[] = "PATH_TO_UPDATE";
     const char AVAILABLE_UPDATE_VERSION[] = "AVAILABLE_UPDATE_VERSION";
     const char ARTWORK_EDIT_RIGHT_PANE_WIDTH[] = "ARTWORK_EDIT_RIGHT_PANE_WIDTH";
@@ -93,6 +99,7 @@ namespace Constants {
     const char ONE_UPLOAD_SECONDS_TIMEMOUT[] = "DEBUG_ONE_UPLOAD_SECONDS_TIMEMOUT";
     const char USE_CONFIRMATION_DIALOGS[] = "DEBUG_USE_CONFIRMATION_DIALOGS";
     const char MAX_PARALLEL_UPLOADS[] = "DEBUG_MAX_PARALLEL_UPLOADS";
+    const char MAX_METADATA_THREADS[] = "DEBUG_MAX_METADATA_THREADS";
     const char USE_SPELL_CHECK[] = "DEBUG_USE_SPELL_CHECK";
     const char USER_AGENT_ID[] = "DEBUG_USER_AGENT_ID";
     const char INSTALLED_VERSION[] = "DEBUG_INSTALLED_VERSION";
@@ -104,6 +111,7 @@ namespace Constants {
     const char USE_EXIFTOOL[] = "DEBUG_USE_EXIFTOOL";
     const char IMAGES_CACHE_DIR[] = "debug_imagescache";
     const char IMAGES_CACHE_INDEX[] = "debug_imagescache.index";
+    const char SPELL_SUGGESTIONS_CACHE[] = "debug_spellsuggestions.cache";
     const char SCROLL_SPEED_SENSIVITY[] = "DEBUG_SCROLL_SPEED_SENSIVITY";
     const char AUTO_DOWNLOAD_UPDATES[] = "DEBUG_AUTO_DOWNLOAD_UPDATES";
     const char PATH_TO_UPDATE[] = "DEBUG_PATH_TO_UPDATE";
@@ -115,20 +123,28 @@ namespace Constants {
 
 #ifdef INTEGRATION_TESTS
     const char LIBRARY_FILENAME[] = "xpiks.integration.v14.library";
+    const char METADATA_CACHE_FILENAME[] = "xpiks.integration.v1.metadata.cache";
+    const char BACKUPS_JOURNAL_FILENAME[] = "xpiks.integration.v1.backups.journal";
     const char UPLOAD_HOSTS[] = "INTEGRATION_UPLOAD_HOSTS_HASH";
     const char USE_MASTER_PASSWORD[] = "INTEGRATION_USE_MASTER_PASSWORD";
     const char MASTER_PASSWORD_HASH[] = "INTEGRATION_MASTER_PASSWORD_HASH";
     const char RECENT_DIRECTORIES[] = "INTEGRATION_RECENT_DIRECTORIES";
     const char CACHE_IMAGES_AUTOMATICALLY[] = "INTEGRATION_CACHE_IMAGES_AUTOMATICALLY";
     const char USER_DICT_FILENAME[] = "userdict_debug_tests.dic";
+    const char USER_DICT_COMPILED_FILENAME[] = "userdict_debug_tests.v1.compiled";
+    const char USER_DICT_JOURNAL_FILENAME[] = "userdict_debug_tests.v1.journal";
 #else
     const char LIBRARY_FILENAME[] = "xpiks.debug.v14.library";
+    const char METADATA_CACHE_FILENAME[] = "xpiks.debug.v1.metadata.cache";
+    const char BACKUPS_JOURNAL_FILENAME[] = "xpiks.debug.v1.backups.journal";
     const char UPLOAD_HOSTS[] = "DEBUG_UPLOAD_HOSTS_HASH";
     const char USE_MASTER_PASSWORD[] = "DEBUG_USE_MASTER_PASSWORD";
     const char MASTER_PASSWORD_HASH[] = "DEBUG_MASTER_PASSWORD_HASH";
     const char RECENT_DIRECTORIES[] = "DEBUG_RECENT_DIRECTORIES";
     const char CACHE_IMAGES_AUTOMATICALLY[] = "DEBUG_CACHE_IMAGES_AUTOMATICALLY";
     const char USER_DICT_FILENAME[] = "userdict_debug.dic";
+    const char USER_DICT_COMPILED_FILENAME[] = "userdict_debug.v1.compiled";
+    const char USER_DICT_JOURNAL_FILENAME[] = "userdict_debug.v1.journal";
 #endif
 #endif // QT_NO_DEBUG
 }
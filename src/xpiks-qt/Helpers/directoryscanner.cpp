@@ -0,0 +1,232 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "directoryscanner.h"
+#include <QSet>
+#include <algorithm>
+#include <QFile>
+#include <QThread>
+#include <QFuture>
+#include <QtConcurrent>
+#include "filenameshelpers.h"
+#include "../Common/defines.h"
+
+#ifdef Q_OS_UNIX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#else
+#include <QDirIterator>
+#endif
+
+#define MAX_SCANNING_THREADS 4
+#define FOUND_FILES_CHUNK_SIZE 500
+
+namespace Helpers {
+    static bool isSupportedArtworkSuffix(const QString &suffix) {
+        static QSet<QString> supportedSuffixes = QSet<QString>() << "jpg" << "jpeg" << "tiff" << "eps" << "ai";
+        return supportedSuffixes.contains(suffix);
+    }
+
+    DirectoryScanner::DirectoryScanner(const QStringList &directories, const QStringList &initialFiles, int maxThreadsCount):
+        QObject(),
+        m_ActiveScansCount(0),
+        m_ThreadsCount(1),
+        m_Cancel(false)
+    {
+        foreach (const QString &directory, directories) {
+            m_DirectoriesQueue.enqueue(directory);
+        }
+
+        m_FoundFiles = initialFiles;
+
+        if (maxThreadsCount <= 0) {
+            maxThreadsCount = QThread::idealThreadCount();
+        }
+
+        // scanning is disk-bound so more threads do not help
+        m_ThreadsCount = qBound(1, maxThreadsCount, MAX_SCANNING_THREADS);
+    }
+
+    void DirectoryScanner::process() {
+        LOG_INFO << m_DirectoriesQueue.size() << "directories," << m_ThreadsCount << "thread(s)";
+        const int initialCount = m_FoundFiles.size();
+
+        QList<QFuture<void> > futures;
+        for (int i = 1; i < m_ThreadsCount; ++i) {
+            futures.append(QtConcurrent::run(this, &DirectoryScanner::scanDirectories));
+        }
+
+        scanDirectories();
+
+        for (auto &future: futures) {
+            future.waitForFinished();
+        }
+
+        if (!m_Cancel) {
+            // threads append in arbitrary order
+            std::sort(m_FoundFiles.begin() + initialCount, m_FoundFiles.end());
+
+            LOG_INFO << (m_FoundFiles.size() - initialCount) << "file(s) found";
+            emit scanFinished(m_FoundFiles);
+        } else {
+            LOG_INFO << "Scanning cancelled";
+        }
+
+        emit stopped();
+    }
+
+    void DirectoryScanner::cancel() {
+        LOG_DEBUG << "#";
+        m_Cancel = true;
+
+        QMutexLocker locker(&m_Mutex);
+        m_WaitDirectory.wakeAll();
+    }
+
+    void DirectoryScanner::scanDirectories() {
+        QStringList subdirectories, files;
+
+        for (;;) {
+            QString directory;
+
+            m_Mutex.lock();
+            {
+                while (m_DirectoriesQueue.isEmpty() && (m_ActiveScansCount > 0) && !m_Cancel) {
+                    m_WaitDirectory.wait(&m_Mutex);
+                }
+
+                if (m_Cancel || m_DirectoriesQueue.isEmpty()) {
+                    m_WaitDirectory.wakeAll();
+                    m_Mutex.unlock();
+                    break;
+                }
+
+                directory = m_DirectoriesQueue.dequeue();
+                m_ActiveScansCount++;
+            }
+            m_Mutex.unlock();
+
+            scanOneDirectory(directory, subdirectories, files);
+
+            m_Mutex.lock();
+            {
+                m_ActiveScansCount--;
+
+                if (!subdirectories.isEmpty()) {
+                    foreach (const QString &subdirectory, subdirectories) {
+                        m_DirectoriesQueue.enqueue(subdirectory);
+                    }
+
+                    subdirectories.clear();
+                }
+
+                m_WaitDirectory.wakeAll();
+            }
+            m_Mutex.unlock();
+
+            if (files.size() >= FOUND_FILES_CHUNK_SIZE) {
+                addFoundFiles(files);
+            }
+        }
+
+        addFoundFiles(files);
+    }
+
+#ifdef Q_OS_UNIX
+    void DirectoryScanner::scanOneDirectory(const QString &directory, QStringList &subdirectories, QStringList &files) {
+        DIR *dir = opendir(QFile::encodeName(directory).constData());
+        if (dir == NULL) {
+            LOG_WARNING << "Failed to open directory" << directory;
+            return;
+        }
+
+        const QString prefix = directory.endsWith(QChar('/')) ? directory : (directory + QChar('/'));
+
+        struct dirent *entry = NULL;
+        while (!m_Cancel && ((entry = readdir(dir)) != NULL)) {
+            const char *name = entry->d_name;
+            // skips ".", ".." and hidden entries same as QDir does by default
+            if (name[0] == '.') { continue; }
+
+            bool isFile = false, isDirectory = false;
+            const QString filename = QFile::decodeName(name);
+
+#ifdef _DIRENT_HAVE_D_TYPE
+            const unsigned char type = entry->d_type;
+#else
+            const unsigned char type = DT_UNKNOWN;
+#endif
+            if (type == DT_REG) {
+                isFile = true;
+            } else if (type == DT_DIR) {
+                isDirectory = true;
+            } else if ((type == DT_LNK) || (type == DT_UNKNOWN)) {
+                // only suffix match is worth a stat() call for links and exotic filesystems
+                const QByteArray fullpath = QFile::encodeName(prefix + filename);
+                struct stat st;
+
+                if (lstat(fullpath.constData(), &st) == 0) {
+                    if (S_ISDIR(st.st_mode)) {
+                        isDirectory = true;
+                    } else if (S_ISREG(st.st_mode)) {
+                        isFile = true;
+                    } else if (S_ISLNK(st.st_mode) && (stat(fullpath.constData(), &st) == 0)) {
+                        // links to directories are not followed to avoid cycles
+                        isFile = S_ISREG(st.st_mode);
+                    }
+                }
+            }
+
+            if (isDirectory) {
+                subdirectories.append(prefix + filename);
+            } else if (isFile && isSupportedArtworkSuffix(getFileSuffix(filename))) {
+                files.append(prefix + filename);
+            }
+        }
+
+        closedir(dir);
+    }
+#else
+    void DirectoryScanner::scanOneDirectory(const QString &directory, QStringList &subdirectories, QStringList &files) {
+        // directory listing on Windows returns attributes together with names
+        QDirIterator it(directory, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks);
+
+        while (!m_Cancel && it.hasNext()) {
+            const QString filepath = it.next();
+
+            if (it.fileInfo().isDir()) {
+                subdirectories.append(filepath);
+            } else if (isSupportedArtworkSuffix(getFileSuffix(filepath))) {
+                files.append(filepath);
+            }
+        }
+    }
+#endif
+
+    void DirectoryScanner::addFoundFiles(QStringList &files) {
+        if (files.isEmpty()) { return; }
+
+        QMutexLocker locker(&m_Mutex);
+        m_FoundFiles.append(files);
+        files.clear();
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DIRECTORYSCANNER_H
+#define DIRECTORYSCANNER_H
+
+#include <QObject>
+#include <QStringList>
+#include <QQueue>
+#include <QMutex>
+#include <QWaitCondition>
+
+namespace Helpers {
+    // walks directories recursively on several threads and
+    // collects files with supported extensions without stat() calls
+    class DirectoryScanner : public QObject
+    {
+        Q_OBJECT
+    public:
+        DirectoryScanner(const QStringList &directories, const QStringList &initialFiles, int maxThreadsCount);
+        virtual ~DirectoryScanner() {}
+
+    public:
+        const QStringList &getFoundFiles() const { return m_FoundFiles; }
+
+    signals:
+        void scanFinished(const QStringList &files);
+        void stopped();
+
+    public slots:
+        void process();
+        void cancel();
+
+    private:
+        void scanDirectories();
+        void scanOneDirectory(const QString &directory, QStringList &subdirectories, QStringList &files);
+        void addFoundFiles(QStringList &files);
+
+    private:
+        QMutex m_Mutex;
+        QWaitCondition m_WaitDirectory;
+        QQueue<QString> m_DirectoriesQueue;
+        QStringList m_FoundFiles;
+        int m_ActiveScansCount;
+        int m_ThreadsCount;
+        volatile bool m_Cancel;
+    };
+}
+
+#endif // DIRECTORYSCANNER_H
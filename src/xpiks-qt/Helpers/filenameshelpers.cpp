@@ -69,3 +69,16 @@ QString Helpers::getImagePath(const QString &path) {
 
     return result;
 }
+
+QString Helpers::getFileSuffix(const QString &filepath) {
+    QString result;
+
+    const int dotIndex = filepath.lastIndexOf(QChar('.'));
+    const int separatorIndex = qMax(filepath.lastIndexOf(QChar('/')), filepath.lastIndexOf(QChar('\\')));
+
+    if ((dotIndex != -1) && (dotIndex > separatorIndex)) {
+        result = filepath.mid(dotIndex + 1).toLower();
+    }
+
+    return result;
+}
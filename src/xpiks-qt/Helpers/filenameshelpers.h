@@ -29,6 +29,8 @@ namespace Helpers {
     QStringList convertToVectorFilenames(const QString &path);
     QString getImagePath(const QString &path);
     QString getArchivePath(const QString &artworkPath);
+    // lowercase extension without the dot, same as QFileInfo::suffix() but without filesystem access
+    QString getFileSuffix(const QString &filepath);
 }
 
 #endif // FILENAMESHELPERS
@@ -0,0 +1,208 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fileswatcher.h"
+#include <QDir>
+#include "../Common/defines.h"
+
+#define CHANGES_DELAY_MS 500
+#define POLLING_INTERVAL_MS 10000
+
+namespace Helpers {
+    static void splitFilepath(const QString &filepath, QString &directory, QString &filename) {
+        int separatorIndex = filepath.lastIndexOf(QChar('/'));
+
+        if (separatorIndex == -1) {
+            directory = QDir::currentPath();
+            filename = filepath;
+        } else {
+            directory = (separatorIndex == 0) ? QString("/") : filepath.left(separatorIndex);
+            filename = filepath.mid(separatorIndex + 1);
+        }
+    }
+
+    static QString joinFilepath(const QString &directory, const QString &filename) {
+        if (directory.endsWith(QChar('/'))) {
+            return directory + filename;
+        } else {
+            return directory + QChar('/') + filename;
+        }
+    }
+
+    FilesWatcher::FilesWatcher(QObject *parent):
+        QObject(parent)
+    {
+        QObject::connect(&m_DirectoriesWatcher, SIGNAL(directoryChanged(QString)),
+                         this, SLOT(directoryChangedHandler(QString)));
+
+        // several events from one operation are handled together
+        m_ChangesTimer.setSingleShot(true);
+        m_ChangesTimer.setInterval(CHANGES_DELAY_MS);
+        QObject::connect(&m_ChangesTimer, SIGNAL(timeout()), this, SLOT(changesTimerTriggered()));
+
+        m_PollingTimer.setInterval(POLLING_INTERVAL_MS);
+        QObject::connect(&m_PollingTimer, SIGNAL(timeout()), this, SLOT(pollingTimerTriggered()));
+    }
+
+    void FilesWatcher::watchFiles(const QStringList &filepaths) {
+        QStringList newDirectories;
+        QString directory, filename;
+
+        foreach (const QString &filepath, filepaths) {
+            splitFilepath(filepath, directory, filename);
+
+            auto it = m_WatchedFiles.find(directory);
+            if (it == m_WatchedFiles.end()) {
+                it = m_WatchedFiles.insert(directory, QSet<QString>());
+                newDirectories.append(directory);
+            }
+
+            it.value().insert(filename);
+        }
+
+        if (newDirectories.isEmpty()) { return; }
+
+        LOG_DEBUG << "Watching" << newDirectories.size() << "new directory(ies)";
+        QStringList failedDirectories = m_DirectoriesWatcher.addPaths(newDirectories);
+
+        if (!failedDirectories.isEmpty()) {
+            // out of watch descriptors or unsupported filesystem
+            LOG_WARNING << "Falling back to polling for" << failedDirectories.size() << "directory(ies)";
+            foreach (const QString &failedDirectory, failedDirectories) {
+                m_PolledDirectories.insert(failedDirectory);
+            }
+
+            if (!m_PollingTimer.isActive()) {
+                m_PollingTimer.start();
+            }
+        }
+    }
+
+    void FilesWatcher::unwatchFiles(const QStringList &filepaths) {
+        QString directory, filename;
+
+        foreach (const QString &filepath, filepaths) {
+            splitFilepath(filepath, directory, filename);
+
+            auto it = m_WatchedFiles.find(directory);
+            if (it == m_WatchedFiles.end()) { continue; }
+
+            it.value().remove(filename);
+
+            if (it.value().isEmpty()) {
+                unwatchDirectory(directory);
+            }
+        }
+    }
+
+    void FilesWatcher::unwatchAll() {
+        LOG_DEBUG << "#";
+
+        QStringList directories = m_DirectoriesWatcher.directories();
+        if (!directories.isEmpty()) {
+            m_DirectoriesWatcher.removePaths(directories);
+        }
+
+        m_WatchedFiles.clear();
+        m_PolledDirectories.clear();
+        m_ChangedDirectories.clear();
+        m_ChangesTimer.stop();
+        m_PollingTimer.stop();
+    }
+
+    void FilesWatcher::directoryChangedHandler(const QString &directory) {
+        m_ChangedDirectories.insert(directory);
+
+        if (!m_ChangesTimer.isActive()) {
+            m_ChangesTimer.start();
+        }
+    }
+
+    void FilesWatcher::changesTimerTriggered() {
+        checkChangedDirectories();
+    }
+
+    void FilesWatcher::pollingTimerTriggered() {
+        if (m_PolledDirectories.isEmpty()) {
+            m_PollingTimer.stop();
+            return;
+        }
+
+        m_ChangedDirectories.unite(m_PolledDirectories);
+        checkChangedDirectories();
+    }
+
+    void FilesWatcher::checkChangedDirectories() {
+        QSet<QString> directories;
+        directories.swap(m_ChangedDirectories);
+
+        QStringList unavailableFiles;
+
+        foreach (const QString &directory, directories) {
+            checkDirectory(directory, unavailableFiles);
+        }
+
+        if (!unavailableFiles.isEmpty()) {
+            LOG_INFO << unavailableFiles.size() << "file(s) became unavailable";
+            emit filesUnavailable(unavailableFiles);
+        }
+    }
+
+    void FilesWatcher::checkDirectory(const QString &directory, QStringList &unavailableFiles) {
+        auto it = m_WatchedFiles.find(directory);
+        if (it == m_WatchedFiles.end()) { return; }
+
+        // one listing of the directory instead of a stat() for every watched file
+        QDir dir(directory);
+        QSet<QString> existingFiles;
+        if (dir.exists()) {
+            QStringList entries = dir.entryList(QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot, QDir::Unsorted);
+            existingFiles = QSet<QString>::fromList(entries);
+        }
+
+        QSet<QString> &watchedFiles = it.value();
+        auto fileIt = watchedFiles.begin();
+
+        while (fileIt != watchedFiles.end()) {
+            if (!existingFiles.contains(*fileIt)) {
+                unavailableFiles.append(joinFilepath(directory, *fileIt));
+                // file is reported only once, same as QFileSystemWatcher does for deleted files
+                fileIt = watchedFiles.erase(fileIt);
+            } else {
+                ++fileIt;
+            }
+        }
+
+        if (watchedFiles.isEmpty()) {
+            unwatchDirectory(directory);
+        }
+    }
+
+    void FilesWatcher::unwatchDirectory(const QString &directory) {
+        m_WatchedFiles.remove(directory);
+
+        if (m_PolledDirectories.contains(directory)) {
+            m_PolledDirectories.remove(directory);
+        } else {
+            m_DirectoriesWatcher.removePath(directory);
+        }
+    }
+}
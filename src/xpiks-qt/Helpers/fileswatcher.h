@@ -0,0 +1,73 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FILESWATCHER_H
+#define FILESWATCHER_H
+
+#include <QObject>
+#include <QFileSystemWatcher>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+#include <QTimer>
+
+namespace Helpers {
+    // watches parent directories instead of every file so that
+    // a large session needs one system watch per directory only
+    class FilesWatcher : public QObject
+    {
+        Q_OBJECT
+    public:
+        explicit FilesWatcher(QObject *parent = 0);
+
+    public:
+        void watchFiles(const QStringList &filepaths);
+        void unwatchFiles(const QStringList &filepaths);
+        void unwatchAll();
+        int getWatchedDirectoriesCount() const { return m_WatchedFiles.size(); }
+        int getPolledDirectoriesCount() const { return m_PolledDirectories.size(); }
+
+    signals:
+        void filesUnavailable(const QStringList &filepaths);
+
+    private slots:
+        void directoryChangedHandler(const QString &directory);
+        void changesTimerTriggered();
+        void pollingTimerTriggered();
+
+    private:
+        void checkChangedDirectories();
+        void checkDirectory(const QString &directory, QStringList &unavailableFiles);
+        void unwatchDirectory(const QString &directory);
+
+    private:
+        QFileSystemWatcher m_DirectoriesWatcher;
+        // directory -> names of watched files in it
+        QHash<QString, QSet<QString> > m_WatchedFiles;
+        // directories that system watcher refused to watch
+        QSet<QString> m_PolledDirectories;
+        QSet<QString> m_ChangedDirectories;
+        QTimer m_ChangesTimer;
+        QTimer m_PollingTimer;
+    };
+}
+
+#endif // FILESWATCHER_H
@@ -21,6 +21,7 @@
 
 #include "filterhelpers.h"
 #include <QString>
+#include <QStringList>
 #include "../Models/artworkmetadata.h"
 #include "../Models/imageartwork.h"
 #include "../Common/basickeywordsmodel.h"
@@ -28,194 +29,183 @@
 #include "../Common/defines.h"
 
 namespace Helpers {
-    bool fitsSpecialKeywords(const QString &searchTerm, Models::ArtworkMetadata *metadata) {
-        bool hasMatch = false;
-
-        const Models::ImageArtwork *image = dynamic_cast<const Models::ImageArtwork*>(metadata);
-        if (image == NULL) { return hasMatch; }
-
-        if (searchTerm == QLatin1String("x:modified")) {
-            hasMatch = metadata->isModified();
-        } else if (searchTerm == QLatin1String("x:empty")) {
-            hasMatch = metadata->isEmpty();
-        } else if (searchTerm == QLatin1String("x:selected")) {
-            hasMatch = metadata->isSelected();
-        } else if (searchTerm == QLatin1String("x:vector")) {
-            hasMatch = image != NULL && image->hasVectorAttached();
-        } else if (searchTerm == QLatin1String("x:image")) {
-            hasMatch = image != NULL && !image->hasVectorAttached();
+    SearchQuery::QueryTerm::QueryTerm(const QString &term, Qt::CaseSensitivity caseSensitivity):
+        m_Matcher(term, caseSensitivity),
+        m_KeywordTerm(term),
+        m_SpecialTerm(SearchQuery::parseSpecialTerm(term)),
+        m_WholeKeyword(false)
+    {
+        if ((m_KeywordTerm.length() > 1) && m_KeywordTerm[0] == QLatin1Char('!')) {
+            m_WholeKeyword = true;
+            m_KeywordTerm.remove(0, 1);
         }
 
-        return hasMatch;
+        m_KeywordMatcher.setCaseSensitivity(caseSensitivity);
+        m_KeywordMatcher.setPattern(m_KeywordTerm);
     }
 
-    bool containsAnyPartsSearch(const QString &mainSearchTerm, Models::ArtworkMetadata *metadata, Common::SearchFlags searchFlags) {
-        bool hasMatch = false;
-        QStringList searchTerms;
-
-        if (!Common::HasFlag(searchFlags, Common::SearchFlags::IncludeSpaces)) {
-            searchTerms = mainSearchTerm.split(QChar::Space, QString::SkipEmptyParts);
-        } else {
-            searchTerms << mainSearchTerm;
-        }
+    SearchQuery::SearchQuery():
+        m_SearchFlags(Common::SearchFlags::None),
+        m_CaseSensitivity(Qt::CaseInsensitive),
+        m_WholeKeywordFlags(Common::SearchFlags::None),
+        m_SearchUsingAnd(false),
+        m_CheckDescription(false),
+        m_CheckTitle(false),
+        m_CheckFilepath(false),
+        m_CheckKeywords(false),
+        m_CheckSpecial(false)
+    {
+    }
 
-        const QString description = metadata->getDescription();
-        const QString title = metadata->getTitle();
-        const QString &filepath = metadata->getFilepath();
+    SearchQuery::SearchQuery(const QString &searchTerm, Common::SearchFlags searchFlags):
+        m_SearchTerm(searchTerm),
+        m_SearchFlags(searchFlags)
+    {
+        m_SearchUsingAnd = Common::HasFlag(searchFlags, Common::SearchFlags::AllTerms);
+        m_CheckDescription = Common::HasFlag(searchFlags, Common::SearchFlags::Description);
+        m_CheckTitle = Common::HasFlag(searchFlags, Common::SearchFlags::Title);
+        m_CheckFilepath = Common::HasFlag(searchFlags, Common::SearchFlags::Filepath);
+        m_CheckKeywords = Common::HasFlag(searchFlags, Common::SearchFlags::Keywords);
+        m_CheckSpecial = Common::HasFlag(searchFlags, Common::SearchFlags::ReservedTerms);
 
-        const bool needToCheckDescription = Common::HasFlag(searchFlags, Common::SearchFlags::Description);
-        const bool needToCheckTitle = Common::HasFlag(searchFlags, Common::SearchFlags::Title);
-        const bool needToCheckSpecial = Common::HasFlag(searchFlags, Common::SearchFlags::ReservedTerms);
-        const bool needToCheckFilepath = Common::HasFlag(searchFlags, Common::SearchFlags::Filepath);
         const bool caseSensitive = Common::HasFlag(searchFlags, Common::SearchFlags::CaseSensitive);
-        Qt::CaseSensitivity caseSensitivity = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
-
-        int length = searchTerms.length();
-
-        Common::BasicKeywordsModel *keywordsModel = metadata->getBasicModel();
+        m_CaseSensitivity = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
 
-        for (int i = 0; i < length; ++i) {
-            const QString &searchTerm = searchTerms.at(i);
-
-            if (needToCheckSpecial) {
-                hasMatch = fitsSpecialKeywords(searchTerm, metadata);
-            }
-
-            if (!hasMatch && needToCheckDescription) {
-                hasMatch = description.contains(searchTerm, caseSensitivity);
-            }
+        m_WholeKeywordFlags = Common::SearchFlags::Keywords;
+        Common::SetFlag(m_WholeKeywordFlags, Common::SearchFlags::WholeWords);
+        if (caseSensitive) {
+            Common::SetFlag(m_WholeKeywordFlags, Common::SearchFlags::CaseSensitive);
+        }
 
-            if (!hasMatch && needToCheckTitle) {
-                hasMatch = title.contains(searchTerm, caseSensitivity);
-            }
+        QStringList searchTerms;
 
-            if (!hasMatch && needToCheckFilepath) {
-                hasMatch = filepath.contains(searchTerm, caseSensitivity);
-            }
+        if (!Common::HasFlag(searchFlags, Common::SearchFlags::IncludeSpaces)) {
+            searchTerms = searchTerm.split(QChar::Space, QString::SkipEmptyParts);
+        } else {
+            searchTerms << searchTerm;
+        }
 
-            if (hasMatch) { break; }
+        m_Terms.reserve(searchTerms.size());
+        for (auto &term: searchTerms) {
+            m_Terms.emplace_back(term, m_CaseSensitivity);
         }
+    }
 
+    bool SearchQuery::matches(Models::ArtworkMetadata *metadata) const {
+        if (m_Terms.empty()) {
+            // nothing failed for AND and nothing matched for OR
+            return m_SearchUsingAnd;
+        }
 
-        const bool needToCheckKeywords = Common::HasFlag(searchFlags, Common::SearchFlags::Keywords);
+        const QString description = m_CheckDescription ? metadata->getDescription() : QString();
+        const QString title = m_CheckTitle ? metadata->getTitle() : QString();
 
-        if (!hasMatch && needToCheckKeywords) {
-            for (int i = 0; i < length; ++i) {
-                QString searchTerm = searchTerms[i];
-                Common::SearchFlags keywordsFlags = Common::SearchFlags::Keywords;
+        bool hasMatch = m_SearchUsingAnd;
 
-                if ((searchTerm.length() > 1) && searchTerm[0] == QLatin1Char('!')) {
-                    Common::SetFlag(keywordsFlags, Common::SearchFlags::WholeWords);
-                    searchTerm.remove(0, 1);
-                }
+        for (auto &term: m_Terms) {
+            const bool termMatch = termMatches(term, metadata, description, title);
 
-                if (caseSensitive) {
-                    Common::SetFlag(keywordsFlags, Common::SearchFlags::CaseSensitive);
-                }
+            if (m_SearchUsingAnd && !termMatch) {
+                hasMatch = false;
+                break;
+            }
 
-                hasMatch = keywordsModel->containsKeyword(searchTerm, keywordsFlags);
-                if (hasMatch) { break; }
+            if (!m_SearchUsingAnd && termMatch) {
+                hasMatch = true;
+                break;
             }
         }
 
         return hasMatch;
     }
 
-    bool containsAllPartsSearch(const QString &mainSearchTerm, Models::ArtworkMetadata *metadata, Common::SearchFlags searchFlags) {
-        bool hasMatch = false;
-        QStringList searchTerms;
-
-        if (!Common::HasFlag(searchFlags, Common::SearchFlags::IncludeSpaces)) {
-            searchTerms = mainSearchTerm.split(QChar::Space, QString::SkipEmptyParts);
-        } else {
-            searchTerms << mainSearchTerm;
+    bool SearchQuery::termMatches(const QueryTerm &term, Models::ArtworkMetadata *metadata,
+                                  const QString &description, const QString &title) const {
+        if (m_CheckSpecial && (term.m_SpecialTerm != SpecialTerm::None)) {
+            if (fitsSpecialTerm(term.m_SpecialTerm, metadata)) { return true; }
         }
 
-        const QString description = metadata->getDescription();
-        const QString title = metadata->getTitle();
-        const QString &filepath = metadata->getFilepath();
-
-        const bool needToCheckDescription = Common::HasFlag(searchFlags, Common::SearchFlags::Description);
-        const bool needToCheckTitle = Common::HasFlag(searchFlags, Common::SearchFlags::Title);
-        const bool needToCheckSpecial = Common::HasFlag(searchFlags, Common::SearchFlags::ReservedTerms);
-        const bool needToCheckFilepath = Common::HasFlag(searchFlags, Common::SearchFlags::Filepath);
-        const bool caseSensitive = Common::HasFlag(searchFlags, Common::SearchFlags::CaseSensitive);
-        Qt::CaseSensitivity caseSensitivity = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
-
-        bool anyError = false;
-        int length = searchTerms.length();
-
-        Common::BasicKeywordsModel *keywordsModel = metadata->getBasicModel();
-
-        for (int i = 0; i < length; ++i) {
-            QString searchTerm = searchTerms[i];
-            bool anyContains = false;
-
-            if (needToCheckSpecial) {
-                anyContains = fitsSpecialKeywords(searchTerm, metadata);
-            }
+        if (m_CheckDescription && (term.m_Matcher.indexIn(description) != -1)) { return true; }
+        if (m_CheckTitle && (term.m_Matcher.indexIn(title) != -1)) { return true; }
+        if (m_CheckFilepath && (term.m_Matcher.indexIn(metadata->getFilepath()) != -1)) { return true; }
 
-            if (!anyContains && needToCheckDescription) {
-                anyContains = description.contains(searchTerm, caseSensitivity);
-            }
+        if (m_CheckKeywords) {
+            Common::BasicKeywordsModel *keywordsModel = metadata->getBasicModel();
 
-            if (!anyContains && needToCheckTitle) {
-                anyContains = title.contains(searchTerm, caseSensitivity);
-            }
-
-            if (!anyContains && needToCheckFilepath) {
-                anyContains = filepath.contains(searchTerm, caseSensitivity);
+            if (term.m_WholeKeyword) {
+                return keywordsModel->containsKeyword(term.m_KeywordTerm, m_WholeKeywordFlags);
+            } else {
+                return keywordsModel->containsKeyword(term.m_KeywordMatcher);
             }
+        }
 
-            const bool needToCheckKeywords = Common::HasFlag(searchFlags, Common::SearchFlags::Keywords);
+        return false;
+    }
 
-            if (!anyContains && needToCheckKeywords) {
-                Common::SearchFlags keywordsFlags = Common::SearchFlags::Keywords;
+    SearchQuery::SpecialTerm SearchQuery::parseSpecialTerm(const QString &term) {
+        SpecialTerm specialTerm = SpecialTerm::None;
+
+        if (term == QLatin1String("x:modified")) {
+            specialTerm = SpecialTerm::Modified;
+        } else if (term == QLatin1String("x:empty")) {
+            specialTerm = SpecialTerm::Empty;
+        } else if (term == QLatin1String("x:selected")) {
+            specialTerm = SpecialTerm::Selected;
+        } else if (term == QLatin1String("x:vector")) {
+            specialTerm = SpecialTerm::Vector;
+        } else if (term == QLatin1String("x:image")) {
+            specialTerm = SpecialTerm::Image;
+        }
 
-                if ((searchTerm.length() > 1) && searchTerm[0] == QLatin1Char('!')) {
-                    Common::SetFlag(keywordsFlags, Common::SearchFlags::WholeWords);
-                    searchTerm.remove(0, 1);
-                }
+        return specialTerm;
+    }
 
-                if (caseSensitive) {
-                    Common::SetFlag(keywordsFlags, Common::SearchFlags::CaseSensitive);
-                }
+    bool SearchQuery::fitsSpecialTerm(SpecialTerm specialTerm, Models::ArtworkMetadata *metadata) {
+        bool hasMatch = false;
 
-                anyContains = keywordsModel->containsKeyword(searchTerm, keywordsFlags);
-            }
+        const Models::ImageArtwork *image = dynamic_cast<const Models::ImageArtwork*>(metadata);
+        if (image == NULL) { return hasMatch; }
 
-            if (!anyContains) {
-                anyError = true;
-                break;
-            }
+        switch (specialTerm) {
+        case SpecialTerm::Modified:
+            hasMatch = metadata->isModified();
+            break;
+        case SpecialTerm::Empty:
+            hasMatch = metadata->isEmpty();
+            break;
+        case SpecialTerm::Selected:
+            hasMatch = metadata->isSelected();
+            break;
+        case SpecialTerm::Vector:
+            hasMatch = image->hasVectorAttached();
+            break;
+        case SpecialTerm::Image:
+            hasMatch = !image->hasVectorAttached();
+            break;
+        default:
+            break;
         }
 
-        hasMatch = !anyError;
         return hasMatch;
     }
 
-    bool containsPartsSearch(const QString &mainSearchTerm, Models::ArtworkMetadata *metadata, bool searchUsingAnd) {
+    Common::SearchFlags getSearchFlags(bool searchUsingAnd) {
         // default search is not case sensitive
-        Common::SearchFlags searchFlags = searchUsingAnd ? Common::SearchFlags::AllTermsEverything :
-                                           Common::SearchFlags::AnyTermsEverything;
-        bool hasMatch = hasSearchMatch(mainSearchTerm, metadata, searchFlags);
+        return searchUsingAnd ? Common::SearchFlags::AllTermsEverything :
+                                Common::SearchFlags::AnyTermsEverything;
+    }
+
+    bool containsPartsSearch(const QString &mainSearchTerm, Models::ArtworkMetadata *metadata, bool searchUsingAnd) {
+        bool hasMatch = hasSearchMatch(mainSearchTerm, metadata, getSearchFlags(searchUsingAnd));
         return hasMatch;
     }
 
     bool hasSearchMatch(const QString &searchTerm, Models::ArtworkMetadata *metadata, Common::SearchFlags searchFlags) {
-        bool hasMatch = false;
-
-        const bool searchUsingAnd = Common::HasFlag(searchFlags, Common::SearchFlags::AllTerms);
-        LOG_CORE_TESTS << "Search using AND:" << searchUsingAnd;
+        LOG_CORE_TESTS << "Search using AND:" << Common::HasFlag(searchFlags, Common::SearchFlags::AllTerms);
         LOG_CORE_TESTS << "Case sensitive:" << Common::HasFlag(searchFlags, Common::SearchFlags::CaseSensitive);
 
-        if (searchUsingAnd) {
-            hasMatch = containsAllPartsSearch(searchTerm, metadata, searchFlags);
-        } else {
-            hasMatch = containsAnyPartsSearch(searchTerm, metadata, searchFlags);
-        }
-
+        SearchQuery query(searchTerm, searchFlags);
+        bool hasMatch = query.matches(metadata);
         return hasMatch;
     }
-
 }
@@ -23,6 +23,8 @@
 #define FILTERHELPERS_H
 
 #include <QString>
+#include <QStringMatcher>
+#include <vector>
 #include "../Common/flags.h"
 
 namespace Models {
@@ -30,6 +32,61 @@ namespace Models {
 }
 
 namespace Helpers {
+    // search term parsed once and matched against many artworks
+    class SearchQuery {
+    public:
+        SearchQuery();
+        SearchQuery(const QString &searchTerm, Common::SearchFlags searchFlags);
+
+    private:
+        enum class SpecialTerm {
+            None,
+            Modified,
+            Empty,
+            Selected,
+            Vector,
+            Image
+        };
+
+        struct QueryTerm {
+            QueryTerm(const QString &term, Qt::CaseSensitivity caseSensitivity);
+
+            // raw term is matched against title, description and filepath
+            QStringMatcher m_Matcher;
+            // keywords are matched without "!" prefix
+            QString m_KeywordTerm;
+            QStringMatcher m_KeywordMatcher;
+            SpecialTerm m_SpecialTerm;
+            bool m_WholeKeyword;
+        };
+
+    public:
+        const QString &getSearchTerm() const { return m_SearchTerm; }
+        Common::SearchFlags getSearchFlags() const { return m_SearchFlags; }
+        bool isEmpty() const { return m_Terms.empty(); }
+        bool matches(Models::ArtworkMetadata *metadata) const;
+
+    private:
+        bool termMatches(const QueryTerm &term, Models::ArtworkMetadata *metadata,
+                         const QString &description, const QString &title) const;
+        static SpecialTerm parseSpecialTerm(const QString &term);
+        static bool fitsSpecialTerm(SpecialTerm specialTerm, Models::ArtworkMetadata *metadata);
+
+    private:
+        QString m_SearchTerm;
+        std::vector<QueryTerm> m_Terms;
+        Common::SearchFlags m_SearchFlags;
+        Qt::CaseSensitivity m_CaseSensitivity;
+        Common::SearchFlags m_WholeKeywordFlags;
+        bool m_SearchUsingAnd;
+        bool m_CheckDescription;
+        bool m_CheckTitle;
+        bool m_CheckFilepath;
+        bool m_CheckKeywords;
+        bool m_CheckSpecial;
+    };
+
+    Common::SearchFlags getSearchFlags(bool searchUsingAnd);
     bool containsPartsSearch(const QString &mainSearchTerm, Models::ArtworkMetadata *metadata, bool searchUsingAnd);
     bool hasSearchMatch(const QString &searchTerm, Models::ArtworkMetadata *metadata, Common::SearchFlags searchFlags);
 }
@@ -134,4 +134,16 @@ namespace Helpers {
 
         return results;
     }
+
+    RangesVector unionAdjacentRanges(RangesVector &ranges) {
+        // half-open ranges [a, b + 1) overlap when inclusive ones are adjacent
+        for (auto &range: ranges) { range.second++; }
+
+        RangesVector results = unionRanges(ranges);
+
+        for (auto &range: ranges) { range.second--; }
+        for (auto &range: results) { range.second--; }
+
+        return results;
+    }
 }
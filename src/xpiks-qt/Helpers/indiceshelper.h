@@ -36,6 +36,8 @@ namespace Helpers {
     void indicesToRanges(const QVector<int> &indices, QVector<QPair<int, int> > &ranges);
     int getRangesLength(const QVector<QPair<int, int> > &ranges);
     RangesVector unionRanges(RangesVector &ranges);
+    // also merges ranges that only touch each other like [0, 2] and [3, 5]
+    RangesVector unionAdjacentRanges(RangesVector &ranges);
 }
 
 #endif // INDICESHELPER_H
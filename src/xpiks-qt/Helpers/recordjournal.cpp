@@ -0,0 +1,221 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "recordjournal.h"
+#include <QDataStream>
+#include <QSaveFile>
+#include "../Common/defines.h"
+#include "filehelpers.h"
+
+namespace Helpers {
+    RecordJournal::RecordJournal(quint32 magic, quint32 version, quint32 maxRecordSize, bool syncOnAppend):
+        m_Magic(magic),
+        m_Version(version),
+        m_MaxRecordSize(maxRecordSize),
+        m_RecordsCount(0),
+        m_SyncOnAppend(syncOnAppend)
+    {
+    }
+
+    RecordJournal::~RecordJournal() {
+        close();
+    }
+
+    QByteArray RecordJournal::serializeRecord(const QByteArray &payload) {
+        QByteArray record;
+        QDataStream out(&record, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_5_0);
+        out << (quint32)payload.size() << qChecksum(payload.constData(), payload.size());
+        out.writeRawData(payload.constData(), payload.size());
+        return record;
+    }
+
+    RecordJournal::ReadResult RecordJournal::read(const std::function<void (QDataStream &)> &recordHandler) {
+        m_RecordsCount = 0;
+
+        QFile file(m_Path);
+        if (!file.exists()) { return JournalNotFound; }
+
+        if (!file.open(QIODevice::ReadOnly)) {
+            LOG_WARNING << "Failed to read journal" << m_Path;
+            return JournalNotFound;
+        }
+
+        QDataStream in(&file);
+        in.setVersion(QDataStream::Qt_5_0);
+
+        quint32 magic = 0, version = 0;
+        in >> magic >> version;
+
+        QByteArray headerData(m_HeaderData.size(), Qt::Uninitialized);
+        if (!headerData.isEmpty()) {
+            if (in.readRawData(headerData.data(), headerData.size()) != headerData.size()) {
+                headerData.clear();
+            }
+        }
+
+        if ((in.status() != QDataStream::Ok) ||
+                (magic != m_Magic) ||
+                (version != m_Version) ||
+                (headerData != m_HeaderData)) {
+            file.close();
+            return JournalUnknown;
+        }
+
+        qint64 validEnd = file.pos();
+
+        while (!in.atEnd()) {
+            quint32 payloadSize = 0;
+            quint16 checksum = 0;
+            in >> payloadSize >> checksum;
+
+            if ((in.status() != QDataStream::Ok) ||
+                    (payloadSize > m_MaxRecordSize) ||
+                    (file.bytesAvailable() < payloadSize)) {
+                break;
+            }
+
+            QByteArray payload(payloadSize, Qt::Uninitialized);
+            if (in.readRawData(payload.data(), payloadSize) != (int)payloadSize) { break; }
+            if (qChecksum(payload.constData(), payloadSize) != checksum) { break; }
+
+            QDataStream record(payload);
+            record.setVersion(QDataStream::Qt_5_0);
+            recordHandler(record);
+
+            m_RecordsCount++;
+            validEnd = file.pos();
+        }
+
+        const qint64 fileSize = file.size();
+        file.close();
+
+        if (validEnd < fileSize) {
+            // last write was interrupted
+            LOG_WARNING << "Cutting off" << (fileSize - validEnd) << "bytes of incomplete records";
+            QFile::resize(m_Path, validEnd);
+        }
+
+        return JournalRead;
+    }
+
+    void RecordJournal::keepAside(const QString &suffix) {
+        const QString backupPath = m_Path + suffix;
+        LOG_WARNING << "Keeping unknown journal as" << backupPath;
+        QFile::remove(backupPath);
+        QFile::rename(m_Path, backupPath);
+    }
+
+    void RecordJournal::remove() {
+        LOG_DEBUG << m_Path;
+        QFile::remove(m_Path);
+    }
+
+    bool RecordJournal::openForAppend() {
+        m_File.setFileName(m_Path);
+        if (!m_File.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            return false;
+        }
+
+        if (m_File.size() == 0) {
+            m_File.write(serializeHeader());
+            m_File.flush();
+        }
+
+        return true;
+    }
+
+    bool RecordJournal::appendRecords(const QByteArray &records, int count) {
+        if (!m_File.isOpen()) { return false; }
+
+        bool success = m_File.write(records) == records.size();
+        success = (m_SyncOnAppend ? syncFile(m_File) : m_File.flush()) && success;
+
+        if (success) {
+            m_RecordsCount += count;
+        }
+
+        return success;
+    }
+
+    bool RecordJournal::replaceRecords(const QByteArray &records, int count) {
+        QSaveFile snapshot(m_Path);
+        if (!snapshot.open(QIODevice::WriteOnly)) {
+            LOG_WARNING << "Failed to create journal snapshot";
+            return false;
+        }
+
+        snapshot.write(serializeHeader());
+        snapshot.write(records);
+
+        m_File.close();
+
+        bool success = snapshot.commit();
+        if (success) {
+            m_RecordsCount = count;
+        } else {
+            LOG_WARNING << "Failed to replace journal with snapshot:" << snapshot.errorString();
+        }
+
+        if (!openForAppend()) {
+            LOG_WARNING << "Failed to reopen journal" << m_Path;
+        }
+
+        return success;
+    }
+
+    bool RecordJournal::truncate() {
+        m_File.close();
+        m_File.setFileName(m_Path);
+
+        bool success = m_File.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        if (success) {
+            m_File.close();
+            m_RecordsCount = 0;
+        } else {
+            LOG_WARNING << "Failed to truncate journal" << m_Path;
+        }
+
+        if (!openForAppend()) {
+            LOG_WARNING << "Failed to reopen journal" << m_Path;
+        }
+
+        return success;
+    }
+
+    void RecordJournal::close() {
+        if (m_File.isOpen()) {
+            m_File.close();
+        }
+    }
+
+    QByteArray RecordJournal::serializeHeader() const {
+        QByteArray header;
+        {
+            QDataStream out(&header, QIODevice::WriteOnly);
+            out.setVersion(QDataStream::Qt_5_0);
+            out << m_Magic << m_Version;
+        }
+
+        header.append(m_HeaderData);
+        return header;
+    }
+}
@@ -0,0 +1,91 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RECORDJOURNAL_H
+#define RECORDJOURNAL_H
+
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <functional>
+
+class QDataStream;
+
+namespace Helpers {
+    // append-only file with magic and version header followed by records
+    // every record is written as size, checksum and payload
+    // so a torn tail left after crash is detected and cut off on replay
+    // class is not thread-safe and owners guard it with their own locks
+    class RecordJournal
+    {
+    public:
+        enum ReadResult {
+            JournalNotFound,
+            // magic, version or header data do not match
+            JournalUnknown,
+            JournalRead
+        };
+
+    public:
+        RecordJournal(quint32 magic, quint32 version, quint32 maxRecordSize, bool syncOnAppend);
+        virtual ~RecordJournal();
+
+    public:
+        void setPath(const QString &filepath) { m_Path = filepath; }
+        const QString &getPath() const { return m_Path; }
+        // written after magic and version and compared on read
+        void setHeaderData(const QByteArray &headerData) { m_HeaderData = headerData; }
+        bool isOpen() const { return m_File.isOpen(); }
+        int getRecordsCount() const { return m_RecordsCount; }
+
+    public:
+        static QByteArray serializeRecord(const QByteArray &payload);
+
+    public:
+        // handler gets a stream over payload of every valid record
+        ReadResult read(const std::function<void (QDataStream &)> &recordHandler);
+        // renames unknown journal so it is not overwritten
+        void keepAside(const QString &suffix);
+        void remove();
+        bool openForAppend();
+        bool appendRecords(const QByteArray &records, int count);
+        // replaces journal with given records only when they are completely written
+        bool replaceRecords(const QByteArray &records, int count);
+        // empties journal when its records are saved elsewhere
+        bool truncate();
+        void close();
+
+    private:
+        QByteArray serializeHeader() const;
+
+    private:
+        QFile m_File;
+        QString m_Path;
+        QByteArray m_HeaderData;
+        quint32 m_Magic;
+        quint32 m_Version;
+        quint32 m_MaxRecordSize;
+        int m_RecordsCount;
+        bool m_SyncOnAppend;
+    };
+}
+
+#endif // RECORDJOURNAL_H
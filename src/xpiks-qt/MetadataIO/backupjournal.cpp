@@ -0,0 +1,265 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backupjournal.h"
+#include <QDataStream>
+#include <QMutexLocker>
+#include <QDir>
+#include "../Common/defines.h"
+#include "../Helpers/constants.h"
+
+#define JOURNAL_MAGIC 0x58504B4A
+#define JOURNAL_VERSION 1
+#define MAX_RECORD_SIZE (16*1024*1024)
+#define COMPACTION_MIN_RECORDS 1000
+#define UNREADABLE_JOURNAL_SUFFIX ".unreadable"
+
+namespace MetadataIO {
+    enum JournalRecordType {
+        PutRecord = 1,
+        RemoveRecord = 2
+    };
+
+    static QByteArray serializeRecord(quint8 type, const QString &filepath, const QHash<QString, QString> &dict) {
+        QByteArray payload;
+        {
+            QDataStream out(&payload, QIODevice::WriteOnly);
+            out.setVersion(QDataStream::Qt_5_0);
+            out << type << filepath;
+            if (type == PutRecord) {
+                out << dict;
+            }
+        }
+
+        return Helpers::RecordJournal::serializeRecord(payload);
+    }
+
+    BackupJournal::BackupJournal():
+        m_Journal(JOURNAL_MAGIC, JOURNAL_VERSION, MAX_RECORD_SIZE, true),
+        m_IsLoaded(false)
+    {
+    }
+
+    BackupJournal::~BackupJournal() {
+        close();
+    }
+
+    bool BackupJournal::putBackup(const QString &filepath, const QHash<QString, QString> &dict) {
+        QMutexLocker locker(&m_Mutex);
+        ensureLoaded();
+
+        auto it = m_Backups.constFind(filepath);
+        if ((it != m_Backups.constEnd()) && (it.value() == dict)) {
+            return m_Journal.isOpen();
+        }
+
+        m_Backups.insert(filepath, dict);
+        bool success = appendRecord(PutRecord, filepath, dict);
+        compactIfNeeded();
+
+        return success;
+    }
+
+    void BackupJournal::removeBackup(const QString &filepath) {
+        removeBackups(QStringList() << filepath);
+    }
+
+    void BackupJournal::removeBackups(const QStringList &filepaths) {
+        QMutexLocker locker(&m_Mutex);
+        ensureLoaded();
+
+        QByteArray records;
+        int count = 0;
+
+        for (auto &filepath: filepaths) {
+            if (m_Backups.remove(filepath) > 0) {
+                records.append(serializeRecord(RemoveRecord, filepath, QHash<QString, QString>()));
+                count++;
+            }
+        }
+
+        if (count > 0) {
+            LOG_DEBUG << "Removing" << count << "backup(s)";
+            m_Journal.appendRecords(records, count);
+            compactIfNeeded();
+        }
+    }
+
+    bool BackupJournal::tryGetBackup(const QString &filepath, QHash<QString, QString> &dict) {
+        QMutexLocker locker(&m_Mutex);
+        ensureLoaded();
+
+        auto it = m_Backups.constFind(filepath);
+        if (it == m_Backups.constEnd()) { return false; }
+
+        dict = it.value();
+        return true;
+    }
+
+    void BackupJournal::migrateLegacyBackups(const QString &directory) {
+        QMutexLocker locker(&m_Mutex);
+        ensureLoaded();
+
+        if (m_MigratedDirectories.contains(directory)) { return; }
+        m_MigratedDirectories.insert(directory);
+
+        const QString extension = QString::fromLatin1(Constants::METADATA_BACKUP_EXTENSION);
+        QDir dir(directory);
+        const QStringList legacyFiles = dir.entryList(QStringList() << ("*" + extension), QDir::Files);
+        if (legacyFiles.isEmpty()) { return; }
+
+        QByteArray records;
+        QStringList migratedPaths;
+
+        for (auto &legacyFile: legacyFiles) {
+            const QString filepath = dir.filePath(legacyFile.left(legacyFile.size() - extension.size()));
+            // journal already has newer backup
+            if (m_Backups.contains(filepath)) { continue; }
+
+            const QString legacyPath = dir.filePath(legacyFile);
+            QHash<QString, QString> dict;
+            if (!readLegacyBackup(legacyPath, dict)) { continue; }
+
+            m_Backups.insert(filepath, dict);
+            records.append(serializeRecord(PutRecord, filepath, dict));
+            migratedPaths.append(legacyPath);
+        }
+
+        if (migratedPaths.isEmpty()) { return; }
+
+        LOG_INFO << "Moving" << migratedPaths.size() << "legacy backup(s) to journal from" << directory;
+
+        // legacy files are removed only when journal has them on disk
+        if (m_Journal.appendRecords(records, migratedPaths.size())) {
+            for (auto &legacyPath: migratedPaths) {
+                QFile::remove(legacyPath);
+            }
+        }
+
+        compactIfNeeded();
+    }
+
+    bool BackupJournal::readLegacyBackup(const QString &path, QHash<QString, QString> &dict) {
+        bool success = false;
+        QFile file(path);
+        if (file.open(QIODevice::ReadOnly)) {
+            QHash<QString, QString> legacyDict;
+
+            QDataStream in(&file);   // read the data
+            in >> legacyDict;
+
+            if (in.status() == QDataStream::Ok) {
+                dict.swap(legacyDict);
+                success = true;
+            } else {
+                LOG_WARNING << "Failed to read legacy backup" << path;
+            }
+
+            file.close();
+        }
+
+        return success;
+    }
+
+    void BackupJournal::close() {
+        QMutexLocker locker(&m_Mutex);
+
+        if (m_Journal.isOpen()) {
+            compactIfNeeded();
+            m_Journal.close();
+            LOG_INFO << "Backups journal closed with" << m_Backups.size() << "entries";
+        }
+    }
+
+    void BackupJournal::ensureLoaded() {
+        if (m_IsLoaded) { return; }
+        m_IsLoaded = true;
+
+        if (m_Journal.getPath().isEmpty()) {
+            LOG_WARNING << "Journal path is empty. Backups are kept in memory";
+            return;
+        }
+
+        readJournal();
+
+        if (!m_Journal.openForAppend()) {
+            LOG_WARNING << "Failed to open backups journal" << m_Journal.getPath();
+        }
+
+        compactIfNeeded();
+    }
+
+    void BackupJournal::readJournal() {
+        Helpers::RecordJournal::ReadResult result = m_Journal.read([this](QDataStream &record) {
+            quint8 type = 0;
+            QString filepath;
+            record >> type >> filepath;
+
+            if (type == PutRecord) {
+                QHash<QString, QString> dict;
+                record >> dict;
+                m_Backups.insert(filepath, dict);
+            } else if (type == RemoveRecord) {
+                m_Backups.remove(filepath);
+            }
+        });
+
+        if (result == Helpers::RecordJournal::JournalUnknown) {
+            // newer version might still be able to read it
+            LOG_WARNING << "Unknown backups journal format";
+            m_Journal.keepAside(UNREADABLE_JOURNAL_SUFFIX);
+        } else if (result == Helpers::RecordJournal::JournalRead) {
+            LOG_INFO << "Backups journal read:" << m_Backups.size() << "entries from" << m_Journal.getRecordsCount() << "records";
+        }
+    }
+
+    bool BackupJournal::appendRecord(quint8 type, const QString &filepath, const QHash<QString, QString> &dict) {
+        bool success = m_Journal.appendRecords(serializeRecord(type, filepath, dict), 1);
+
+        if (!success) {
+            LOG_WARNING << "Failed to append backup record for" << filepath;
+        }
+
+        return success;
+    }
+
+    void BackupJournal::compactIfNeeded() {
+        if (!m_Journal.isOpen()) { return; }
+
+        const int recordsCount = m_Journal.getRecordsCount();
+        if ((recordsCount > COMPACTION_MIN_RECORDS) && (recordsCount > 2 * m_Backups.size())) {
+            compact();
+        }
+    }
+
+    bool BackupJournal::compact() {
+        LOG_INFO << "Compacting" << m_Journal.getRecordsCount() << "records into" << m_Backups.size();
+
+        QByteArray records;
+        QHashIterator<QString, QHash<QString, QString> > it(m_Backups);
+        while (it.hasNext()) {
+            it.next();
+            records.append(serializeRecord(PutRecord, it.key(), it.value()));
+        }
+
+        return m_Journal.replaceRecords(records, m_Backups.size());
+    }
+}
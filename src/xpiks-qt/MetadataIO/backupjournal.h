@@ -0,0 +1,73 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BACKUPJOURNAL_H
+#define BACKUPJOURNAL_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QSet>
+#include <QMutex>
+#include "../Helpers/recordjournal.h"
+
+namespace MetadataIO {
+    // all autosaves are kept in one append-only file instead of a sidecar per image
+    // every record is checksummed so a torn tail after crash is detected and cut off
+    // and the file is compacted into a fresh snapshot once it holds too many stale records
+    class BackupJournal
+    {
+    public:
+        BackupJournal();
+        virtual ~BackupJournal();
+
+    public:
+        void setJournalPath(const QString &filepath) { m_Journal.setPath(filepath); }
+        // returns true when backup is on disk
+        bool putBackup(const QString &filepath, const QHash<QString, QString> &dict);
+        void removeBackup(const QString &filepath);
+        void removeBackups(const QStringList &filepaths);
+        bool tryGetBackup(const QString &filepath, QHash<QString, QString> &dict);
+        // moves .xpks sidecars of previous versions into journal
+        // directory is listed only once per session
+        void migrateLegacyBackups(const QString &directory);
+        void close();
+
+    public:
+        static bool readLegacyBackup(const QString &path, QHash<QString, QString> &dict);
+
+    private:
+        void ensureLoaded();
+        void readJournal();
+        bool appendRecord(quint8 type, const QString &filepath, const QHash<QString, QString> &dict);
+        void compactIfNeeded();
+        bool compact();
+
+    private:
+        QMutex m_Mutex;
+        QHash<QString, QHash<QString, QString> > m_Backups;
+        QSet<QString> m_MigratedDirectories;
+        Helpers::RecordJournal m_Journal;
+        bool m_IsLoaded;
+    };
+}
+
+#endif // BACKUPJOURNAL_H
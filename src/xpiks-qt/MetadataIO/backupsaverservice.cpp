@@ -24,12 +24,30 @@
 #include "../Models/artworkmetadata.h"
 #include "saverworkerjobitem.h"
 #include "../Common/defines.h"
+#include "../Helpers/constants.h"
+#include <QDir>
+
+#define BACKUP_FLUSH_INTERVAL_MS 1000
+#define MAX_PENDING_BACKUPS 100
 
 namespace MetadataIO {
     BackupSaverService::BackupSaverService():
-        QObject()
+        QObject(),
+        m_CoalescedEditsCount(0),
+        m_SubmittedBackupsCount(0)
     {
-        m_BackupWorker = new BackupSaverWorker();
+        m_FlushTimer.setSingleShot(true);
+        QObject::connect(&m_FlushTimer, SIGNAL(timeout()), this, SLOT(flushTimerTriggered()));
+
+#ifndef CORE_TESTS
+        QString appDataPath = XPIKS_USERDATA_PATH;
+        if (!appDataPath.isEmpty()) {
+            QDir appDataDir(appDataPath);
+            m_BackupJournal.setJournalPath(appDataDir.filePath(Constants::BACKUPS_JOURNAL_FILENAME));
+        }
+#endif
+
+        m_BackupWorker = new BackupSaverWorker(&m_BackupJournal);
     }
 
     void BackupSaverService::startSaving() {
@@ -54,31 +72,92 @@ namespace MetadataIO {
         thread->start();
     }
 
-    void BackupSaverService::saveArtwork(Models::ArtworkMetadata *metadata) const {
-        std::shared_ptr<SaverWorkerJobItem> jobItem(new SaverWorkerJobItem(metadata));
-        m_BackupWorker->submitItem(jobItem);
+    void BackupSaverService::saveArtwork(Models::ArtworkMetadata *metadata) {
+        markDirty(metadata);
+
+        if (m_PendingJobs.size() >= MAX_PENDING_BACKUPS) {
+            flushDirtyArtworks();
+        } else if (!m_FlushTimer.isActive()) {
+            // timer is not restarted on subsequent edits to keep the delay bounded
+            m_FlushTimer.start(BACKUP_FLUSH_INTERVAL_MS);
+        }
     }
 
-    void BackupSaverService::saveArtworks(const QVector<Models::ArtworkMetadata *> &artworks) const {
+    void BackupSaverService::saveArtworks(const QVector<Models::ArtworkMetadata *> &artworks) {
         LOG_INFO << artworks.size() << "artwork(s)";
-        std::vector<std::shared_ptr<SaverWorkerJobItem> > jobs;
-        jobs.reserve(artworks.length());
 
         int size = artworks.size();
         for (int i = 0; i < size; ++i) {
-            jobs.emplace_back(new SaverWorkerJobItem(artworks.at(i)));
+            markDirty(artworks.at(i));
         }
 
+        // bulk edits are written right away together with everything pending
+        flushDirtyArtworks();
+    }
+
+    void BackupSaverService::markDirty(Models::ArtworkMetadata *metadata) {
+        Q_ASSERT(metadata != NULL);
+
+        if (m_DirtyArtworks.contains(metadata)) {
+            m_CoalescedEditsCount++;
+            return;
+        }
+
+        m_DirtyArtworks.insert(metadata);
+        // job item holds the artwork so it cannot be deleted while pending
+        m_PendingJobs.emplace_back(new SaverWorkerJobItem(metadata));
+    }
+
+    void BackupSaverService::flushDirtyArtworks() {
+        m_FlushTimer.stop();
+
+        if (m_PendingJobs.empty()) { return; }
+
+        std::vector<std::shared_ptr<SaverWorkerJobItem> > jobs;
+        jobs.swap(m_PendingJobs);
+        m_DirtyArtworks.clear();
+
+        m_SubmittedBackupsCount += (int)jobs.size();
+        LOG_DEBUG << "Submitting" << jobs.size() << "backup(s). Written:" << m_SubmittedBackupsCount << "coalesced:" << m_CoalescedEditsCount;
+
         m_BackupWorker->submitItems(jobs);
     }
 
+    void BackupSaverService::flushTimerTriggered() {
+        LOG_DEBUG << "#";
+        flushDirtyArtworks();
+    }
+
     void BackupSaverService::workerFinished() {
         LOG_INFO << "#";
     }
 
     void BackupSaverService::stopSaving() {
         LOG_DEBUG << "stopping...";
-        m_BackupWorker->stopWorking();
+        LOG_INFO << "Backups written:" << m_SubmittedBackupsCount << "edits coalesced:" << m_CoalescedEditsCount;
+        m_FlushTimer.stop();
+
+        // edits made right before exit are written here instead of waiting for the worker
+        writePendingJobs();
+
+        // backups already submitted are still written before the worker stops
+        m_BackupWorker->stopWorking(false);
+    }
+
+    void BackupSaverService::writePendingJobs() {
+        if (m_PendingJobs.empty()) { return; }
+
+        LOG_INFO << "Writing" << m_PendingJobs.size() << "pending backup(s)";
+
+        for (auto &job: m_PendingJobs) {
+            Models::ArtworkMetadata *metadata = job->getMetadata();
+            MetadataSavingCopy copy(metadata->getBasicModel());
+            copy.saveToJournal(&m_BackupJournal, metadata->getFilepath());
+        }
+
+        m_SubmittedBackupsCount += (int)m_PendingJobs.size();
+        m_DirtyArtworks.clear();
+        m_PendingJobs.clear();
     }
 }
 
@@ -24,6 +24,11 @@
 
 #include <QObject>
 #include <QVector>
+#include <QSet>
+#include <QTimer>
+#include <vector>
+#include <memory>
+#include "backupjournal.h"
 
 namespace Models {
     class ArtworkMetadata;
@@ -31,6 +36,7 @@ namespace Models {
 
 namespace MetadataIO {
     class BackupSaverWorker;
+    class SaverWorkerJobItem;
 
     class BackupSaverService : public QObject
     {
@@ -41,19 +47,36 @@ namespace MetadataIO {
     public:
         void startSaving();
         void stopSaving();
-        void saveArtwork(Models::ArtworkMetadata *metadata) const;
-        void saveArtworks(const QVector<Models::ArtworkMetadata *> &artworks) const;
+        void saveArtwork(Models::ArtworkMetadata *metadata);
+        void saveArtworks(const QVector<Models::ArtworkMetadata *> &artworks);
         void readArtwork(Models::ArtworkMetadata *metadata) const;
         void readArtworks(const QVector<Models::ArtworkMetadata *> &artworks) const;
+        BackupJournal *getBackupJournal() { return &m_BackupJournal; }
+        int getCoalescedEditsCount() const { return m_CoalescedEditsCount; }
+        int getSubmittedBackupsCount() const { return m_SubmittedBackupsCount; }
 
     signals:
         void cancelSaving();
 
     private slots:
         void workerFinished();
+        void flushTimerTriggered();
 
     private:
+        void markDirty(Models::ArtworkMetadata *metadata);
+        void flushDirtyArtworks();
+        void writePendingJobs();
+
+    private:
+        BackupJournal m_BackupJournal;
+        // edits are collected here and submitted to the worker in batches
+        // so that typing in one artwork results in one backup write
+        QSet<Models::ArtworkMetadata *> m_DirtyArtworks;
+        std::vector<std::shared_ptr<SaverWorkerJobItem> > m_PendingJobs;
+        QTimer m_FlushTimer;
         BackupSaverWorker *m_BackupWorker;
+        int m_CoalescedEditsCount;
+        int m_SubmittedBackupsCount;
     };
 }
 
@@ -24,8 +24,15 @@
 #include "../Helpers/constants.h"
 #include "../Models/artworkmetadata.h"
 #include "../Common/defines.h"
+#include "backupjournal.h"
 
 namespace MetadataIO {
+    BackupSaverWorker::BackupSaverWorker(BackupJournal *backupJournal):
+        m_BackupJournal(backupJournal)
+    {
+        Q_ASSERT(backupJournal != NULL);
+    }
+
     bool BackupSaverWorker::initWorker() {
         LOG_DEBUG << "#";
         return true;
@@ -34,6 +41,6 @@ namespace MetadataIO {
     void BackupSaverWorker::processOneItem(std::shared_ptr<SaverWorkerJobItem> &item) {
         Models::ArtworkMetadata *metadata = item->getMetadata();
         MetadataSavingCopy copy(metadata->getBasicModel());
-        copy.saveToFile(metadata->getFilepath());
+        copy.saveToJournal(m_BackupJournal, metadata->getFilepath());
     }
 }
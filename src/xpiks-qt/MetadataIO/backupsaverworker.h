@@ -27,9 +27,14 @@
 #include "saverworkerjobitem.h"
 
 namespace MetadataIO {
+    class BackupJournal;
+
     class BackupSaverWorker : public QObject, public Common::ItemProcessingWorker<SaverWorkerJobItem>
     {
         Q_OBJECT
+    public:
+        BackupSaverWorker(BackupJournal *backupJournal);
+
     protected:
         virtual bool initWorker() override;
         virtual void processOneItem(std::shared_ptr<SaverWorkerJobItem> &item) override;
@@ -45,6 +50,9 @@ namespace MetadataIO {
     signals:
         void stopped();
         void queueIsEmpty();
+
+    private:
+        BackupJournal *m_BackupJournal;
     };
 }
 
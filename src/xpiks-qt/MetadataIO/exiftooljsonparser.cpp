@@ -0,0 +1,110 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "exiftooljsonparser.h"
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include "../Common/defines.h"
+
+namespace MetadataIO {
+    ExiftoolJsonParser::ExiftoolJsonParser(std::function<void (const QJsonObject &)> onObjectParsed):
+        m_OnObjectParsed(onObjectParsed),
+        m_Depth(0),
+        m_ParsedCount(0),
+        m_ErrorsCount(0),
+        m_InString(false),
+        m_Escaped(false)
+    {
+    }
+
+    void ExiftoolJsonParser::feed(const QByteArray &chunk) {
+        const int size = chunk.size();
+        const char *data = chunk.constData();
+        // start of the part of chunk which belongs to the current object
+        int objectStart = (m_Depth > 0) ? 0 : -1;
+
+        for (int i = 0; i < size; ++i) {
+            const char c = data[i];
+
+            if (m_Depth == 0) {
+                // array brackets, commas and whitespace between objects
+                if (c == '{') {
+                    m_Depth = 1;
+                    objectStart = i;
+                    m_CurrentObject.clear();
+                }
+
+                continue;
+            }
+
+            if (m_InString) {
+                if (m_Escaped) {
+                    m_Escaped = false;
+                } else if (c == '\\') {
+                    m_Escaped = true;
+                } else if (c == '"') {
+                    m_InString = false;
+                }
+
+                continue;
+            }
+
+            if (c == '"') {
+                m_InString = true;
+            } else if ((c == '{') || (c == '[')) {
+                m_Depth++;
+            } else if ((c == '}') || (c == ']')) {
+                m_Depth--;
+
+                if (m_Depth == 0) {
+                    m_CurrentObject.append(data + objectStart, i - objectStart + 1);
+                    objectStart = -1;
+                    finishObject();
+                }
+            }
+        }
+
+        if (objectStart != -1) {
+            m_CurrentObject.append(data + objectStart, size - objectStart);
+        }
+    }
+
+    void ExiftoolJsonParser::reset() {
+        m_CurrentObject.clear();
+        m_Depth = 0;
+        m_InString = false;
+        m_Escaped = false;
+    }
+
+    void ExiftoolJsonParser::finishObject() {
+        QJsonParseError error;
+        QJsonDocument document = QJsonDocument::fromJson(m_CurrentObject, &error);
+        m_CurrentObject.clear();
+
+        if (document.isObject()) {
+            m_ParsedCount++;
+            m_OnObjectParsed(document.object());
+        } else {
+            m_ErrorsCount++;
+            LOG_WARNING << "Failed to parse exiftool object:" << error.errorString();
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EXIFTOOLJSONPARSER_H
+#define EXIFTOOLJSONPARSER_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <functional>
+
+namespace MetadataIO {
+    // incremental parser for the "-json" output of exiftool
+    // every top-level object is reported as soon as its closing brace arrives
+    // so only one file object is buffered at a time
+    class ExiftoolJsonParser
+    {
+    public:
+        ExiftoolJsonParser(std::function<void (const QJsonObject &)> onObjectParsed);
+
+    public:
+        void feed(const QByteArray &chunk);
+        void reset();
+        int getParsedCount() const { return m_ParsedCount; }
+        int getErrorsCount() const { return m_ErrorsCount; }
+
+    private:
+        void finishObject();
+
+    private:
+        std::function<void (const QJsonObject &)> m_OnObjectParsed;
+        QByteArray m_CurrentObject;
+        int m_Depth;
+        int m_ParsedCount;
+        int m_ErrorsCount;
+        bool m_InString;
+        bool m_Escaped;
+    };
+}
+
+#endif // EXIFTOOLJSONPARSER_H
@@ -0,0 +1,238 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "exiftoolprocess.h"
+#include <QProcess>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include "../Common/defines.h"
+
+#define EXIFTOOL_START_TIMEOUT 5000
+#define EXIFTOOL_STOP_TIMEOUT 3000
+#define EXIFTOOL_ERRORS_TIMEOUT 1000
+
+namespace MetadataIO {
+    ExiftoolProcess::ExiftoolProcess(QObject *parent) :
+        QObject(parent),
+        m_Process(NULL),
+        m_IsKilled(0),
+        m_CommandNumber(0)
+    {
+    }
+
+    ExiftoolProcess::~ExiftoolProcess() {
+        shutdownProcess();
+        LOG_DEBUG << "destroyed";
+    }
+
+    bool ExiftoolProcess::ensureStarted(const QString &exiftoolPath) {
+        if ((m_Process != NULL) &&
+                (m_Process->state() == QProcess::Running) &&
+                (m_ExiftoolPath == exiftoolPath)) {
+            return true;
+        }
+
+        shutdownProcess();
+
+        if (m_IsKilled.loadAcquire() != 0) {
+            LOG_WARNING << "Exiftool was killed. Not restarting";
+            return false;
+        }
+
+        LOG_INFO << "Starting exiftool:" << exiftoolPath;
+
+        QProcess *process = new QProcess(this);
+        process->start(exiftoolPath, QStringList() << "-stay_open" << "True" << "-@" << "-");
+
+        bool started = process->waitForStarted(EXIFTOOL_START_TIMEOUT);
+        if (started) {
+            m_ExiftoolPath = exiftoolPath;
+
+            QMutexLocker locker(&m_ProcessMutex);
+            m_Process = process;
+        } else {
+            LOG_WARNING << "Failed to start exiftool:" << process->errorString();
+            delete process;
+        }
+
+        return started;
+    }
+
+    bool ExiftoolProcess::execute(const QStringList &arguments, int timeoutMsecs, QByteArray &output, bool &anyError) {
+        return execute(arguments, timeoutMsecs,
+                       [&output](const QByteArray &chunk) { output.append(chunk); },
+                       anyError);
+    }
+
+    bool ExiftoolProcess::execute(const QStringList &arguments, int timeoutMsecs,
+                                  std::function<void (const QByteArray &)> outputConsumer, bool &anyError) {
+        Q_ASSERT(m_Process != NULL);
+        if (m_Process == NULL) { return false; }
+
+        QByteArray command;
+        foreach (const QString &argument, arguments) {
+            command.append(argument.toUtf8());
+            command.append('\n');
+        }
+
+        // numbered marker can not be confused with output of previous command
+        m_CommandNumber++;
+        const QByteArray number = QByteArray::number(m_CommandNumber);
+        const QByteArray readyMarker = "{ready" + number + "}";
+        // stderr is not delimited by -execute so marker is echoed there when command is done
+        command.append("-echo4\n" + readyMarker + "\n");
+        command.append("-execute" + number + "\n");
+
+        m_Process->write(command);
+
+        bool success = readUntilReady(QProcess::StandardOutput, readyMarker, timeoutMsecs, outputConsumer);
+        // errors of unfinished command can not be separated from the next one anyway
+        anyError = readErrors(success ? readyMarker : QByteArray());
+
+        if (!success) {
+            LOG_WARNING << "Exiftool did not finish the command in time. Restarting...";
+            shutdownProcess();
+        }
+
+        return success;
+    }
+
+    void ExiftoolProcess::stop() {
+        LOG_DEBUG << "#";
+        shutdownProcess();
+        emit stopped();
+    }
+
+    void ExiftoolProcess::killProcess() {
+        m_IsKilled.storeRelease(1);
+
+        QMutexLocker locker(&m_ProcessMutex);
+        if (m_Process != NULL) {
+            LOG_WARNING << "Killing exiftool...";
+            m_Process->kill();
+        }
+    }
+
+    bool ExiftoolProcess::readUntilReady(QProcess::ProcessChannel channel, const QByteArray &readyMarker, int timeoutMsecs,
+                                         std::function<void (const QByteArray &)> outputConsumer) {
+        // waitForReadyRead() waits only for the current read channel
+        m_Process->setReadChannel(channel);
+
+        // tail which might be the beginning of the marker is held back
+        const int maxTailSize = readyMarker.size() - 1;
+
+        QElapsedTimer timer;
+        timer.start();
+
+        QByteArray pending;
+        // marker is accepted only at the beginning of a line
+        char lastConsumed = '\n';
+        bool success = false;
+
+        for (;;) {
+            pending.append(m_Process->readAll());
+
+            int markerIndex = -1;
+            int searchFrom = 0;
+            for (;;) {
+                const int index = pending.indexOf(readyMarker, searchFrom);
+                if (index == -1) { break; }
+
+                const char previous = (index > 0) ? pending.at(index - 1) : lastConsumed;
+                if (previous == '\n') {
+                    markerIndex = index;
+                    break;
+                }
+
+                searchFrom = index + 1;
+            }
+
+            if (markerIndex != -1) {
+                if (markerIndex > 0) {
+                    outputConsumer(pending.left(markerIndex));
+                }
+
+                success = true;
+                break;
+            }
+
+            if (pending.size() > maxTailSize) {
+                const int consumedSize = pending.size() - maxTailSize;
+                lastConsumed = pending.at(consumedSize - 1);
+                outputConsumer(pending.left(consumedSize));
+                pending.remove(0, consumedSize);
+            }
+
+            const qint64 msecsLeft = timeoutMsecs - timer.elapsed();
+            if ((msecsLeft <= 0) || (m_Process->state() != QProcess::Running)) {
+                break;
+            }
+
+            m_Process->waitForReadyRead((int)msecsLeft);
+        }
+
+        m_Process->setReadChannel(QProcess::StandardOutput);
+
+        return success;
+    }
+
+    bool ExiftoolProcess::readErrors(const QByteArray &readyMarker) {
+        bool anyError = false;
+        QByteArray stderrByteArray;
+
+        if (!readyMarker.isEmpty()) {
+            bool found = readUntilReady(QProcess::StandardError, readyMarker, EXIFTOOL_ERRORS_TIMEOUT,
+                                        [&stderrByteArray](const QByteArray &chunk) { stderrByteArray.append(chunk); });
+            if (!found) {
+                LOG_WARNING << "Exiftool did not report errors of the command in time";
+            }
+        } else {
+            stderrByteArray = m_Process->readAllStandardError();
+        }
+
+        if (!stderrByteArray.isEmpty()) {
+            QString stderrText = QString::fromUtf8(stderrByteArray);
+            LOG_DEBUG << "STDERR [Exiftool]:" << stderrText;
+            anyError = stderrText.contains(QLatin1String("Error"));
+        }
+
+        return anyError;
+    }
+
+    void ExiftoolProcess::shutdownProcess() {
+        if (m_Process == NULL) { return; }
+
+        if (m_Process->state() == QProcess::Running) {
+            m_Process->write("-stay_open\nFalse\n");
+
+            if (!m_Process->waitForFinished(EXIFTOOL_STOP_TIMEOUT)) {
+                LOG_WARNING << "Exiftool did not stop in time. Killing...";
+                m_Process->kill();
+                m_Process->waitForFinished(EXIFTOOL_STOP_TIMEOUT);
+            }
+        }
+
+        QMutexLocker locker(&m_ProcessMutex);
+        delete m_Process;
+        m_Process = NULL;
+        m_ExiftoolPath.clear();
+    }
+}
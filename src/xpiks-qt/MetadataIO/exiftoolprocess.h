@@ -0,0 +1,81 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EXIFTOOLPROCESS_H
+#define EXIFTOOLPROCESS_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QProcess>
+#include <functional>
+
+namespace MetadataIO {
+    // long-living exiftool started with "-stay_open True -@ -"
+    // commands are streamed to stdin as "-execute<N>" and each one is finished with "{ready<N>}"
+    // the same marker is echoed to stderr so errors of one command are not mixed with the next one
+    // should be used only from the thread it lives in except killProcess()
+    class ExiftoolProcess : public QObject
+    {
+        Q_OBJECT
+    public:
+        explicit ExiftoolProcess(QObject *parent = 0);
+        virtual ~ExiftoolProcess();
+
+    public:
+        bool ensureStarted(const QString &exiftoolPath);
+        bool execute(const QStringList &arguments, int timeoutMsecs, QByteArray &output, bool &anyError);
+        // output is passed to the consumer chunk by chunk as soon as it arrives
+        bool execute(const QStringList &arguments, int timeoutMsecs,
+                     std::function<void (const QByteArray &)> outputConsumer, bool &anyError);
+
+    signals:
+        void stopped();
+
+    public:
+        // can be called from any thread to unblock a hanging command
+        // process is not restarted after that
+        void killProcess();
+
+    public slots:
+        void stop();
+
+    private:
+        bool readUntilReady(QProcess::ProcessChannel channel, const QByteArray &readyMarker, int timeoutMsecs,
+                            std::function<void (const QByteArray &)> outputConsumer);
+        // returns true if command reported an error
+        bool readErrors(const QByteArray &readyMarker);
+        void shutdownProcess();
+
+    private:
+        // guards process pointer against killProcess() from another thread
+        QMutex m_ProcessMutex;
+        QProcess *m_Process;
+        QString m_ExiftoolPath;
+        QAtomicInt m_IsKilled;
+        int m_CommandNumber;
+    };
+}
+
+#endif // EXIFTOOLPROCESS_H
@@ -0,0 +1,128 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "exiv2metadatacache.h"
+#include <QMutexLocker>
+#include "../Common/defines.h"
+
+#define METADATUM_OVERHEAD 64
+// large makernotes or thumbnails are cheaper to parse again than to keep
+#define MAX_ENTRY_PART_OF_CACHE 16
+
+namespace MetadataIO {
+    template<typename T>
+    qint64 estimateMetadataSize(const T &metadata) {
+        qint64 size = 0;
+        for (auto it = metadata.begin(), end = metadata.end(); it != end; ++it) {
+            size += it->size() + METADATUM_OVERHEAD;
+        }
+        return size;
+    }
+
+    qint64 estimateMetadataSize(Exiv2::Image &image) {
+        return estimateMetadataSize(image.xmpData()) +
+                estimateMetadataSize(image.iptcData()) +
+                estimateMetadataSize(image.exifData()) +
+                (qint64)image.comment().size();
+    }
+
+    Exiv2MetadataCache::Exiv2MetadataCache(int maxSize, qint64 maxBytes):
+        m_MaxSize(maxSize),
+        m_MaxBytes(maxBytes),
+        m_TotalBytes(0)
+    {
+        Q_ASSERT(maxSize > 0);
+        Q_ASSERT(maxBytes > 0);
+    }
+
+    void Exiv2MetadataCache::put(const QString &filepath, const QDateTime &lastModified, qint64 fileSize, Exiv2::Image &image) {
+        const qint64 estimatedSize = estimateMetadataSize(image);
+        if (estimatedSize > m_MaxBytes / MAX_ENTRY_PART_OF_CACHE) {
+            LOG_DEBUG << "Metadata is too big to cache:" << estimatedSize << "bytes for" << filepath;
+            remove(filepath);
+            return;
+        }
+
+        CachedExiv2Metadata metadata;
+        metadata.LastModified = lastModified;
+        metadata.FileSize = fileSize;
+        metadata.XmpData = image.xmpData();
+        metadata.IptcData = image.iptcData();
+        metadata.ExifData = image.exifData();
+        metadata.Comment = image.comment();
+        metadata.EstimatedSize = estimatedSize;
+
+        QMutexLocker locker(&m_Mutex);
+
+        removeUnsafe(filepath);
+
+        m_InsertionOrder.enqueue(filepath);
+        m_Cache.insert(filepath, metadata);
+        m_TotalBytes += estimatedSize;
+
+        while ((m_InsertionOrder.size() > m_MaxSize) || (m_TotalBytes > m_MaxBytes)) {
+            const QString oldestPath = m_InsertionOrder.head();
+            removeUnsafe(oldestPath);
+        }
+    }
+
+    bool Exiv2MetadataCache::tryGet(const QString &filepath, const QDateTime &lastModified, qint64 fileSize, CachedExiv2Metadata &metadata) {
+        QMutexLocker locker(&m_Mutex);
+
+        auto it = m_Cache.constFind(filepath);
+        if (it == m_Cache.constEnd()) { return false; }
+
+        const CachedExiv2Metadata &cached = it.value();
+        if ((cached.FileSize != fileSize) || (cached.LastModified != lastModified)) {
+            LOG_DEBUG << "Cached metadata is outdated for" << filepath;
+            return false;
+        }
+
+        metadata = cached;
+        return true;
+    }
+
+    void Exiv2MetadataCache::remove(const QString &filepath) {
+        QMutexLocker locker(&m_Mutex);
+        removeUnsafe(filepath);
+    }
+
+    void Exiv2MetadataCache::clear() {
+        QMutexLocker locker(&m_Mutex);
+        m_Cache.clear();
+        m_InsertionOrder.clear();
+        m_TotalBytes = 0;
+    }
+
+    qint64 Exiv2MetadataCache::getEstimatedSize() {
+        QMutexLocker locker(&m_Mutex);
+        return m_TotalBytes;
+    }
+
+    void Exiv2MetadataCache::removeUnsafe(const QString &filepath) {
+        auto it = m_Cache.find(filepath);
+        if (it == m_Cache.end()) { return; }
+
+        m_TotalBytes -= it.value().EstimatedSize;
+        m_Cache.erase(it);
+        m_InsertionOrder.removeOne(filepath);
+    }
+}
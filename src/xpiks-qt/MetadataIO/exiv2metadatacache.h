@@ -0,0 +1,77 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EXIV2METADATACACHE_H
+#define EXIV2METADATACACHE_H
+
+#include <QHash>
+#include <QQueue>
+#include <QString>
+#include <QDateTime>
+#include <QMutex>
+#include <string>
+
+#ifdef Q_OS_WIN32
+#define _X86_
+#endif
+#include <exiv2/exiv2.hpp>
+
+namespace MetadataIO {
+    struct CachedExiv2Metadata {
+        QDateTime LastModified;
+        qint64 FileSize;
+        Exiv2::XmpData XmpData;
+        Exiv2::IptcData IptcData;
+        Exiv2::ExifData ExifData;
+        std::string Comment;
+        qint64 EstimatedSize;
+    };
+
+    // metadata parsed at import time is kept here so the writer
+    // does not need to parse the same file again if it was not modified since
+    // cache is limited both by count and by estimated size of metadata values
+    class Exiv2MetadataCache
+    {
+    public:
+        Exiv2MetadataCache(int maxSize, qint64 maxBytes);
+
+    public:
+        void put(const QString &filepath, const QDateTime &lastModified, qint64 fileSize, Exiv2::Image &image);
+        // returns true only if the file size and modification time did not change
+        bool tryGet(const QString &filepath, const QDateTime &lastModified, qint64 fileSize, CachedExiv2Metadata &metadata);
+        void remove(const QString &filepath);
+        void clear();
+        qint64 getEstimatedSize();
+
+    private:
+        void removeUnsafe(const QString &filepath);
+
+    private:
+        QMutex m_Mutex;
+        QHash<QString, CachedExiv2Metadata> m_Cache;
+        QQueue<QString> m_InsertionOrder;
+        int m_MaxSize;
+        qint64 m_MaxBytes;
+        qint64 m_TotalBytes;
+    };
+}
+
+#endif // EXIV2METADATACACHE_H
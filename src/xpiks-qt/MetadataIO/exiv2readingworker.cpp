@@ -23,7 +23,8 @@
 #include <QVector>
 #include <QTextCodec>
 #include <QDateTime>
-#include <QImageReader>
+#include <QFile>
+#include <QFileInfo>
 #include <QStringList>
 #include <sstream>
 #include <string>
@@ -33,6 +34,8 @@
 #include "../Helpers/stringhelper.h"
 #include "saverworkerjobitem.h"
 #include "exiv2tagnames.h"
+#include "exiv2metadatacache.h"
+#include "metadatareadcache.h"
 
 #ifdef Q_OS_WIN32
 #define _X86_
@@ -40,6 +43,7 @@
 #include <exiv2/exiv2.hpp>
 
 #define X_DEFAULT QString::fromLatin1("x-default")
+#define EXIV2_READING_BATCH_SIZE 20
 
 namespace MetadataIO {
     QStringList decomposeKeyword(const QString &keyword) {
@@ -501,14 +505,60 @@ namespace MetadataIO {
         return dateTime;
     }
 
-    Exiv2ReadingWorker::Exiv2ReadingWorker(int index, QVector<Models::ArtworkMetadata *> itemsToRead, QObject *parent):
+    bool isSupportedImageType(int imageType) {
+        return (imageType == Exiv2::ImageType::jpeg) ||
+                (imageType == Exiv2::ImageType::tiff);
+    }
+
+    Exiv2::Image::AutoPtr probeImage(QFile &file) {
+        Exiv2::Image::AutoPtr image;
+
+        const qint64 fileSize = file.size();
+        // mapped memory is released when the file is closed
+        // so the image should not outlive the file object
+        uchar *fileData = file.map(0, fileSize);
+
+        if (fileData != NULL) {
+            const Exiv2::byte *data = fileData;
+            const long size = (long)fileSize;
+
+            if (isSupportedImageType(Exiv2::ImageFactory::getType(data, size))) {
+                image = Exiv2::ImageFactory::open(data, size);
+            }
+        } else {
+            LOG_DEBUG << "Failed to map" << file.fileName() << "Falling back to file access";
+            const QString filepath = file.fileName();
+#if defined(Q_OS_WIN)
+            const std::wstring path = filepath.toStdWString();
+#else
+            const std::string path = filepath.toStdString();
+#endif
+            if (isSupportedImageType(Exiv2::ImageFactory::getType(path))) {
+                image = Exiv2::ImageFactory::open(path);
+            }
+        }
+
+        return image;
+    }
+
+    Exiv2ReadingWorker::Exiv2ReadingWorker(int index, const std::shared_ptr<ArtworksWorkQueue> &workQueue,
+                                           const std::shared_ptr<ImportResultsCollector> &resultsCollector,
+                                           const std::shared_ptr<Exiv2MetadataCache> &metadataCache,
+                                           MetadataReadCache *readCache,
+                                           BackupJournal *backupJournal,
+                                           QObject *parent):
         QObject(parent),
-        m_ItemsToRead(itemsToRead),
+        m_WorkQueue(workQueue),
+        m_ResultsCollector(resultsCollector),
+        m_MetadataCache(metadataCache),
+        m_ReadCache(readCache),
+        m_BackupJournal(backupJournal),
         m_WorkerIndex(index),
         m_Stopped(false)
     {
-        Q_ASSERT(!itemsToRead.isEmpty());
-        LOG_INFO << "Worker [" << index << "]:" << itemsToRead.size() << "items to read";
+        Q_ASSERT(m_WorkQueue);
+        Q_ASSERT(m_ResultsCollector);
+        LOG_INFO << "Worker [" << index << "] created";
     }
 
     Exiv2ReadingWorker::~Exiv2ReadingWorker() {
@@ -519,19 +569,20 @@ namespace MetadataIO {
         LOG_INFO << "Worker #" << m_WorkerIndex << "started";
 
         bool anyError = false;
+        int processedCount = 0;
+        int batchCount = 0;
 
-        int size = m_ItemsToRead.size();
-        for (int i = 0; i < size; ++i) {
-            if (m_Stopped) { break; }
+        Models::ArtworkMetadata *artwork = NULL;
+        int index = 0;
 
-            Models::ArtworkMetadata *artwork = m_ItemsToRead.at(i);
+        while (!m_Stopped && m_WorkQueue->tryGetNext(artwork, index)) {
             const QString &filepath = artwork->getFilepath();
             ImportDataResult importResult;
 
             try {
                 if (readMetadata(artwork, importResult)) {
-                    Q_ASSERT(!m_ImportResult.contains(filepath));
-                    m_ImportResult.insert(filepath, importResult);
+                    m_ResultsCollector->addResult(artwork, importResult);
+                    batchCount++;
                 }
             }
             catch(Exiv2::Error &error) {
@@ -542,11 +593,20 @@ namespace MetadataIO {
                 anyError = true;
                 LOG_WARNING << "Worker" << m_WorkerIndex << "Reading error for item" << filepath;
             }
+
+            m_WorkQueue->markProcessed();
+            processedCount++;
+
+            if (batchCount >= EXIV2_READING_BATCH_SIZE) {
+                batchCount = 0;
+                emit batchRead();
+            }
         }
 
-        LOG_INFO << "Worker #" << m_WorkerIndex << "finished";
+        LOG_INFO << "Worker #" << m_WorkerIndex << "finished." << processedCount << "items processed";
 
         emit finished(anyError);
+        emit stopped();
     }
 
     void Exiv2ReadingWorker::cancel() {
@@ -555,22 +615,33 @@ namespace MetadataIO {
 
     bool Exiv2ReadingWorker::readMetadata(Models::ArtworkMetadata *artwork, ImportDataResult &importResult) {
         const QString &filepath = artwork->getFilepath();
+        QFileInfo fileInfo(filepath);
+
+        if ((m_ReadCache != NULL) &&
+                m_ReadCache->tryGet(filepath, fileInfo.lastModified(), fileInfo.size(), importResult)) {
+            readBackup(filepath, importResult);
+            return true;
+        }
 
-        QImageReader imageReader(filepath);
-        QString format = QString::fromLatin1(imageReader.format().toLower());
-        if (format != QLatin1String("jpeg") &&
-            format != QLatin1String("tiff")) {
+        // file is opened only once and format, dimensions, size
+        // and metadata are all retrieved from the same buffer
+        QFile file(filepath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            LOG_WARNING << "Failed to open" << filepath;
+            return false;
+        }
+
+        Exiv2::Image::AutoPtr image = probeImage(file);
+        if (image.get() == NULL) {
             return false;
         }
 
-#if defined(Q_OS_WIN)
-        Exiv2::Image::AutoPtr image = Exiv2::ImageFactory::open(filepath.toStdWString());
-#else
-        Exiv2::Image::AutoPtr image = Exiv2::ImageFactory::open(filepath.toStdString());
-#endif
-        Q_ASSERT(image.get() != NULL);
         image->readMetadata();
 
+        if (m_MetadataCache) {
+            m_MetadataCache->put(filepath, fileInfo.lastModified(), fileInfo.size(), *image);
+        }
+
         Exiv2::XmpData &xmpData = image->xmpData();
         Exiv2::ExifData &exifData = image->exifData();
         Exiv2::IptcData &iptcData = image->iptcData();
@@ -583,20 +654,26 @@ namespace MetadataIO {
         importResult.Title = retrieveTitle(xmpData, exifData, iptcData, isIptcUtf8);
         importResult.Keywords = retrieveKeywords(xmpData, exifData, iptcData, isIptcUtf8);
         importResult.DateTimeOriginal = retrieveDateTime(xmpData, exifData, iptcData, isIptcUtf8);
+        importResult.FileSize = file.size();
 
-        MetadataSavingCopy copy;
-        if (copy.readFromFile(filepath)) {
-            importResult.BackupDict = copy.getInfo();
+        Models::ImageArtwork *imageArtwork = dynamic_cast<Models::ImageArtwork*>(artwork);
+        if (imageArtwork != NULL) {
+            importResult.ImageSize = QSize(image->pixelWidth(), image->pixelHeight());
         }
 
-        QFileInfo fi(filepath);
-        importResult.FileSize = fi.size();
-
-        Models::ImageArtwork *imageArtwork = dynamic_cast<Models::ImageArtwork*>(artwork);
-        if (imageArtwork != NULL) {            
-            importResult.ImageSize = imageReader.size();
+        if (m_ReadCache != NULL) {
+            m_ReadCache->put(filepath, fileInfo.lastModified(), importResult);
         }
 
+        readBackup(filepath, importResult);
+
         return true;
     }
+
+    void Exiv2ReadingWorker::readBackup(const QString &filepath, ImportDataResult &importResult) {
+        MetadataSavingCopy copy;
+        if (copy.readFromJournal(m_BackupJournal, filepath)) {
+            importResult.BackupDict = copy.getInfo();
+        }
+    }
 }
@@ -25,41 +25,57 @@
 #include <QObject>
 #include <QVector>
 #include <QHash>
+#include <memory>
 #include "importdataresult.h"
+#include "importresultscollector.h"
+#include "../Common/sharedworkqueue.h"
 
 namespace Models {
     class ArtworkMetadata;
 }
 
 namespace MetadataIO {
+    class Exiv2MetadataCache;
+    class MetadataReadCache;
+    class BackupJournal;
+
+    typedef Common::SharedWorkQueue<Models::ArtworkMetadata *> ArtworksWorkQueue;
+
     class Exiv2ReadingWorker : public QObject
     {
         Q_OBJECT
     public:
-        explicit Exiv2ReadingWorker(int index, QVector<Models::ArtworkMetadata *> itemsToRead, QObject *parent = 0);
+        explicit Exiv2ReadingWorker(int index, const std::shared_ptr<ArtworksWorkQueue> &workQueue,
+                                    const std::shared_ptr<ImportResultsCollector> &resultsCollector,
+                                    const std::shared_ptr<Exiv2MetadataCache> &metadataCache,
+                                    MetadataReadCache *readCache,
+                                    BackupJournal *backupJournal,
+                                    QObject *parent = 0);
         virtual ~Exiv2ReadingWorker();
 
     public:
-        const QHash<QString, ImportDataResult> &getImportResult() const { return m_ImportResult; }
         int getWorkerIndex() const { return m_WorkerIndex; }
 
-    public:
-        void dismiss() { emit stopped(); }
-
     public slots:
         void process();
         void cancel();
 
     signals:
+        // emitted after finished() so worker quits its thread
         void stopped();
         void finished(bool anyError);
+        void batchRead();
 
     private:
         bool readMetadata(Models::ArtworkMetadata *artwork, ImportDataResult &importResult);
+        void readBackup(const QString &filepath, ImportDataResult &importResult);
 
     private:
-        QVector<Models::ArtworkMetadata *> m_ItemsToRead;
-        QHash<QString, ImportDataResult> m_ImportResult;
+        std::shared_ptr<ArtworksWorkQueue> m_WorkQueue;
+        std::shared_ptr<ImportResultsCollector> m_ResultsCollector;
+        std::shared_ptr<Exiv2MetadataCache> m_MetadataCache;
+        MetadataReadCache *m_ReadCache;
+        BackupJournal *m_BackupJournal;
         int m_WorkerIndex;
         volatile bool m_Stopped;
     };
@@ -22,10 +22,14 @@
 #include "exiv2writingworker.h"
 #include <QStringList>
 #include <QTextCodec>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
 #include "../Models/artworkmetadata.h"
 #include "../Common/defines.h"
 #include "../Helpers/stringhelper.h"
 #include "exiv2tagnames.h"
+#include "exiv2metadatacache.h"
 #include <string>
 
 #ifdef Q_OS_WIN32
@@ -33,6 +37,11 @@
 #endif
 #include <exiv2/exiv2.hpp>
 
+#ifndef Q_OS_WIN
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #define X_DEFAULT QString::fromLatin1("x-default")
 #define IPTC_MAX_DESCRIPTION_LEN 2000
 #define IPTC_MAX_TITLE_LEN 64
@@ -40,6 +49,56 @@
 namespace MetadataIO {
     typedef QMap<QString, QString> AltLangMap;
 
+    // replacing such file with a new one breaks hardlinks or changes the owner
+    bool needsInPlaceWrite(const QString &filepath) {
+#ifndef Q_OS_WIN
+        struct stat fileStat;
+        if (stat(QFile::encodeName(filepath).constData(), &fileStat) != 0) {
+            return false;
+        }
+
+        return (fileStat.st_nlink > 1) || (fileStat.st_uid != geteuid());
+#else
+        Q_UNUSED(filepath);
+        return false;
+#endif
+    }
+
+    bool writeFileInPlace(const QString &filepath, const Exiv2::byte *data, long size) {
+        QFile file(filepath);
+        if (!file.open(QIODevice::ReadWrite)) {
+            LOG_WARNING << "Failed to open" << filepath << "for writing";
+            return false;
+        }
+
+        bool success = (file.write((const char *)data, size) == size) && file.resize(size);
+        success = file.flush() && success;
+
+        if (!success) {
+            LOG_WARNING << "Failed to write" << filepath << file.errorString();
+        }
+
+        return success;
+    }
+
+    bool replaceFile(const QString &filepath, const Exiv2::byte *data, long size) {
+        // QSaveFile writes to a temporary file and renames it over the original on commit
+        QSaveFile saveFile(filepath);
+        if (!saveFile.open(QIODevice::WriteOnly)) {
+            LOG_WARNING << "Failed to open temporary file for" << filepath;
+            return false;
+        }
+
+        saveFile.write((const char *)data, size);
+
+        if (!saveFile.commit()) {
+            LOG_WARNING << "Failed to replace" << filepath << saveFile.errorString();
+            return false;
+        }
+
+        return true;
+    }
+
     void removeXmpTag(Exiv2::XmpData &xmpData, const char* propertyName) {
         Exiv2::XmpKey xmpKey(propertyName);
         Exiv2::XmpData::iterator it = xmpData.findKey(xmpKey);
@@ -323,27 +382,32 @@ namespace MetadataIO {
         Q_UNUSED(exifData);
     }
 
-    Exiv2WritingWorker::Exiv2WritingWorker(int index, QVector<Models::ArtworkMetadata *> itemsToWrite, QObject *parent) :
+    Exiv2WritingWorker::Exiv2WritingWorker(int index,
+                                           const std::shared_ptr<Common::SharedWorkQueue<Models::ArtworkMetadata *> > &workQueue,
+                                           const std::shared_ptr<Exiv2MetadataCache> &metadataCache,
+                                           QObject *parent) :
         QObject(parent),
-        m_ItemsToWrite(itemsToWrite),
+        m_WorkQueue(workQueue),
+        m_MetadataCache(metadataCache),
         m_WorkerIndex(index),
         m_Stopped(false)
     {
-        Q_ASSERT(!itemsToWrite.isEmpty());
-        LOG_INFO << "Worker [" << index << "]:" << itemsToWrite.size() << "items to write";
+        Q_ASSERT(m_WorkQueue);
+        LOG_INFO << "Worker [" << index << "] created";
     }
 
     void Exiv2WritingWorker::process() {
         bool anyError = false;
-        int size = m_ItemsToWrite.size();
+        int processedCount = 0;
 
-        for (int i = 0; i < size; ++i) {
-            if (m_Stopped) { break; }
-
-            Models::ArtworkMetadata *artwork = m_ItemsToWrite.at(i);
+        Models::ArtworkMetadata *artwork = NULL;
+        int index = 0;
 
+        while (!m_Stopped && m_WorkQueue->tryGetNext(artwork, index)) {
             try {
-                writeMetadata(artwork);
+                if (!writeMetadata(artwork)) {
+                    anyError = true;
+                }
             }
             catch(Exiv2::Error &error) {
                 anyError = true;
@@ -353,9 +417,13 @@ namespace MetadataIO {
                 anyError = true;
                 LOG_WARNING << "Worker" << m_WorkerIndex << "Writing error for item" << artwork->getFilepath();
             }
+
+            m_WorkQueue->markProcessed();
+            processedCount++;
+            emit itemWritten();
         }
 
-        LOG_INFO << "Worker #" << m_WorkerIndex << "finished";
+        LOG_INFO << "Worker #" << m_WorkerIndex << "finished." << processedCount << "items processed";
 
         emit finished(anyError);
     }
@@ -364,16 +432,42 @@ namespace MetadataIO {
         m_Stopped = true;
     }
 
-    void Exiv2WritingWorker::writeMetadata(Models::ArtworkMetadata *artwork) {
+    bool Exiv2WritingWorker::writeMetadata(Models::ArtworkMetadata *artwork) {
         const QString &filepath = artwork->getFilepath();
-#if defined(Q_OS_WIN)
-        Exiv2::Image::AutoPtr image = Exiv2::ImageFactory::open(filepath.toStdWString());
-#else
-        Exiv2::Image::AutoPtr image = Exiv2::ImageFactory::open(filepath.toStdString());
-#endif
+
+        QFileInfo fileInfo(filepath);
+
+        QByteArray fileData;
+        {
+            QFile file(filepath);
+            if (!file.open(QIODevice::ReadOnly)) {
+                LOG_WARNING << "Failed to open" << filepath;
+                return false;
+            }
+
+            fileData = file.readAll();
+        }
+
+        if (fileData.isEmpty()) {
+            LOG_WARNING << "Failed to read" << filepath;
+            return false;
+        }
+
+        // memory io does not copy the buffer and may write into it in place (e.g. TIFF)
+        // so it should be owned and writable and live until the output is written
+        Exiv2::Image::AutoPtr image = Exiv2::ImageFactory::open((const Exiv2::byte *)fileData.data(), (long)fileData.size());
         Q_ASSERT(image.get() != NULL);
 
-        image->readMetadata();
+        CachedExiv2Metadata cachedMetadata;
+        if (m_MetadataCache &&
+                m_MetadataCache->tryGet(filepath, fileInfo.lastModified(), fileInfo.size(), cachedMetadata)) {
+            image->setXmpData(cachedMetadata.XmpData);
+            image->setIptcData(cachedMetadata.IptcData);
+            image->setExifData(cachedMetadata.ExifData);
+            image->setComment(cachedMetadata.Comment);
+        } else {
+            image->readMetadata();
+        }
 
         Exiv2::XmpData &xmpData = image->xmpData();
         Exiv2::ExifData &exifData = image->exifData();
@@ -392,5 +486,27 @@ namespace MetadataIO {
         setArtworkKeywords(xmpData, exifData, iptcData, keywords);
 
         image->writeMetadata();
+
+        Exiv2::BasicIo &io = image->io();
+        io.open();
+        // memory io gives direct access to its buffer without a copy
+        const Exiv2::byte *editedData = io.mmap();
+        const long editedSize = io.size();
+
+        bool success = needsInPlaceWrite(filepath) ?
+                    writeFileInPlace(filepath, editedData, editedSize) :
+                    replaceFile(filepath, editedData, editedSize);
+
+        io.munmap();
+        io.close();
+
+        if (!success) { return false; }
+
+        if (m_MetadataCache) {
+            QFileInfo updatedInfo(filepath);
+            m_MetadataCache->put(filepath, updatedInfo.lastModified(), updatedInfo.size(), *image);
+        }
+
+        return true;
     }
 }
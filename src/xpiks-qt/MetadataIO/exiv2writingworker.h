@@ -24,17 +24,24 @@
 
 #include <QObject>
 #include <QVector>
+#include <memory>
+#include "../Common/sharedworkqueue.h"
 
 namespace Models {
     class ArtworkMetadata;
 }
 
 namespace MetadataIO {
+    class Exiv2MetadataCache;
+
     class Exiv2WritingWorker : public QObject
     {
         Q_OBJECT
     public:
-        explicit Exiv2WritingWorker(int index, QVector<Models::ArtworkMetadata *> itemsToWrite, QObject *parent = 0);
+        explicit Exiv2WritingWorker(int index,
+                                    const std::shared_ptr<Common::SharedWorkQueue<Models::ArtworkMetadata *> > &workQueue,
+                                    const std::shared_ptr<Exiv2MetadataCache> &metadataCache,
+                                    QObject *parent = 0);
 
     public:
         int getWorkerIndex() const { return m_WorkerIndex; }
@@ -47,12 +54,14 @@ namespace MetadataIO {
     signals:
         void stopped();
         void finished(bool anyError);
+        void itemWritten();
 
     private:
-        void writeMetadata(Models::ArtworkMetadata *artwork);
+        bool writeMetadata(Models::ArtworkMetadata *artwork);
 
     private:
-        QVector<Models::ArtworkMetadata*> m_ItemsToWrite;
+        std::shared_ptr<Common::SharedWorkQueue<Models::ArtworkMetadata *> > m_WorkQueue;
+        std::shared_ptr<Exiv2MetadataCache> m_MetadataCache;
         int m_WorkerIndex;
         volatile bool m_Stopped;
     };
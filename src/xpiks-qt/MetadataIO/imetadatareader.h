@@ -39,6 +39,16 @@ namespace MetadataIO {
         virtual const QHash<QString, ImportDataResult> &getImportResult() const = 0;
         virtual const QVector<Models::ArtworkMetadata *> &getItemsToRead() const = 0;
         virtual const QVector<QPair<int, int> > &getRangesToUpdate() const = 0;
+
+        // readers which can hand out results while still reading
+        virtual bool supportsBatches() const { return false; }
+        virtual void takeReadyBatch(QVector<Models::ArtworkMetadata *> &items, QHash<QString, ImportDataResult> &results) {
+            Q_UNUSED(items); Q_UNUSED(results);
+        }
+        // readers without batches can be asked only after they are finished
+        virtual void copyImportResult(QHash<QString, ImportDataResult> &results) {
+            results = getImportResult();
+        }
     };
 }
 
@@ -0,0 +1,81 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef IMPORTRESULTSCOLLECTOR_H
+#define IMPORTRESULTSCOLLECTOR_H
+
+#include <QVector>
+#include <QHash>
+#include <QString>
+#include <QMutex>
+#include <QMutexLocker>
+#include "importdataresult.h"
+
+namespace Models {
+    class ArtworkMetadata;
+}
+
+namespace MetadataIO {
+    // results of all reading workers end up here as soon as each file is read
+    // and can be taken in batches while the rest of the files are still being read
+    class ImportResultsCollector
+    {
+    public:
+        ImportResultsCollector() { }
+
+    public:
+        void addResult(Models::ArtworkMetadata *artwork, const ImportDataResult &result) {
+            QMutexLocker locker(&m_Mutex);
+            Q_ASSERT(!m_ImportResult.contains(result.FilePath));
+            m_ImportResult.insert(result.FilePath, result);
+            m_ReadyResults.insert(result.FilePath, result);
+            m_ReadyItems.append(artwork);
+        }
+
+        // moves out items read since the previous call together with their results
+        void takeReadyBatch(QVector<Models::ArtworkMetadata *> &items, QHash<QString, ImportDataResult> &results) {
+            QMutexLocker locker(&m_Mutex);
+
+            items.clear();
+            items.swap(m_ReadyItems);
+
+            results.clear();
+            results.swap(m_ReadyResults);
+        }
+
+        // should be used only when all the workers are finished
+        const QHash<QString, ImportDataResult> &getImportResult() const { return m_ImportResult; }
+
+        // can be used while workers are still adding results
+        void copyImportResult(QHash<QString, ImportDataResult> &results) {
+            QMutexLocker locker(&m_Mutex);
+            results = m_ImportResult;
+        }
+
+    private:
+        QMutex m_Mutex;
+        QHash<QString, ImportDataResult> m_ImportResult;
+        QHash<QString, ImportDataResult> m_ReadyResults;
+        QVector<Models::ArtworkMetadata *> m_ReadyItems;
+    };
+}
+
+#endif // IMPORTRESULTSCOLLECTOR_H
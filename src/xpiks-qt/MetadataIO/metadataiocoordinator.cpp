@@ -26,8 +26,11 @@
 #include <QFileInfo>
 #include <QProcess>
 #include <QImageReader>
+#include <QDir>
+#include <QThread>
 #include "metadatareadingworker.h"
 #include "metadatawritingworker.h"
+#include "exiftoolprocess.h"
 #include "backupsaverservice.h"
 #include "../Models/artworkmetadata.h"
 #include "../Models/settingsmodel.h"
@@ -36,9 +39,18 @@
 #include "saverworkerjobitem.h"
 #include "../Models/settingsmodel.h"
 #include "../Common/defines.h"
+#include "../Helpers/constants.h"
 #include "../Models/imageartwork.h"
 #include "readingorchestrator.h"
 #include "writingorchestrator.h"
+#ifndef CORE_TESTS
+#include "exiv2metadatacache.h"
+#endif
+
+#define UPDATE_ROWS_INTERVAL 500
+#define MAX_CACHED_METADATA 5000
+#define MAX_CACHED_METADATA_BYTES (64*1024*1024)
+#define EXIFTOOL_THREAD_STOP_TIMEOUT 1000
 
 namespace MetadataIO {
     bool tryGetExiftoolVersion(const QString &path, QString &version) {
@@ -64,7 +76,10 @@ namespace MetadataIO {
         Common::BaseEntity(),
         m_ReadingWorker(NULL),
         m_WritingWorker(NULL),
+        m_ExiftoolThread(NULL),
+        m_ExiftoolProcess(NULL),
         m_ProcessingItemsCount(0),
+        m_ProcessedItemsCount(0),
         m_IsImportInProgress(false),
         m_CanProcessResults(false),
         m_IgnoreBackupsAtImport(false),
@@ -75,11 +90,37 @@ namespace MetadataIO {
         QObject::connect(m_ExiftoolDiscoveryFuture, SIGNAL(finished()),
                          this, SLOT(exiftoolDiscoveryFinished()));
 
+        m_UpdateRowsTimer.setInterval(UPDATE_ROWS_INTERVAL);
+        m_UpdateRowsTimer.setSingleShot(true);
+        QObject::connect(&m_UpdateRowsTimer, SIGNAL(timeout()), this, SLOT(updateRowsTimerTriggered()));
+
+#ifndef CORE_TESTS
+        m_Exiv2MetadataCache.reset(new Exiv2MetadataCache(MAX_CACHED_METADATA, MAX_CACHED_METADATA_BYTES));
+
+        QString appDataPath = XPIKS_USERDATA_PATH;
+        if (!appDataPath.isEmpty()) {
+            QDir appDataDir(appDataPath);
+            m_ReadCache.setCachePath(appDataDir.filePath(Constants::METADATA_CACHE_FILENAME));
+        }
+#endif
+
         LOG_INFO << "Supported image formats:" << QImageReader::supportedImageFormats();
     }
 
+    MetadataIOCoordinator::~MetadataIOCoordinator() {
+        // cache must outlive its background save
+        waitReadCacheSaved();
+    }
+
     void MetadataIOCoordinator::readingWorkerFinished(bool success) {
         LOG_INFO << "Success:" << success;
+
+        IMetadataReader *reader = dynamic_cast<IMetadataReader *>(sender());
+        if ((reader == NULL) || (reader != m_ReadingWorker)) {
+            LOG_INFO << "Reading was discarded";
+            return;
+        }
+
         setHasErrors(!success);
 
         const QVector<Models::ArtworkMetadata*> &itemsToRead = m_ReadingWorker->getItemsToRead();
@@ -92,6 +133,28 @@ namespace MetadataIO {
         }
 
         m_IsImportInProgress = false;
+
+        // results of this import should survive a crash of the application
+        waitReadCacheSaved();
+        m_ReadCacheSaveFuture = QtConcurrent::run(&m_ReadCache, &MetadataReadCache::saveToFile);
+    }
+
+    void MetadataIOCoordinator::readingBatchReady() {
+        if (m_CanProcessResults && m_IsImportInProgress) {
+            applyReadyBatch(m_IgnoreBackupsAtImport);
+
+            // rows are refreshed once per interval instead of once per batch
+            if (!m_UpdateRowsTimer.isActive()) {
+                m_UpdateRowsTimer.start();
+            }
+        }
+    }
+
+    void MetadataIOCoordinator::updateRowsTimerTriggered() {
+        LOG_DEBUG << "#";
+        if (m_ReadingWorker != NULL) {
+            m_CommandManager->updateArtworks(m_ReadingWorker->getRangesToUpdate());
+        }
     }
 
     void MetadataIOCoordinator::writingWorkerFinished(bool success) {
@@ -99,9 +162,18 @@ namespace MetadataIO {
         setHasErrors(!success);
         const QVector<Models::ArtworkMetadata*> &artworksToWrite = m_WritingWorker->getItemsToWrite();
         m_CommandManager->addToLibrary(artworksToWrite);
+
+        if (success) {
+            removeBackups(artworksToWrite);
+        }
+
         emit metadataWritingFinished();
     }
 
+    void MetadataIOCoordinator::writingProgressChanged(int processedCount) {
+        setProcessedItemsCount(processedCount);
+    }
+
     void MetadataIOCoordinator::exiftoolDiscoveryFinished() {
         if (!m_ExiftoolNotFound && !m_RecommendedExiftoolPath.isEmpty()) {
             LOG_DEBUG << "Recommended exiftool path is" << m_RecommendedExiftoolPath;
@@ -119,36 +191,47 @@ namespace MetadataIO {
 
     void MetadataIOCoordinator::readMetadataExifTool(const QVector<Models::ArtworkMetadata *> &artworksToRead,
                                              const QVector<QPair<int, int> > &rangesToUpdate) {
+        ensureExiftoolThreadStarted();
+        waitReadCacheSaved();
+        m_ReadCache.ensureLoaded();
+
         MetadataReadingWorker *readingWorker = new MetadataReadingWorker(artworksToRead,
                                                     m_CommandManager->getSettingsModel(),
-                                                    rangesToUpdate);
-        QThread *thread = new QThread();
-        readingWorker->moveToThread(thread);
-
-        QObject::connect(thread, SIGNAL(started()), readingWorker, SLOT(process()));
-        QObject::connect(readingWorker, SIGNAL(stopped()), thread, SLOT(quit()));
+                                                    rangesToUpdate,
+                                                    m_ExiftoolProcess,
+                                                    &m_ReadCache,
+                                                    getBackupJournal());
 
         QObject::connect(readingWorker, SIGNAL(stopped()), readingWorker, SLOT(deleteLater()));
-        QObject::connect(thread, SIGNAL(finished()), thread, SLOT(deleteLater()));
 
         QObject::connect(readingWorker, SIGNAL(finished(bool)), this, SLOT(readingWorkerFinished(bool)));
         QObject::connect(this, SIGNAL(metadataReadingFinished()), readingWorker, SIGNAL(stopped()));
-        QObject::connect(this, SIGNAL(discardReadingSignal()), readingWorker, SLOT(cancel()));
+        // exiftool thread is busy with the worker so cancel flag should be set immediately
+        QObject::connect(this, SIGNAL(discardReadingSignal()), readingWorker, SLOT(cancel()), Qt::DirectConnection);
+        QObject::connect(this, SIGNAL(discardReadingSignal()), readingWorker, SIGNAL(stopped()));
 
         initializeImport(artworksToRead.count());
 
-        LOG_DEBUG << "Starting thread...";
-        thread->start();
-
         m_ReadingWorker = readingWorker;
+
+        startInExiftoolThread(readingWorker);
     }
 
 #ifndef CORE_TESTS
     void MetadataIOCoordinator::readMetadataExiv2(const QVector<Models::ArtworkMetadata *> &artworksToRead,
                                                   const QVector<QPair<int, int> > &rangesToUpdate) {
-        ReadingOrchestrator *readingOrchestrator = new ReadingOrchestrator(artworksToRead, rangesToUpdate);
+        Models::SettingsModel *settingsModel = m_CommandManager->getSettingsModel();
+        waitReadCacheSaved();
+        m_ReadCache.ensureLoaded();
+
+        ReadingOrchestrator *readingOrchestrator = new ReadingOrchestrator(artworksToRead, rangesToUpdate,
+                                                                           m_Exiv2MetadataCache,
+                                                                           &m_ReadCache,
+                                                                           getBackupJournal(),
+                                                                           settingsModel->getMaxMetadataThreads());
 
         QObject::connect(readingOrchestrator, SIGNAL(allFinished(bool)), this, SLOT(readingWorkerFinished(bool)));
+        QObject::connect(readingOrchestrator, SIGNAL(batchReady()), this, SLOT(readingBatchReady()));
         QObject::connect(this, SIGNAL(metadataReadingFinished()), readingOrchestrator, SLOT(dismiss()));
         QObject::connect(this, SIGNAL(discardReadingSignal()), readingOrchestrator, SLOT(dismiss()));
 
@@ -160,34 +243,38 @@ namespace MetadataIO {
 #endif
 
     void MetadataIOCoordinator::writeMetadataExifTool(const QVector<Models::ArtworkMetadata *> &artworksToWrite, bool useBackups) {
+        ensureExiftoolThreadStarted();
+
         MetadataWritingWorker *writingWorker = new MetadataWritingWorker(artworksToWrite,
                                                     m_CommandManager->getSettingsModel(),
-                                                    useBackups);
-        QThread *thread = new QThread();
-        writingWorker->moveToThread(thread);
-
-        QObject::connect(thread, SIGNAL(started()), writingWorker, SLOT(process()));
-        QObject::connect(writingWorker, SIGNAL(stopped()), thread, SLOT(quit()));
+                                                    useBackups,
+                                                    m_ExiftoolProcess);
 
         QObject::connect(writingWorker, SIGNAL(stopped()), writingWorker, SLOT(deleteLater()));
-        QObject::connect(thread, SIGNAL(finished()), thread, SLOT(deleteLater()));
 
         QObject::connect(writingWorker, SIGNAL(finished(bool)), this, SLOT(writingWorkerFinished(bool)));
         QObject::connect(this, SIGNAL(metadataWritingFinished()), writingWorker, SIGNAL(stopped()));
         setProcessingItemsCount(artworksToWrite.length());
 
-        LOG_DEBUG << "Starting thread...";
         m_WritingWorker = writingWorker;
-        thread->start();
+
+        startInExiftoolThread(writingWorker);
     }
 
 #ifndef CORE_TESTS
     void MetadataIOCoordinator::writeMetadataExiv2(const QVector<Models::ArtworkMetadata *> &artworksToWrite) {
-        WritingOrchestrator *writingOrchestrator = new WritingOrchestrator(artworksToWrite);
+        Models::SettingsModel *settingsModel = m_CommandManager->getSettingsModel();
+        WritingOrchestrator *writingOrchestrator = new WritingOrchestrator(artworksToWrite,
+                                                                           m_Exiv2MetadataCache,
+                                                                           settingsModel->getMaxMetadataThreads());
 
         QObject::connect(writingOrchestrator, SIGNAL(allFinished(bool)), this, SLOT(writingWorkerFinished(bool)));
+        QObject::connect(writingOrchestrator, SIGNAL(progressChanged(int)), this, SLOT(writingProgressChanged(int)));
         QObject::connect(this, SIGNAL(metadataWritingFinished()), writingOrchestrator, SLOT(dismiss()));
 
+        setProcessingItemsCount(artworksToWrite.length());
+        setProcessedItemsCount(0);
+
         m_WritingWorker = writingOrchestrator;
 
         writingOrchestrator->startWriting();
@@ -203,8 +290,49 @@ namespace MetadataIO {
                                                                existingExiftoolPath));
     }
 
+    void MetadataIOCoordinator::stopExiftool() {
+        LOG_DEBUG << "#";
+        waitReadCacheSaved();
+
+        if (m_ExiftoolProcess == NULL) { return; }
+
+        ExiftoolProcess *exiftoolProcess = m_ExiftoolProcess;
+        QThread *exiftoolThread = m_ExiftoolThread;
+        m_ExiftoolProcess = NULL;
+        m_ExiftoolThread = NULL;
+
+        // stop is queued after the worker which might be running now
+        QMetaObject::invokeMethod(exiftoolProcess, "stop", Qt::QueuedConnection);
+
+        if (!exiftoolThread->wait(EXIFTOOL_THREAD_STOP_TIMEOUT)) {
+            LOG_WARNING << "Exiftool thread is busy";
+            exiftoolProcess->killProcess();
+
+            if (!exiftoolThread->wait(EXIFTOOL_THREAD_STOP_TIMEOUT)) {
+                LOG_WARNING << "Exiftool thread did not stop in time";
+                return;
+            }
+        }
+
+        delete exiftoolProcess;
+        delete exiftoolThread;
+    }
+
+    void MetadataIOCoordinator::saveReadCache() {
+        LOG_DEBUG << "#";
+        waitReadCacheSaved();
+        m_ReadCache.saveToFile();
+    }
+
     void MetadataIOCoordinator::discardReading() {
+        m_UpdateRowsTimer.stop();
+        m_CanProcessResults = false;
+        m_IsImportInProgress = false;
+
         emit discardReadingSignal();
+        // reader is deleted by itself after it is stopped
+        m_ReadingWorker = NULL;
+
         LOG_DEBUG << "Reading results discarded";
     }
 
@@ -217,14 +345,32 @@ namespace MetadataIO {
             readingFinishedHandler(ignoreBackups);
         } else {
             m_IgnoreBackupsAtImport = ignoreBackups;
+            // everything read so far is applied right away and the rest follows in batches
+            readingBatchReady();
         }
     }
 
     void MetadataIOCoordinator::continueWithoutReading() {
         LOG_DEBUG << "Setting technical data";
+        if (m_ReadingWorker == NULL) { return; }
 
-        const QHash<QString, ImportDataResult> &importResult = m_ReadingWorker->getImportResult();
-        const QVector<Models::ArtworkMetadata*> &itemsToRead = m_ReadingWorker->getItemsToRead();
+        QHash<QString, ImportDataResult> importResult;
+        if (!m_IsImportInProgress || m_ReadingWorker->supportsBatches()) {
+            m_ReadingWorker->copyImportResult(importResult);
+        } else {
+            LOG_INFO << "Reading is in progress. Technical data is skipped";
+        }
+
+        const QVector<Models::ArtworkMetadata*> itemsToRead = m_ReadingWorker->getItemsToRead();
+        const bool wasInProgress = m_IsImportInProgress;
+
+        // the rest of files are not needed anymore
+        discardReading();
+
+        if (wasInProgress) {
+            // otherwise previews were generated when reading finished
+            m_CommandManager->generatePreviews(itemsToRead);
+        }
 
         int size = itemsToRead.size();
         for (int i = 0; i < size; ++i) {
@@ -256,67 +402,75 @@ namespace MetadataIO {
     void MetadataIOCoordinator::readingFinishedHandler(bool ignoreBackups) {
         Q_ASSERT(m_CanProcessResults);
         m_CanProcessResults = false;
+        m_UpdateRowsTimer.stop();
 
-        const QHash<QString, ImportDataResult> &importResult = m_ReadingWorker->getImportResult();
         const QVector<Models::ArtworkMetadata*> &itemsToRead = m_ReadingWorker->getItemsToRead();
+        const QVector<QPair<int, int> > &rangesToUpdate = m_ReadingWorker->getRangesToUpdate();
 
         LOG_DEBUG  << "Setting imported metadata...";
-        int size = itemsToRead.size();
-        for (int i = 0; i < size; ++i) {
-            Models::ArtworkMetadata *metadata = itemsToRead.at(i);
-            const QString &filepath = metadata->getFilepath();
-
-            if (importResult.contains(filepath)) {
-                const ImportDataResult &importResultItem = importResult.value(filepath);
-                metadata->initialize(importResultItem.Title,
-                                     importResultItem.Description,
-                                     importResultItem.Keywords);
-
-                Models::ImageArtwork *image = dynamic_cast<Models::ImageArtwork*>(metadata);
-                if (image != NULL) {
-                    image->setImageSize(importResultItem.ImageSize);
-                    image->setDateTimeOriginal(importResultItem.DateTimeOriginal);
-                }
+        if (m_ReadingWorker->supportsBatches()) {
+            // previous batches were already applied while reading
+            applyReadyBatch(ignoreBackups);
+        } else {
+            applyImportResults(itemsToRead, m_ReadingWorker->getImportResult(), ignoreBackups);
+        }
 
-                metadata->setFileSize(importResultItem.FileSize);
-            }
+        if (!getHasErrors()) {
+            m_CommandManager->addToLibrary(itemsToRead);
         }
 
-        afterImportHandler(itemsToRead, ignoreBackups);
+        m_CommandManager->updateArtworks(rangesToUpdate);
 
         emit metadataReadingFinished();
         LOG_DEBUG << "Metadata import finished";
     }
 
-    void MetadataIOCoordinator::afterImportHandler(const QVector<Models::ArtworkMetadata*> &itemsToRead, bool ignoreBackups) {
+    void MetadataIOCoordinator::applyReadyBatch(bool ignoreBackups) {
+        QVector<Models::ArtworkMetadata*> items;
+        QHash<QString, ImportDataResult> importResult;
+        m_ReadingWorker->takeReadyBatch(items, importResult);
+
+        if (!items.isEmpty()) {
+            LOG_DEBUG << "Applying" << items.size() << "results";
+            applyImportResults(items, importResult, ignoreBackups);
+        }
+    }
+
+    void MetadataIOCoordinator::applyImportResults(const QVector<Models::ArtworkMetadata*> &items,
+                                                   const QHash<QString, ImportDataResult> &importResult,
+                                                   bool ignoreBackups) {
         Models::SettingsModel *settingsModel = m_CommandManager->getSettingsModel();
-        const QHash<QString, ImportDataResult> &importResult = m_ReadingWorker->getImportResult();
-        const QVector<QPair<int, int> > &rangesToUpdate = m_ReadingWorker->getRangesToUpdate();
+        const bool restoreBackups = !ignoreBackups && settingsModel->getSaveBackups();
 
-        if (!ignoreBackups && settingsModel->getSaveBackups()) {
-            LOG_DEBUG << "Restoring the backups...";
-            int size = itemsToRead.size();
-            for (int i = 0; i < size; ++i) {
-                Models::ArtworkMetadata *metadata = itemsToRead.at(i);
-                const QString &filepath = metadata->getFilepath();
-
-                if (importResult.contains(filepath)) {
-                    const ImportDataResult &importResultItem = importResult.value(filepath);
-                    MetadataSavingCopy copy(importResultItem.BackupDict);
-                    copy.saveToMetadata(metadata);
-                }
+        int size = items.size();
+        for (int i = 0; i < size; ++i) {
+            Models::ArtworkMetadata *metadata = items.at(i);
+            const QString &filepath = metadata->getFilepath();
+
+            auto it = importResult.constFind(filepath);
+            if (it == importResult.constEnd()) { continue; }
+
+            const ImportDataResult &importResultItem = it.value();
+            metadata->initialize(importResultItem.Title,
+                                 importResultItem.Description,
+                                 importResultItem.Keywords);
+
+            Models::ImageArtwork *image = dynamic_cast<Models::ImageArtwork*>(metadata);
+            if (image != NULL) {
+                image->setImageSize(importResultItem.ImageSize);
+                image->setDateTimeOriginal(importResultItem.DateTimeOriginal);
             }
-        } else {
-            LOG_DEBUG << "Skipped restoring the backups";
-        }
 
-        if (!getHasErrors()) {
-            m_CommandManager->addToLibrary(itemsToRead);
+            metadata->setFileSize(importResultItem.FileSize);
+
+            if (restoreBackups) {
+                MetadataSavingCopy copy(importResultItem.BackupDict);
+                copy.saveToMetadata(metadata);
+            }
         }
 
-        m_CommandManager->updateArtworks(rangesToUpdate);
-        m_CommandManager->submitForSpellCheck(itemsToRead);
-        m_CommandManager->submitForWarningsCheck(itemsToRead);
+        m_CommandManager->submitForSpellCheck(items);
+        m_CommandManager->submitForWarningsCheck(items);
     }
 
     void MetadataIOCoordinator::tryToLaunchExiftool(const QString &settingsExiftoolPath) {
@@ -352,5 +506,63 @@ namespace MetadataIO {
         setExiftoolNotFound(exiftoolPath.isEmpty());
         m_RecommendedExiftoolPath = exiftoolPath;
     }
+
+    void MetadataIOCoordinator::ensureExiftoolThreadStarted() {
+        if (m_ExiftoolProcess != NULL) { return; }
+
+        LOG_DEBUG << "Starting exiftool thread...";
+
+        // one exiftool process stays alive between reading and writing
+        // and all exiftool workers are serialized in its thread
+        m_ExiftoolThread = new QThread();
+        m_ExiftoolProcess = new ExiftoolProcess();
+        m_ExiftoolProcess->moveToThread(m_ExiftoolThread);
+
+        // main thread is waiting for the exiftool thread in stopExiftool()
+        // so quit() can not be queued to it; both are deleted after the wait
+        QObject::connect(m_ExiftoolProcess, SIGNAL(stopped()), m_ExiftoolThread, SLOT(quit()), Qt::DirectConnection);
+
+        m_ExiftoolThread->start();
+    }
+
+    void MetadataIOCoordinator::removeBackups(const QVector<Models::ArtworkMetadata *> &writtenArtworks) const {
+        BackupJournal *backupJournal = getBackupJournal();
+        if (backupJournal == NULL) { return; }
+
+        // metadata in the file is up to date so backups are stale now
+        QStringList filepaths;
+        filepaths.reserve(writtenArtworks.size());
+
+        foreach (Models::ArtworkMetadata *metadata, writtenArtworks) {
+            filepaths.append(metadata->getFilepath());
+        }
+
+        backupJournal->removeBackups(filepaths);
+    }
+
+    BackupJournal *MetadataIOCoordinator::getBackupJournal() const {
+        BackupJournal *backupJournal = NULL;
+
+        BackupSaverService *backupSaverService = m_CommandManager->getBackupSaverService();
+        if (backupSaverService != NULL) {
+            backupJournal = backupSaverService->getBackupJournal();
+        }
+
+        return backupJournal;
+    }
+
+    void MetadataIOCoordinator::startInExiftoolThread(QObject *worker) {
+        Q_ASSERT(m_ExiftoolThread != NULL);
+        worker->moveToThread(m_ExiftoolThread);
+        QMetaObject::invokeMethod(worker, "process", Qt::QueuedConnection);
+    }
+
+    void MetadataIOCoordinator::waitReadCacheSaved() {
+        if (m_ReadCacheSaveFuture.isRunning()) {
+            LOG_DEBUG << "Waiting for metadata cache to be saved";
+        }
+
+        m_ReadCacheSaveFuture.waitForFinished();
+    }
 }
 
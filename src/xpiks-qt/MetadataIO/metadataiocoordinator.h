@@ -25,6 +25,12 @@
 #include <QObject>
 #include <QVector>
 #include <QFutureWatcher>
+#include <QFuture>
+#include <QHash>
+#include <QTimer>
+#include <memory>
+#include "importdataresult.h"
+#include "metadatareadcache.h"
 #include "../Common/baseentity.h"
 #include "../Common/defines.h"
 
@@ -36,27 +42,36 @@ namespace MetadataIO {
     class IMetadataReader;
     class IMetadataWriter;
     class MetadataWritingWorker;
+    class ExiftoolProcess;
+    class Exiv2MetadataCache;
+    class BackupJournal;
 
     class MetadataIOCoordinator : public QObject, public Common::BaseEntity
     {
         Q_OBJECT
         Q_PROPERTY(int processingItemsCount READ getProcessingItemsCount WRITE setProcessingItemsCount NOTIFY processingItemsCountChanged)
+        Q_PROPERTY(int processedItemsCount READ getProcessedItemsCount WRITE setProcessedItemsCount NOTIFY processedItemsCountChanged)
         Q_PROPERTY(bool hasErrors READ getHasErrors WRITE setHasErrors NOTIFY hasErrorsChanged)
         Q_PROPERTY(bool exiftoolNotFound READ getExiftoolNotFound WRITE setExiftoolNotFound NOTIFY exiftoolNotFoundChanged)
     public:
         MetadataIOCoordinator();
+        virtual ~MetadataIOCoordinator();
 
     signals:
         void metadataReadingFinished();
         void metadataWritingFinished();
         void processingItemsCountChanged(int value);
+        void processedItemsCountChanged(int value);
         void discardReadingSignal();
         void hasErrorsChanged(bool value);
         void exiftoolNotFoundChanged();
 
     private slots:
         void readingWorkerFinished(bool success);
+        void readingBatchReady();
+        void updateRowsTimerTriggered();
         void writingWorkerFinished(bool success);
+        void writingProgressChanged(int processedCount);
         void exiftoolDiscoveryFinished();
 
     public:
@@ -77,6 +92,14 @@ namespace MetadataIO {
             }
         }
 
+        int getProcessedItemsCount() const { return m_ProcessedItemsCount; }
+        void setProcessedItemsCount(int value) {
+            if (value != m_ProcessedItemsCount) {
+                m_ProcessedItemsCount = value;
+                emit processedItemsCountChanged(value);
+            }
+        }
+
         bool getHasErrors() const { return m_HasErrors; }
         void setHasErrors(bool value) {
             if (value != m_HasErrors) {
@@ -95,6 +118,8 @@ namespace MetadataIO {
         void writeMetadataExiv2(const QVector<Models::ArtworkMetadata*> &artworksToWrite);
 #endif
         void autoDiscoverExiftool();
+        void stopExiftool();
+        void saveReadCache();
         Q_INVOKABLE void discardReading();
         Q_INVOKABLE void continueReading(bool ignoreBackups);
         Q_INVOKABLE void continueWithoutReading();
@@ -102,15 +127,31 @@ namespace MetadataIO {
     private:
         void initializeImport(int itemsCount);
         void readingFinishedHandler(bool ignoreBackups);
-        void afterImportHandler(const QVector<Models::ArtworkMetadata*> &itemsToRead, bool ignoreBackups);
+        void applyReadyBatch(bool ignoreBackups);
+        void applyImportResults(const QVector<Models::ArtworkMetadata*> &items,
+                                const QHash<QString, ImportDataResult> &importResult,
+                                bool ignoreBackups);
         void tryToLaunchExiftool(const QString &settingsExiftoolPath);
+        void ensureExiftoolThreadStarted();
+        void startInExiftoolThread(QObject *worker);
+        void removeBackups(const QVector<Models::ArtworkMetadata*> &writtenArtworks) const;
+        BackupJournal *getBackupJournal() const;
+        void waitReadCacheSaved();
 
     private:
         IMetadataReader *m_ReadingWorker;
         IMetadataWriter *m_WritingWorker;
         QFutureWatcher<void> *m_ExiftoolDiscoveryFuture;
+        QTimer m_UpdateRowsTimer;
+        QThread *m_ExiftoolThread;
+        ExiftoolProcess *m_ExiftoolProcess;
+        std::shared_ptr<Exiv2MetadataCache> m_Exiv2MetadataCache;
+        MetadataReadCache m_ReadCache;
+        // background save started after import
+        QFuture<void> m_ReadCacheSaveFuture;
         QString m_RecommendedExiftoolPath;
         int m_ProcessingItemsCount;
+        int m_ProcessedItemsCount;
         volatile bool m_IsImportInProgress;
         volatile bool m_CanProcessResults;
         volatile bool m_IgnoreBackupsAtImport;
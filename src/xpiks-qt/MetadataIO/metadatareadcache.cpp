@@ -0,0 +1,234 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "metadatareadcache.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <QMutexLocker>
+#include "../Common/defines.h"
+
+namespace MetadataIO {
+    QDataStream &operator<<(QDataStream &out, const CachedImportData &v) {
+        out << v.m_LastModified << v.m_FileSize << v.m_Title << v.m_Description << v.m_Keywords
+            << v.m_ImageSize << v.m_DateTimeOriginal << v.m_AdditionalData;
+        return out;
+    }
+
+    QDataStream &operator>>(QDataStream &in, CachedImportData &v) {
+        in >> v.m_LastModified >> v.m_FileSize >> v.m_Title >> v.m_Description >> v.m_Keywords
+           >> v.m_ImageSize >> v.m_DateTimeOriginal >> v.m_AdditionalData;
+        return in;
+    }
+
+    MetadataReadCache::MetadataReadCache(int maxSize):
+        m_MaxSize(maxSize),
+        m_IsLoaded(false),
+        m_IsModified(0)
+    {
+        Q_ASSERT(maxSize > 0);
+    }
+
+    void MetadataReadCache::ensureLoaded() {
+        QWriteLocker locker(&m_CacheLock);
+        Q_UNUSED(locker);
+
+        if (m_IsLoaded) { return; }
+        m_IsLoaded = true;
+
+        if (m_CacheFilepath.isEmpty()) { return; }
+
+        QFile file(m_CacheFilepath);
+        if (file.open(QIODevice::ReadOnly)) {
+            QHash<QString, CachedImportData> cache;
+
+            QDataStream in(&file);   // read the data
+            in >> cache;
+            file.close();
+
+            if (in.status() == QDataStream::Ok) {
+                m_Cache.swap(cache);
+                LOG_INFO << "Metadata cache read:" << m_Cache.size() << "entries";
+            } else {
+                LOG_WARNING << "Metadata cache is corrupted:" << m_CacheFilepath;
+            }
+        } else {
+            LOG_WARNING << "File not found:" << m_CacheFilepath;
+        }
+    }
+
+    void MetadataReadCache::saveToFile() {
+        LOG_DEBUG << "#";
+
+        if (m_CacheFilepath.isEmpty()) { return; }
+
+        QMutexLocker saveLocker(&m_SaveMutex);
+        Q_UNUSED(saveLocker);
+
+        if (!m_IsModified.testAndSetOrdered(1, 0)) { return; }
+
+        prune();
+
+        QHash<QString, CachedImportData> cacheCopy;
+
+        m_CacheLock.lockForRead();
+        {
+            // implicitly shared copy so readers are not blocked while writing to disk
+            cacheCopy = m_Cache;
+        }
+        m_CacheLock.unlock();
+
+        QSaveFile file(m_CacheFilepath);
+        bool success = false;
+
+        if (file.open(QIODevice::WriteOnly)) {
+            QDataStream out(&file);   // write the data
+            out << cacheCopy;
+
+            success = file.commit();
+        }
+
+        if (success) {
+            LOG_INFO << "Metadata cache saved:" << cacheCopy.size() << "entries";
+        } else {
+            LOG_WARNING << "Failed to save metadata cache to" << m_CacheFilepath;
+            m_IsModified.storeRelease(1);
+        }
+    }
+
+    bool MetadataReadCache::tryGet(const QString &filepath, const QDateTime &lastModified, qint64 fileSize, ImportDataResult &result) {
+        QReadLocker locker(&m_CacheLock);
+        Q_UNUSED(locker);
+
+        auto it = m_Cache.constFind(filepath);
+        if (it == m_Cache.constEnd()) { return false; }
+
+        const CachedImportData &cached = it.value();
+        if ((cached.m_FileSize != fileSize) || (cached.m_LastModified != lastModified)) {
+            return false;
+        }
+
+        markUsed(filepath);
+
+        result.FilePath = filepath;
+        result.Title = cached.m_Title;
+        result.Description = cached.m_Description;
+        result.Keywords = cached.m_Keywords;
+        result.ImageSize = cached.m_ImageSize;
+        result.FileSize = cached.m_FileSize;
+        result.DateTimeOriginal = cached.m_DateTimeOriginal;
+
+        return true;
+    }
+
+    void MetadataReadCache::put(const QString &filepath, const QDateTime &lastModified, const ImportDataResult &result) {
+        CachedImportData cached;
+        cached.m_LastModified = lastModified;
+        cached.m_FileSize = result.FileSize;
+        cached.m_Title = result.Title;
+        cached.m_Description = result.Description;
+        cached.m_Keywords = result.Keywords;
+        cached.m_ImageSize = result.ImageSize;
+        cached.m_DateTimeOriginal = result.DateTimeOriginal;
+
+        markUsed(filepath);
+
+        QWriteLocker locker(&m_CacheLock);
+        Q_UNUSED(locker);
+
+        m_Cache.insert(filepath, cached);
+        m_IsModified.storeRelease(1);
+    }
+
+    int MetadataReadCache::size() {
+        QReadLocker locker(&m_CacheLock);
+        Q_UNUSED(locker);
+        return m_Cache.size();
+    }
+
+    void MetadataReadCache::markUsed(const QString &filepath) {
+        QMutexLocker locker(&m_UsedPathsMutex);
+        m_UsedPaths.insert(filepath);
+    }
+
+    void MetadataReadCache::prune() {
+        QStringList candidates;
+
+        m_CacheLock.lockForRead();
+        {
+            if (m_Cache.size() > m_MaxSize) {
+                QMutexLocker usedLocker(&m_UsedPathsMutex);
+                Q_UNUSED(usedLocker);
+
+                candidates.reserve(qMax(0, m_Cache.size() - m_UsedPaths.size()));
+                for (auto it = m_Cache.constBegin(), end = m_Cache.constEnd(); it != end; ++it) {
+                    if (!m_UsedPaths.contains(it.key())) {
+                        candidates.append(it.key());
+                    }
+                }
+            }
+        }
+        m_CacheLock.unlock();
+
+        if (candidates.isEmpty()) { return; }
+
+        // files which were removed or moved go first
+        QStringList missingPaths, existingPaths;
+        for (auto &filepath: candidates) {
+            if (QFileInfo::exists(filepath)) {
+                existingPaths.append(filepath);
+            } else {
+                missingPaths.append(filepath);
+            }
+        }
+
+        QWriteLocker locker(&m_CacheLock);
+        Q_UNUSED(locker);
+
+        // paths could be used again while files were checked
+        QSet<QString> usedPaths;
+        m_UsedPathsMutex.lock();
+        {
+            usedPaths = m_UsedPaths;
+        }
+        m_UsedPathsMutex.unlock();
+
+        const int sizeBefore = m_Cache.size();
+
+        for (auto &filepath: missingPaths) {
+            if (!usedPaths.contains(filepath)) {
+                m_Cache.remove(filepath);
+            }
+        }
+
+        const int existingCount = existingPaths.size();
+        for (int i = 0; (i < existingCount) && (m_Cache.size() > m_MaxSize); ++i) {
+            const QString &filepath = existingPaths.at(i);
+            if (!usedPaths.contains(filepath)) {
+                m_Cache.remove(filepath);
+            }
+        }
+
+        LOG_INFO << "Pruned" << (sizeBefore - m_Cache.size()) << "entries";
+    }
+}
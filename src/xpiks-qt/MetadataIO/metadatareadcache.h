@@ -0,0 +1,92 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef METADATAREADCACHE_H
+#define METADATAREADCACHE_H
+
+#include <QHash>
+#include <QString>
+#include <QDateTime>
+#include <QDataStream>
+#include <QReadWriteLock>
+#include <QMutex>
+#include <QSet>
+#include <QAtomicInt>
+#include "importdataresult.h"
+
+#define DEFAULT_READ_CACHE_SIZE 50000
+
+namespace MetadataIO {
+    struct CachedImportData {
+        QDateTime m_LastModified;
+        qint64 m_FileSize;
+        QString m_Title;
+        QString m_Description;
+        QStringList m_Keywords;
+        QSize m_ImageSize;
+        QDateTime m_DateTimeOriginal;
+        // reserved for future demands
+        QHash<qint32, QByteArray> m_AdditionalData;
+    };
+
+    QDataStream &operator<<(QDataStream &out, const CachedImportData &v);
+    QDataStream &operator>>(QDataStream &in, CachedImportData &v);
+
+    // results of reading metadata from disk are kept between sessions
+    // and are valid as long as file size and modification time are the same
+    // when cache grows over the limit, entries not used in this session are pruned on save
+    class MetadataReadCache
+    {
+    public:
+        MetadataReadCache(int maxSize=DEFAULT_READ_CACHE_SIZE);
+
+    public:
+        void setCachePath(const QString &filepath) { m_CacheFilepath = filepath; }
+        void ensureLoaded();
+        // can be called from any thread, saves are serialized
+        void saveToFile();
+
+    public:
+        // backups are not cached since they are stored in separate files
+        bool tryGet(const QString &filepath, const QDateTime &lastModified, qint64 fileSize, ImportDataResult &result);
+        void put(const QString &filepath, const QDateTime &lastModified, const ImportDataResult &result);
+        int size();
+
+    private:
+        void markUsed(const QString &filepath);
+        // files are checked on disk without holding the cache lock
+        void prune();
+
+    private:
+        QReadWriteLock m_CacheLock;
+        QHash<QString, CachedImportData> m_Cache;
+        QMutex m_UsedPathsMutex;
+        QSet<QString> m_UsedPaths;
+        QMutex m_SaveMutex;
+        QString m_CacheFilepath;
+        int m_MaxSize;
+        // guarded by m_CacheLock
+        bool m_IsLoaded;
+        QAtomicInt m_IsModified;
+    };
+}
+
+#endif // METADATAREADCACHE_H
@@ -25,21 +25,19 @@
 #include <QJsonArray>
 #include <QFile>
 #include <QDir>
-#include <QTemporaryFile>
 #include <QImageReader>
 #include "../Models/settingsmodel.h"
 #include "../Models/artworkmetadata.h"
 #include "../Helpers/constants.h"
 #include "saverworkerjobitem.h"
+#include "exiftoolprocess.h"
+#include "exiftooljsonparser.h"
+#include "metadatareadcache.h"
 #include "../Common/defines.h"
 
-#ifdef Q_OS_WIN
-#define _X86_
-#include <fileapi.h>
-#include <io.h>
-#else
-#include <unistd.h>
-#endif
+// number of files per one command to exiftool
+#define EXIFTOOL_READING_BATCH_SIZE 50
+#define EXIFTOOL_ONE_FILE_TIMEOUT 5000
 
 #define SOURCEFILE QLatin1String("SourceFile")
 #define TITLE QLatin1String("Title")
@@ -146,12 +144,19 @@ namespace MetadataIO {
 
     MetadataReadingWorker::MetadataReadingWorker(const QVector<Models::ArtworkMetadata *> &itemsToRead,
                                                  Models::SettingsModel *settingsModel,
-                                                 const QVector<QPair<int, int> > &rangesToUpdate):
+                                                 const QVector<QPair<int, int> > &rangesToUpdate,
+                                                 ExiftoolProcess *exiftoolProcess,
+                                                 MetadataReadCache *readCache,
+                                                 BackupJournal *backupJournal):
         m_ItemsToRead(itemsToRead),
-        m_ExiftoolProcess(NULL),
+        m_ExiftoolProcess(exiftoolProcess),
+        m_ReadCache(readCache),
+        m_BackupJournal(backupJournal),
         m_RangesToUpdate(rangesToUpdate),
-        m_SettingsModel(settingsModel)
+        m_SettingsModel(settingsModel),
+        m_Cancelled(false)
     {
+        Q_ASSERT(exiftoolProcess != NULL);
     }
 
     MetadataReadingWorker::~MetadataReadingWorker() {
@@ -159,77 +164,65 @@ namespace MetadataIO {
     }
 
     void MetadataReadingWorker::process() {
-        bool success = false;
-        initWorker();
+        QVector<Models::ArtworkMetadata *> itemsToReadFromDisk;
+        takeCachedResults(itemsToReadFromDisk);
 
-        QTemporaryFile argumentsFile;
+        bool success = true;
 
-        if (argumentsFile.open()) {
-            LOG_INFO << "Created arguments file" << argumentsFile.fileName();
+        if (!itemsToReadFromDisk.isEmpty()) {
+            QString exiftoolPath = m_SettingsModel->getExifToolPath();
+            success = m_ExiftoolProcess->ensureStarted(exiftoolPath);
+        }
 
-            QStringList exiftoolArguments = createArgumentsList();
-            foreach (const QString &line, exiftoolArguments) {
-                argumentsFile.write(line.toUtf8());
-#ifdef Q_OS_WIN
-                argumentsFile.write("\r\n");
-#else
-                argumentsFile.write("\n");
-#endif
-            }
+        if (success && !itemsToReadFromDisk.isEmpty()) {
+            const QStringList commonArguments = createArgumentsList();
+            const int size = itemsToReadFromDisk.size();
 
-            argumentsFile.flush();
+            ExiftoolJsonParser parser([this](const QJsonObject &fileObject) {
+                addImportResult(fileObject);
+            });
 
-            LOG_DEBUG << "Waiting for tempfile bytes written...";
-#ifdef Q_OS_WIN
-            HANDLE fileHandle = (HANDLE)_get_osfhandle(argumentsFile.handle());
-            bool flushResult = FlushFileBuffers(fileHandle);
-            LOG_DEBUG << "Windows flush result:" << flushResult;
-#else
-            int fsyncResult = fsync(argumentsFile.handle());
-            LOG_DEBUG << "fsync result:" << fsyncResult;
-#endif
-            argumentsFile.close();
-
-            QString exiftoolPath = m_SettingsModel->getExifToolPath();
-            QStringList arguments;
-#ifdef Q_OS_WIN
-            arguments << "-charset" << "FileName=UTF8";
-
-            /*
-            QString exiftoolCommand = QString("\"\"%1\" -charset filename=UTF8 -@ \"%2\"\"").arg(exiftoolPath).arg(tempFilename);
-            LOG_DEBUG << "Windows command is:" << exiftoolCommand;
-            m_ExiftoolProcess->setTextModeEnabled(false);
-            m_ExiftoolProcess->setProgram("cmd.exe");
-            m_ExiftoolProcess->setArguments(QStringList() << "/U" << "/c");
-            m_ExiftoolProcess->setNativeArguments(exiftoolCommand);
-            m_ExiftoolProcess->start();
-            */
-#endif
-            arguments << "-@" << argumentsFile.fileName();
-            LOG_INFO << "Starting exiftool process:" << exiftoolPath;
-            m_ExiftoolProcess->start(exiftoolPath, arguments);
+            for (int i = 0; i < size; i += EXIFTOOL_READING_BATCH_SIZE) {
+                if (m_Cancelled) {
+                    LOG_INFO << "Cancelled after" << i << "items";
+                    success = false;
+                    break;
+                }
 
-            success = m_ExiftoolProcess->waitForFinished();
-            LOG_DEBUG << "Exiftool process finished.";
+                const int batchEnd = qMin(size, i + EXIFTOOL_READING_BATCH_SIZE);
+                QStringList arguments = commonArguments;
+                for (int j = i; j < batchEnd; ++j) {
+                    arguments << itemsToReadFromDisk.at(j)->getFilepath();
+                }
 
-            int exitCode = m_ExiftoolProcess->exitCode();
-            QProcess::ExitStatus exitStatus = m_ExiftoolProcess->exitStatus();
+                bool anyError = false;
+                const int timeout = EXIFTOOL_ONE_FILE_TIMEOUT * (batchEnd - i);
+
+                parser.reset();
+                bool executed = m_ExiftoolProcess->execute(arguments, timeout,
+                                                           [&parser](const QByteArray &chunk) { parser.feed(chunk); },
+                                                           anyError);
+                if (!executed) {
+                    LOG_WARNING << "Exiftool failed to read files" << i << "-" << batchEnd;
+                    success = false;
+                    break;
+                }
 
-            success = success &&
-                    (exitCode == 0) &&
-                    (exitStatus == QProcess::NormalExit);
+                if (parser.getErrorsCount() > 0) {
+                    LOG_WARNING << parser.getErrorsCount() << "objects failed to parse in files" << i << "-" << batchEnd;
+                    anyError = true;
+                }
 
-            LOG_INFO << "Exiftool exitcode =" << exitCode << "exitstatus =" << exitStatus;
-            LOG_DEBUG << "Temporary file:" << argumentsFile.fileName();
+                success = success && !anyError;
+            }
 
-            QByteArray stdoutByteArray = m_ExiftoolProcess->readAllStandardOutput();
-            parseExiftoolOutput(stdoutByteArray);
+            LOG_INFO << "Exiftool reading finished. Success:" << success;
+        }
 
-            if (m_SettingsModel->getSaveBackups()) {
-                readBackupsAndSizes(success);
-            } else {
-                readSizes();
-            }
+        if (m_SettingsModel->getSaveBackups()) {
+            readBackupsAndSizes(success);
+        } else {
+            readSizes();
         }
 
         emit finished(success);
@@ -237,77 +230,34 @@ namespace MetadataIO {
 
     void MetadataReadingWorker::cancel() {
         LOG_INFO << "Cancelling...";
-
-        if (m_ExiftoolProcess && m_ExiftoolProcess->state() != QProcess::NotRunning) {
-            m_ExiftoolProcess->kill();
-            LOG_INFO << "Exiftool process killed";
-        }
-    }
-
-    void MetadataReadingWorker::innerProcessFinished(int exitCode, QProcess::ExitStatus exitStatus) {
-        Q_UNUSED(exitStatus);
-        LOG_DEBUG << "Exiftool finished with exitcode" << exitCode;
-
-        QByteArray stderrByteArray = m_ExiftoolProcess->readAllStandardError();
-        QString stderrText = QString::fromUtf8(stderrByteArray);
-        LOG_DEBUG << "STDERR [Exiftool]:" << stderrText;
-    }
-
-    void MetadataReadingWorker::initWorker() {
-        m_ExiftoolProcess = new QProcess(this);
-
-        QObject::connect(m_ExiftoolProcess, SIGNAL(finished(int,QProcess::ExitStatus)),
-                         this, SLOT(innerProcessFinished(int,QProcess::ExitStatus)));
+        m_Cancelled = true;
     }
 
     QStringList MetadataReadingWorker::createArgumentsList() {
         QStringList arguments;
-        arguments.reserve(m_ItemsToRead.length() + 10);
+        arguments.reserve(EXIFTOOL_READING_BATCH_SIZE + 20);
 
-        /*
-         * Related to the hack in windows for UTF8-encoded paths
 #ifdef Q_OS_WIN
         arguments << "-charset" << "FileName=UTF8";
 #endif
-*/
         arguments << "-json" << "-ignoreMinorErrors" << "-e";
         arguments << "-ObjectName" << "-Title";
         arguments << "-ImageDescription" << "-Description" << "-Caption-Abstract";
         arguments << "-Keywords" << "-Subject";
         arguments << "-DateTimeOriginal" << "-TimeZoneOffset";
-        int size = m_ItemsToRead.length();
-        for (int i = 0; i < size; ++i) {
-            Models::ArtworkMetadata *metadata = m_ItemsToRead.at(i);
-            arguments << metadata->getFilepath();
-        }
 
         return arguments;
     }
 
-    void MetadataReadingWorker::parseExiftoolOutput(const QByteArray &output) {
-        LOG_DEBUG << "Parsing JSON output of exiftool...";
-        QJsonDocument document = QJsonDocument::fromJson(output);
-        if (document.isArray()) {
-            QJsonArray filesArray = document.array();
-
-            int size = filesArray.size();
-            for (int i = 0; i < size; ++i) {
-                const QJsonValue &fileJson = filesArray.at(i);
-                if (fileJson.isObject()) {
-                    QJsonObject fileObject = fileJson.toObject();
-                    ImportDataResult result;
-                    jsonObjectToImportResult(fileObject, result);
-
-                    Q_ASSERT(!result.FilePath.isEmpty());
-                    Q_ASSERT(!m_ImportResult.contains(result.FilePath));
-
-                    m_ImportResult.insert(result.FilePath, result);
-                    LOG_DEBUG << "Parsed file:" << result.FilePath;
-                }
-            }
-        } else {
-            LOG_WARNING << "Exiftool Output Parsing Error";
-        }
+    void MetadataReadingWorker::addImportResult(const QJsonObject &fileObject) {
+        ImportDataResult result;
+        jsonObjectToImportResult(fileObject, result);
+
+        Q_ASSERT(!result.FilePath.isEmpty());
+        Q_ASSERT(!m_ImportResult.contains(result.FilePath));
+
+        m_ImportResult.insert(result.FilePath, result);
+        LOG_DEBUG << "Parsed file:" << result.FilePath;
     }
 
     void MetadataReadingWorker::readBackupsAndSizes(bool exiftoolSuccess) {
@@ -318,21 +268,12 @@ namespace MetadataIO {
             const QString &filepath = metadata->getFilepath();
 
             MetadataSavingCopy copy;
-            if (copy.readFromFile(filepath)) {
-                if (exiftoolSuccess) {
-                    Q_ASSERT(m_ImportResult.contains(filepath));
-                }
-
+            if (copy.readFromJournal(m_BackupJournal, filepath)) {
                 m_ImportResult[filepath].BackupDict = copy.getInfo();
             }
 
             ImportDataResult &importResultItem = m_ImportResult[filepath];
-
-            QImageReader reader(filepath);
-            importResultItem.ImageSize = reader.size();
-
-            QFileInfo fi(filepath);
-            importResultItem.FileSize = fi.size();
+            readSizesAndCache(filepath, importResultItem);
         }
     }
 
@@ -343,14 +284,57 @@ namespace MetadataIO {
             Models::ArtworkMetadata *metadata = m_ItemsToRead.at(i);
             const QString &filepath = metadata->getFilepath();
 
-            Q_ASSERT(m_ImportResult.contains(filepath));
+            // exiftool skips files it failed to read
+            if (!m_ImportResult.contains(filepath)) {
+                LOG_WARNING << "Exiftool did not return metadata for" << filepath;
+            }
+
+            // empty result is not cached
             ImportDataResult &importResultItem = m_ImportResult[filepath];
+            readSizesAndCache(filepath, importResultItem);
+        }
+    }
+
+    void MetadataReadingWorker::takeCachedResults(QVector<Models::ArtworkMetadata *> &itemsToReadFromDisk) {
+        if (m_ReadCache == NULL) {
+            itemsToReadFromDisk = m_ItemsToRead;
+            return;
+        }
+
+        int size = m_ItemsToRead.size();
+        itemsToReadFromDisk.reserve(size);
 
-            QImageReader reader(filepath);
-            importResultItem.ImageSize = reader.size();
+        for (int i = 0; i < size; ++i) {
+            Models::ArtworkMetadata *metadata = m_ItemsToRead.at(i);
+            const QString &filepath = metadata->getFilepath();
 
             QFileInfo fi(filepath);
-            importResultItem.FileSize = fi.size();
+            ImportDataResult result;
+
+            if (m_ReadCache->tryGet(filepath, fi.lastModified(), fi.size(), result)) {
+                m_ImportResult.insert(filepath, result);
+                m_CachedPaths.insert(filepath);
+            } else {
+                itemsToReadFromDisk.append(metadata);
+            }
+        }
+
+        LOG_INFO << m_CachedPaths.size() << "items found in cache," << itemsToReadFromDisk.size() << "to read";
+    }
+
+    void MetadataReadingWorker::readSizesAndCache(const QString &filepath, ImportDataResult &importResultItem) {
+        // sizes of cached items are already known
+        if (m_CachedPaths.contains(filepath)) { return; }
+
+        QImageReader reader(filepath);
+        importResultItem.ImageSize = reader.size();
+
+        QFileInfo fi(filepath);
+        importResultItem.FileSize = fi.size();
+
+        // only items successfully parsed from exiftool output have path set
+        if ((m_ReadCache != NULL) && !importResultItem.FilePath.isEmpty()) {
+            m_ReadCache->put(filepath, fi.lastModified(), importResultItem);
         }
     }
 }
@@ -26,11 +26,12 @@
 #include <QVector>
 #include <QHash>
 #include <QString>
-#include <QProcess>
 #include <QStringList>
 #include <QByteArray>
 #include <QHash>
 #include <QSize>
+#include <QSet>
+#include <QJsonObject>
 #include "importdataresult.h"
 #include "imetadatareader.h"
 
@@ -41,13 +42,18 @@ namespace Models {
 
 namespace MetadataIO {
     class BackupSaverService;
+    class ExiftoolProcess;
+    class MetadataReadCache;
+    class BackupJournal;
 
     class MetadataReadingWorker : public QObject, public IMetadataReader
     {
         Q_OBJECT
     public:
         explicit MetadataReadingWorker(const QVector<Models::ArtworkMetadata *> &itemsToRead,
-                                       Models::SettingsModel *settingsModel, const QVector<QPair<int, int> > &rangesToUpdate);
+                                       Models::SettingsModel *settingsModel, const QVector<QPair<int, int> > &rangesToUpdate,
+                                       ExiftoolProcess *exiftoolProcess, MetadataReadCache *readCache,
+                                       BackupJournal *backupJournal);
         virtual ~MetadataReadingWorker();
 
     signals:
@@ -58,27 +64,29 @@ namespace MetadataIO {
         void process();
         void cancel();
 
-    private slots:
-        void innerProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
-
     public:
         virtual const QHash<QString, ImportDataResult> &getImportResult() const override { return m_ImportResult; }
         virtual const QVector<Models::ArtworkMetadata *> &getItemsToRead() const override { return m_ItemsToRead; }
         virtual const QVector<QPair<int, int> > &getRangesToUpdate() const override { return m_RangesToUpdate; }
 
     private:
-        void initWorker();
         QStringList createArgumentsList();
-        void parseExiftoolOutput(const QByteArray &output);
+        void addImportResult(const QJsonObject &fileObject);
         void readBackupsAndSizes(bool exiftoolSuccess);
         void readSizes();
+        void takeCachedResults(QVector<Models::ArtworkMetadata *> &itemsToReadFromDisk);
+        void readSizesAndCache(const QString &filepath, ImportDataResult &importResultItem);
 
     private:
         QVector<Models::ArtworkMetadata *> m_ItemsToRead;
         QHash<QString, ImportDataResult> m_ImportResult;
-        QProcess *m_ExiftoolProcess;
+        ExiftoolProcess *m_ExiftoolProcess;
+        MetadataReadCache *m_ReadCache;
+        BackupJournal *m_BackupJournal;
+        QSet<QString> m_CachedPaths;
         QVector<QPair<int, int> > m_RangesToUpdate;
         Models::SettingsModel *m_SettingsModel;
+        volatile bool m_Cancelled;
     };
 }
 
@@ -31,14 +31,9 @@
 #include "../Models/artworkmetadata.h"
 #include "../Models/settingsmodel.h"
 #include "../Common/defines.h"
+#include "exiftoolprocess.h"
 
-#ifdef Q_OS_WIN
-#define _X86_
-#include <fileapi.h>
-#include <io.h>
-#else
-#include <unistd.h>
-#endif
+#define EXIFTOOL_ONE_FILE_TIMEOUT 5000
 
 #define SOURCEFILE QLatin1String("SourceFile")
 #define XMP_TITLE QLatin1String("XMP:Title")
@@ -93,12 +88,14 @@ namespace MetadataIO {
     }
 
     MetadataWritingWorker::MetadataWritingWorker(const QVector<Models::ArtworkMetadata *> &itemsToWrite,
-                                                 Models::SettingsModel *settingsModel, bool useBackups):
+                                                 Models::SettingsModel *settingsModel, bool useBackups,
+                                                 ExiftoolProcess *exiftoolProcess):
         m_ItemsToWrite(itemsToWrite),
-        m_ExiftoolProcess(NULL),
+        m_ExiftoolProcess(exiftoolProcess),
         m_SettingsModel(settingsModel),
         m_UseBackups(useBackups)
     {
+        Q_ASSERT(exiftoolProcess != NULL);
     }
 
     MetadataWritingWorker::~MetadataWritingWorker() {
@@ -108,8 +105,6 @@ namespace MetadataIO {
     void MetadataWritingWorker::process() {
         bool success = false;
 
-        initWorker();
-
         QTemporaryFile jsonFile;
         if (jsonFile.open()) {
             LOG_INFO << "Serializing artworks to json" << jsonFile.fileName();
@@ -122,94 +117,34 @@ namespace MetadataIO {
 
             int numberOfItems = m_ItemsToWrite.length();
 
-            QTemporaryFile argumentsFile;
-            if (argumentsFile.open()) {
-                QStringList exiftoolArguments = createArgumentsList(jsonFile.fileName());
-
-                foreach (const QString &line, exiftoolArguments) {
-                    argumentsFile.write(line.toUtf8());
-#ifdef Q_OS_WIN
-                    argumentsFile.write("\r\n");
-#else
-                    argumentsFile.write("\n");
-#endif
-                }
-                argumentsFile.flush();
-
-                LOG_DEBUG << "Waiting for tempfile bytes written...";
-    #ifdef Q_OS_WIN
-                HANDLE fileHandle = (HANDLE)_get_osfhandle(argumentsFile.handle());
-                bool flushResult = FlushFileBuffers(fileHandle);
-                LOG_DEBUG << "Windows flush result:" << flushResult;
-    #else
-                int fsyncResult = fsync(argumentsFile.handle());
-                LOG_DEBUG << "fsync result:" << fsyncResult;
-    #endif
-                argumentsFile.close();
-
-                QString exiftoolPath = m_SettingsModel->getExifToolPath();
-                QStringList arguments;
-#ifdef Q_OS_WIN
-                arguments << "-charset" << "FileName=UTF8";
-#endif
-                arguments << "-IPTC:CodedCharacterSet=UTF8" << "-@" << argumentsFile.fileName();
-
-                LOG_DEBUG << "Starting exiftool process:" << exiftoolPath;
-
-                m_ExiftoolProcess->start(exiftoolPath, arguments);
-                const int oneFileTimeout = 5000;
-                success = m_ExiftoolProcess->waitForFinished(oneFileTimeout*numberOfItems);
-
-                LOG_DEBUG << "Exiftool process finished.";
+            QString exiftoolPath = m_SettingsModel->getExifToolPath();
+            if (m_ExiftoolProcess->ensureStarted(exiftoolPath)) {
+                QStringList arguments = createArgumentsList(jsonFile.fileName());
+                QByteArray output;
+                bool anyError = false;
 
-                int exitCode = m_ExiftoolProcess->exitCode();
-                QProcess::ExitStatus exitStatus = m_ExiftoolProcess->exitStatus();
+                LOG_DEBUG << "Sending command to exiftool:" << exiftoolPath;
 
-                success = success &&
-                        (exitCode == 0) &&
-                        (exitStatus == QProcess::NormalExit);
+                success = m_ExiftoolProcess->execute(arguments, EXIFTOOL_ONE_FILE_TIMEOUT*numberOfItems, output, anyError);
+                success = success && !anyError;
 
-                LOG_INFO << "Exiftool exitcode =" << exitCode << "exitstatus =" << exitStatus;
-                LOG_DEBUG << "Temporary file:" << argumentsFile.fileName();
-
-                if (!success) {
-                    LOG_WARNING << "Exiftool error string:" << m_ExiftoolProcess->errorString();
-                }
+                LOG_DEBUG << "STDOUT [ExifTool]:" << QString::fromUtf8(output);
+                LOG_INFO << "Exiftool command finished. Success:" << success;
             }
         }
 
         emit finished(success);
     }
 
-    void MetadataWritingWorker::innerProcessFinished(int exitCode, QProcess::ExitStatus exitStatus) {
-        Q_UNUSED(exitStatus);
-        LOG_DEBUG << "Exiftool finished with exitcode" << exitCode;
-
-        QByteArray stdoutByteArray = m_ExiftoolProcess->readAllStandardOutput();
-        QString stdoutText = QString::fromUtf8(stdoutByteArray);
-        LOG_DEBUG << "STDOUT [ExifTool]:" << stdoutText;
-
-        QByteArray stderrByteArray = m_ExiftoolProcess->readAllStandardError();
-        QString stderrText = QString::fromUtf8(stderrByteArray);
-        LOG_DEBUG << "STDERR [Exiftool]:" << stderrText;
-    }
-
-    void MetadataWritingWorker::initWorker() {
-        m_ExiftoolProcess = new QProcess(this);
-
-        QObject::connect(m_ExiftoolProcess, SIGNAL(finished(int,QProcess::ExitStatus)),
-                         this, SLOT(innerProcessFinished(int,QProcess::ExitStatus)));
-    }
-
     QStringList MetadataWritingWorker::createArgumentsList(const QString &jsonFilePath) {
         QStringList arguments;
         arguments.reserve(m_ItemsToWrite.length() + 5);
 
-//#ifdef Q_OS_WIN
-//        arguments << "-charset" << "FileName=UTF8";
-//#endif
+#ifdef Q_OS_WIN
+        arguments << "-charset" << "FileName=UTF8";
+#endif
         // ignore minor warnings
-        arguments << "-m" << "-j=" + jsonFilePath;
+        arguments << "-IPTC:CodedCharacterSet=UTF8" << "-m" << "-j=" + jsonFilePath;
 
         if (!m_UseBackups) {
             arguments << "-overwrite_original";
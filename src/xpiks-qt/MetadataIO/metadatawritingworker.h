@@ -24,7 +24,7 @@
 
 #include <QObject>
 #include <QVector>
-#include <QProcess>
+#include <QStringList>
 #include "imetadatawriter.h"
 
 namespace Models {
@@ -33,13 +33,16 @@ namespace Models {
 }
 
 namespace MetadataIO {
+    class ExiftoolProcess;
+
     class MetadataWritingWorker : public QObject, public IMetadataWriter
     {
         Q_OBJECT
     public:
         explicit MetadataWritingWorker(const QVector<Models::ArtworkMetadata*> &itemsToWrite,
                                        Models::SettingsModel *settingsModel,
-                                       bool useBackups);
+                                       bool useBackups,
+                                       ExiftoolProcess *exiftoolProcess);
         virtual ~MetadataWritingWorker();
 
     signals:
@@ -53,16 +56,12 @@ namespace MetadataIO {
         void process();
         //void cancel();
 
-    private slots:
-        void innerProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
-
     private:
-        void initWorker();
         QStringList createArgumentsList(const QString &jsonFilePath);
 
     private:
         QVector<Models::ArtworkMetadata*> m_ItemsToWrite;
-        QProcess *m_ExiftoolProcess;
+        ExiftoolProcess *m_ExiftoolProcess;
         Models::SettingsModel *m_SettingsModel;
         bool m_UseBackups;
     };
@@ -22,10 +22,8 @@
 #include "readingorchestrator.h"
 #include <QThread>
 #include <QVector>
-#include <QMutexLocker>
 #include "../Models/artworkmetadata.h"
 #include "../Common/defines.h"
-#include "../Helpers/indiceshelper.h"
 #include "exiv2readingworker.h"
 
 #if defined(TRAVIS_CI)
@@ -38,32 +36,38 @@
 #endif
 #endif
 
-#define MAX_READING_THREADS 10
+#define MAX_READING_THREADS 16
 #define MIN_READING_THREADS 1
 
 namespace MetadataIO {
     ReadingOrchestrator::ReadingOrchestrator(const QVector<Models::ArtworkMetadata *> &itemsToRead,
                                              const QVector<QPair<int, int> > &rangesToUpdate,
+                                             const std::shared_ptr<Exiv2MetadataCache> &metadataCache,
+                                             MetadataReadCache *readCache,
+                                             BackupJournal *backupJournal,
+                                             int maxThreadsCount,
                                              QObject *parent) :
         QObject(parent),
         m_ItemsToRead(itemsToRead),
+        m_WorkQueue(new Common::SharedWorkQueue<Models::ArtworkMetadata *>(itemsToRead)),
         m_RangesToUpdate(rangesToUpdate),
+        m_ResultsCollector(new ImportResultsCollector()),
+        m_MetadataCache(metadataCache),
+        m_ReadCache(readCache),
+        m_BackupJournal(backupJournal),
         m_ThreadsCount(MIN_READING_THREADS),
         m_FinishedCount(0),
-        m_AnyError(false)
+        m_AnyError(false),
+        m_IsDismissed(false)
     {
         int size = itemsToRead.size();
         if (size >= MIN_SPLIT_COUNT) {
-#ifdef QT_DEBUG
-            m_ThreadsCount = size;
-#else
-            int idealThreadCount = qMin(qMax(QThread::idealThreadCount(), MIN_READING_THREADS), MAX_READING_THREADS);
-            m_ThreadsCount = qMin(size, idealThreadCount);
-#endif
+            if (maxThreadsCount <= 0) {
+                maxThreadsCount = QThread::idealThreadCount();
+            }
 
-            m_ThreadsCount = Helpers::splitIntoChunks<Models::ArtworkMetadata*>(itemsToRead, m_ThreadsCount, m_SlicedItemsToRead);
-        } else {
-            m_SlicedItemsToRead.push_back(itemsToRead);
+            int threadsCount = qMin(qMax(maxThreadsCount, MIN_READING_THREADS), MAX_READING_THREADS);
+            m_ThreadsCount = qMin(size, threadsCount);
         }
 
         LOG_INFO << "Using" << m_ThreadsCount << "threads for" << size << "items to read";
@@ -76,50 +80,57 @@ namespace MetadataIO {
     void ReadingOrchestrator::startReading() {
         LOG_DEBUG << "#";
 
-        int size = m_SlicedItemsToRead.size();
-        for (int i = 0; i < size; ++i) {
-            const QVector<Models::ArtworkMetadata *> &itemsToRead = m_SlicedItemsToRead.at(i);
-
-            Exiv2ReadingWorker *worker = new Exiv2ReadingWorker(i, itemsToRead);
+        for (int i = 0; i < m_ThreadsCount; ++i) {
+            Exiv2ReadingWorker *worker = new Exiv2ReadingWorker(i, m_WorkQueue, m_ResultsCollector, m_MetadataCache, m_ReadCache, m_BackupJournal);
 
             QThread *thread = new QThread();
             worker->moveToThread(thread);
 
             QObject::connect(thread, SIGNAL(started()), worker, SLOT(process()));
-            QObject::connect(worker, SIGNAL(stopped()), thread, SLOT(quit()));
+            // worker stops itself when the queue is done or cancelled
+            QObject::connect(worker, SIGNAL(stopped()), thread, SLOT(quit()), Qt::DirectConnection);
 
-            QObject::connect(worker, SIGNAL(stopped()), worker, SLOT(deleteLater()));
+            QObject::connect(thread, SIGNAL(finished()), worker, SLOT(deleteLater()));
             QObject::connect(thread, SIGNAL(finished()), thread, SLOT(deleteLater()));
 
             QObject::connect(worker, SIGNAL(finished(bool)), this, SLOT(onWorkerFinished(bool)));
+            QObject::connect(worker, SIGNAL(batchRead()), this, SIGNAL(batchReady()));
 
+            m_Threads.append(QPointer<QThread>(thread));
             thread->start();
 
             LOG_INFO << "Started worker" << i;
         }
 
-        Q_ASSERT(m_SlicedItemsToRead.size() == m_ThreadsCount);
-
         emit allStarted();
     }
 
     void ReadingOrchestrator::dismiss() {
+        if (m_IsDismissed) { return; }
+
+        LOG_DEBUG << "#";
+        m_IsDismissed = true;
+        // late results of cancelled workers should not reach coordinator
+        this->blockSignals(true);
+        m_WorkQueue->cancel();
+
+        // workers finish current item and quit their threads
+        for (auto &thread: m_Threads) {
+            if (!thread.isNull()) {
+                thread->wait();
+            }
+        }
+
+        m_Threads.clear();
         this->deleteLater();
     }
 
     void ReadingOrchestrator::onWorkerFinished(bool anyError) {
-        Exiv2ReadingWorker *worker = qobject_cast<Exiv2ReadingWorker *>(sender());
-        Q_ASSERT(worker != NULL);
+        if (m_IsDismissed) { return; }
 
-        LOG_INTEGR_TESTS_OR_DEBUG << "#" << worker->getWorkerIndex() << "[" << m_FinishedCount << "out of" << m_ThreadsCount << "] anyError:" << anyError;
-
-        {
-            QMutexLocker locker(&m_ImportMutex);
-            m_ImportResult.unite(worker->getImportResult());
-            m_AnyError = m_AnyError || anyError;
-        }
+        LOG_INTEGR_TESTS_OR_DEBUG << "[" << m_FinishedCount << "out of" << m_ThreadsCount << "] anyError:" << anyError;
 
-        worker->dismiss();
+        m_AnyError = m_AnyError || anyError;
 
         if (m_FinishedCount.fetchAndAddOrdered(1) == (m_ThreadsCount - 1)) {
             LOG_DEBUG << "Last worker finished";
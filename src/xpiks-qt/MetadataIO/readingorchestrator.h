@@ -25,28 +25,48 @@
 #include <QObject>
 #include <QVector>
 #include <QAtomicInt>
-#include <QMutex>
+#include <QPointer>
+#include <memory>
 #include "importdataresult.h"
 #include "imetadatareader.h"
+#include "importresultscollector.h"
+#include "../Common/sharedworkqueue.h"
+
+class QThread;
 
 namespace Models {
     class ArtworkMetadata;
 }
 
 namespace MetadataIO {
+    class Exiv2MetadataCache;
+    class MetadataReadCache;
+    class BackupJournal;
+
     class ReadingOrchestrator : public QObject, public IMetadataReader
     {
         Q_OBJECT
     public:
         explicit ReadingOrchestrator(const QVector<Models::ArtworkMetadata *> &itemsToRead,
                                      const QVector<QPair<int, int> > &rangesToUpdate,
+                                     const std::shared_ptr<Exiv2MetadataCache> &metadataCache,
+                                     MetadataReadCache *readCache,
+                                     BackupJournal *backupJournal,
+                                     int maxThreadsCount,
                                      QObject *parent = 0);
         virtual ~ReadingOrchestrator();
 
     public:
-        virtual const QHash<QString, ImportDataResult> &getImportResult() const override { return m_ImportResult; }
+        virtual const QHash<QString, ImportDataResult> &getImportResult() const override { return m_ResultsCollector->getImportResult(); }
         virtual const QVector<Models::ArtworkMetadata *> &getItemsToRead() const override { return m_ItemsToRead; }
         virtual const QVector<QPair<int, int> > &getRangesToUpdate() const override { return m_RangesToUpdate; }
+        virtual bool supportsBatches() const override { return true; }
+        virtual void takeReadyBatch(QVector<Models::ArtworkMetadata *> &items, QHash<QString, ImportDataResult> &results) override {
+            m_ResultsCollector->takeReadyBatch(items, results);
+        }
+        virtual void copyImportResult(QHash<QString, ImportDataResult> &results) override {
+            m_ResultsCollector->copyImportResult(results);
+        }
 
     public:
         void startReading();
@@ -54,8 +74,10 @@ namespace MetadataIO {
     signals:
         void allStarted();
         void allFinished(bool anyError);
+        void batchReady();
 
     public slots:
+        // stops workers and waits for their threads
         void dismiss();
 
     private slots:
@@ -63,13 +85,18 @@ namespace MetadataIO {
 
     private:
         QVector<Models::ArtworkMetadata *> m_ItemsToRead;
-        QVector<QVector<Models::ArtworkMetadata *> > m_SlicedItemsToRead;
+        std::shared_ptr<Common::SharedWorkQueue<Models::ArtworkMetadata *> > m_WorkQueue;
         QVector<QPair<int, int> > m_RangesToUpdate;
-        QMutex m_ImportMutex;
-        QHash<QString, ImportDataResult> m_ImportResult;
+        std::shared_ptr<ImportResultsCollector> m_ResultsCollector;
+        // threads are deleted by themselves when workers are done
+        QVector<QPointer<QThread> > m_Threads;
+        std::shared_ptr<Exiv2MetadataCache> m_MetadataCache;
+        MetadataReadCache *m_ReadCache;
+        BackupJournal *m_BackupJournal;
         volatile int m_ThreadsCount;
         QAtomicInt m_FinishedCount;
         volatile bool m_AnyError;
+        bool m_IsDismissed;
     };
 }
 
@@ -34,6 +34,8 @@ namespace Models {
 }
 
 namespace MetadataIO {
+    class BackupJournal;
+
     class MetadataSavingCopy {
     public:
         MetadataSavingCopy() {}
@@ -43,8 +45,9 @@ namespace MetadataIO {
     public:
         const QHash<QString, QString> &getInfo() const { return m_MetadataInfo; }
 
-        void saveToFile(const QString &filepath) const;
-        bool readFromFile(const QString &filepath);
+        void saveToJournal(BackupJournal *journal, const QString &filepath) const;
+        // .xpks files written by previous versions are moved to journal once per directory
+        bool readFromJournal(BackupJournal *journal, const QString &filepath);
         void saveToMetadata(Models::ArtworkMetadata *artworkMetadata) const;
 
     private:
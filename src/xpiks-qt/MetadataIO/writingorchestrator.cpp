@@ -22,7 +22,6 @@
 #include "writingorchestrator.h"
 #include <QVector>
 #include <QThread>
-#include "../Helpers/indiceshelper.h"
 #include "../Models/artworkmetadata.h"
 #include "../Common/defines.h"
 #include "exiv2writingworker.h"
@@ -37,29 +36,33 @@
 #endif
 #endif
 
-#define MAX_WRITING_THREADS 10
+#define MAX_WRITING_THREADS 16
 #define MIN_WRITING_THREADS 1
 
 namespace MetadataIO {
     WritingOrchestrator::WritingOrchestrator(const QVector<Models::ArtworkMetadata *> &itemsToWrite,
+                                             const std::shared_ptr<Exiv2MetadataCache> &metadataCache,
+                                             int maxThreadsCount,
                                              QObject *parent) :
         QObject(parent),
         m_ItemsToWrite(itemsToWrite),
+        m_WorkQueue(new Common::SharedWorkQueue<Models::ArtworkMetadata *>(itemsToWrite)),
+        m_MetadataCache(metadataCache),
         m_ThreadsCount(MIN_WRITING_THREADS),
         m_FinishedCount(0),
         m_AnyError(false)
     {
         int size = itemsToWrite.size();
         if (size >= MIN_SPLIT_COUNT) {
-            int idealThreadCount = qMin(qMax(QThread::idealThreadCount(), MIN_WRITING_THREADS), MAX_WRITING_THREADS);
-            m_ThreadsCount = qMin(size, idealThreadCount);
+            if (maxThreadsCount <= 0) {
+                maxThreadsCount = QThread::idealThreadCount();
+            }
 
-            m_ThreadsCount = Helpers::splitIntoChunks<Models::ArtworkMetadata*>(itemsToWrite, m_ThreadsCount, m_SlicedItemsToWrite);
-        } else {
-            m_SlicedItemsToWrite.push_back(itemsToWrite);
+            int threadsCount = qMin(qMax(maxThreadsCount, MIN_WRITING_THREADS), MAX_WRITING_THREADS);
+            m_ThreadsCount = qMin(size, threadsCount);
         }
 
-        LOG_INFO << "Using" << m_ThreadsCount << "threads for" << size << "items to read";
+        LOG_INFO << "Using" << m_ThreadsCount << "threads for" << size << "items to write";
     }
 
     WritingOrchestrator::~WritingOrchestrator() {
@@ -69,11 +72,8 @@ namespace MetadataIO {
     void WritingOrchestrator::startWriting() {
         LOG_DEBUG << "#";
 
-        int size = m_SlicedItemsToWrite.size();
-        for (int i = 0; i < size; ++i) {
-            const QVector<Models::ArtworkMetadata *> &itemsToWrite = m_SlicedItemsToWrite.at(i);
-
-            Exiv2WritingWorker *worker = new Exiv2WritingWorker(i, itemsToWrite);
+        for (int i = 0; i < m_ThreadsCount; ++i) {
+            Exiv2WritingWorker *worker = new Exiv2WritingWorker(i, m_WorkQueue, m_MetadataCache);
 
             QThread *thread = new QThread();
             worker->moveToThread(thread);
@@ -85,6 +85,7 @@ namespace MetadataIO {
             QObject::connect(thread, SIGNAL(finished()), thread, SLOT(deleteLater()));
 
             QObject::connect(worker, SIGNAL(finished(bool)), this, SLOT(onWorkerFinished(bool)));
+            QObject::connect(worker, SIGNAL(itemWritten()), this, SLOT(onItemWritten()));
 
             thread->start();
 
@@ -95,6 +96,7 @@ namespace MetadataIO {
     }
 
     void WritingOrchestrator::dismiss() {
+        m_WorkQueue->cancel();
         this->deleteLater();
     }
 
@@ -104,6 +106,7 @@ namespace MetadataIO {
 
         LOG_INFO << "#" << worker->getWorkerIndex() << "anyError:" << anyError;
 
+        m_AnyError = m_AnyError || anyError;
         worker->dismiss();
 
         if (m_FinishedCount.fetchAndAddOrdered(1) == (m_ThreadsCount - 1)) {
@@ -111,4 +114,8 @@ namespace MetadataIO {
             emit allFinished(!m_AnyError);
         }
     }
+
+    void WritingOrchestrator::onItemWritten() {
+        emit progressChanged(m_WorkQueue->getProcessedCount());
+    }
 }
@@ -25,18 +25,25 @@
 #include <QObject>
 #include <QVector>
 #include <QAtomicInt>
+#include <memory>
 #include "imetadatawriter.h"
+#include "../Common/sharedworkqueue.h"
 
 namespace Models {
     class ArtworkMetadata;
 }
 
 namespace MetadataIO {
+    class Exiv2MetadataCache;
+
     class WritingOrchestrator : public QObject, public IMetadataWriter
     {
         Q_OBJECT
     public:
-        explicit WritingOrchestrator(const QVector<Models::ArtworkMetadata*> &itemsToWrite, QObject *parent = 0);
+        explicit WritingOrchestrator(const QVector<Models::ArtworkMetadata*> &itemsToWrite,
+                                     const std::shared_ptr<Exiv2MetadataCache> &metadataCache,
+                                     int maxThreadsCount,
+                                     QObject *parent = 0);
         virtual ~WritingOrchestrator();
 
     public:
@@ -46,16 +53,19 @@ namespace MetadataIO {
     signals:
         void allStarted();
         void allFinished(bool anyError);
+        void progressChanged(int processedCount);
 
     public slots:
         void dismiss();
 
     private slots:
         void onWorkerFinished(bool anyError);
+        void onItemWritten();
 
     private:
         QVector<Models::ArtworkMetadata*> m_ItemsToWrite;
-        QVector<QVector<Models::ArtworkMetadata *> > m_SlicedItemsToWrite;
+        std::shared_ptr<Common::SharedWorkQueue<Models::ArtworkMetadata *> > m_WorkQueue;
+        std::shared_ptr<Exiv2MetadataCache> m_MetadataCache;
         int m_ThreadsCount;
         QAtomicInt m_FinishedCount;
         volatile bool m_AnyError;
@@ -21,7 +21,9 @@
 
 #include <QCoreApplication>
 #include <QStringList>
-#include <QDirIterator>
+#include <QDir>
+#include <QFileInfo>
+#include <QThread>
 #include <QImageReader>
 #include <QList>
 #include <QHash>
@@ -46,30 +48,39 @@
 #include "../Commands/expandpresetcommand.h"
 #include "../Helpers/constants.h"
 #include "../Helpers/stringhelper.h"
+#include "../Helpers/filenameshelpers.h"
+#include "../Helpers/directoryscanner.h"
 #include "../QuickBuffer/quickbuffer.h"
 
 namespace Models {
     ArtItemsModel::ArtItemsModel(QObject *parent):
         AbstractListModel(parent),
         Common::BaseEntity(),
-        m_LastID(0)
-    {}
+        m_DirectoryScanner(NULL),
+        m_ScannerThread(NULL),
+        m_LastID(0),
+        m_UpdatesScheduled(false)
+    {
+    }
 
     ArtItemsModel::~ArtItemsModel() {
+        stopScanningDirectories();
+
         qDeleteAll(m_ArtworkList);
         qDeleteAll(m_FinalizationList);
     }
 
-    ArtworkMetadata *ArtItemsModel::createMetadata(const QString &filepath) {
+    ArtworkMetadata *ArtItemsModel::createMetadata(const QString &filepath, qint64 directoryID) {
         int id = m_LastID++;
 
-        return new ImageArtwork(filepath, id);
+        return new ImageArtwork(filepath, id, directoryID);
     }
 
     void ArtItemsModel::deleteAllItems() {
         LOG_DEBUG << "#";
         // should be called only from beforeDestruction() !
         // will not cause sync issues on shutdown if no items
+        flushPendingUpdates();
         beginResetModel();
         size_t size = m_ArtworkList.size();
         for (size_t i = 0; i < size; ++i) {
@@ -110,7 +121,7 @@ namespace Models {
         QVector<int> sortedIndices(indices);
         qSort(sortedIndices);
         Helpers::indicesToRanges(sortedIndices, rangesToUpdate);
-        AbstractListModel::updateItemsInRanges(rangesToUpdate, roles);
+        scheduleItemsUpdate(rangesToUpdate, roles);
     }
 
     void ArtItemsModel::forceUnselectAllItems() const {
@@ -127,19 +138,18 @@ namespace Models {
 
     void ArtItemsModel::removeArtworksDirectory(int index) {
         LOG_INFO << "Remove artworks directory at" << index;
-        const QString &directory = m_CommandManager->getArtworksRepository()->getDirectory(index);
+        const Models::ArtworksRepository *artworksRepository = m_CommandManager->getArtworksRepository();
+        const QString &directory = artworksRepository->getDirectory(index);
+        const qint64 directoryID = artworksRepository->getDirectoryID(index);
         LOG_CORE_TESTS << "Removing directory:" << directory;
 
-        QDir dir(directory);
-        QString directoryAbsolutePath = dir.absolutePath();
-
         QVector<int> indicesToRemove;
         size_t size = m_ArtworkList.size();
         indicesToRemove.reserve((int)size);
 
         for (size_t i = 0; i < size; ++i) {
             ArtworkMetadata *metadata = m_ArtworkList.at(i);
-            if (metadata->isInDirectory(directoryAbsolutePath)) {
+            if (metadata->getDirectoryID() == directoryID) {
                 indicesToRemove.append((int)i);
             }
         }
@@ -295,7 +305,7 @@ namespace Models {
         }
     }
 
-    int ArtItemsModel::dropFiles(const QList<QUrl> &urls) {
+    void ArtItemsModel::dropFiles(const QList<QUrl> &urls) {
         LOG_INFO << "Dropped" << urls.count() << "items(s)";
         QList<QUrl> directories, files;
         directories.reserve(urls.count()/2);
@@ -318,12 +328,19 @@ namespace Models {
             filesToImport.append(fileUrl.toLocalFile());
         }
 
-        foreach(const QUrl &dirUrl, directories) {
-            doAddDirectory(dirUrl.toLocalFile(), filesToImport);
-        }
+        if (directories.isEmpty()) {
+            addFiles(filesToImport);
+        } else {
+            QStringList directoriesToScan;
+            directoriesToScan.reserve(directories.size());
 
-        int importedCount = addFiles(filesToImport);
-        return importedCount;
+            foreach(const QUrl &dirUrl, directories) {
+                directoriesToScan.append(dirUrl.toLocalFile());
+            }
+
+            // dropped files are added together with the scanned ones
+            startScanningDirectories(directoriesToScan, filesToImport);
+        }
     }
 
     void ArtItemsModel::setSelectedItemsSaved(const QVector<int> &selectedIndices) {
@@ -334,7 +351,7 @@ namespace Models {
 
         QVector<QPair<int, int> > rangesToUpdate;
         Helpers::indicesToRanges(selectedIndices, rangesToUpdate);
-        AbstractListModel::updateItemsInRanges(rangesToUpdate, QVector<int>() << IsModifiedRole);
+        scheduleItemsUpdate(rangesToUpdate, QVector<int>() << IsModifiedRole);
 
         updateModifiedCount();
         emit artworksChanged(false);
@@ -349,7 +366,7 @@ namespace Models {
         Helpers::indicesToRanges(selectedIndices, rangesToUpdate);
         QVector<int> roles;
         fillStandardRoles(roles);
-        AbstractListModel::updateItemsInRanges(rangesToUpdate, roles);
+        scheduleItemsUpdate(rangesToUpdate, roles);
 
         emit artworksChanged(false);
     }
@@ -485,10 +502,9 @@ namespace Models {
         }
     }
 
-    int ArtItemsModel::addRecentDirectory(const QString &directory) {
+    void ArtItemsModel::addRecentDirectory(const QString &directory) {
         LOG_DEBUG << directory;
-        int filesAdded = addDirectories(QStringList() << directory);
-        return filesAdded;
+        addDirectories(QStringList() << directory);
     }
 
     void ArtItemsModel::initDescriptionHighlighting(int metadataIndex, QQuickTextDocument *document) {
@@ -575,7 +591,7 @@ namespace Models {
         if (!indicesToUpdate.isEmpty()) {
             QVector<QPair<int, int> > rangesToUpdate;
             Helpers::indicesToRanges(indicesToUpdate, rangesToUpdate);
-            AbstractListModel::updateItemsInRanges(rangesToUpdate, QVector<int>() << HasVectorAttachedRole);
+            scheduleItemsUpdate(rangesToUpdate, QVector<int>() << HasVectorAttachedRole);
         }
     }
 
@@ -771,7 +787,7 @@ namespace Models {
         return filesAddedCount;
     }
 
-    int ArtItemsModel::addLocalDirectories(const QList<QUrl> &directories) {
+    void ArtItemsModel::addLocalDirectories(const QList<QUrl> &directories) {
         LOG_DEBUG << directories;
         QStringList directoriesList;
         directoriesList.reserve(directories.length());
@@ -784,8 +800,7 @@ namespace Models {
             }
         }
 
-        int addedFilesCount = addDirectories(directoriesList);
-        return addedFilesCount;
+        addDirectories(directoriesList);
     }
 
     void ArtItemsModel::spellCheckErrorsChanged() {
@@ -801,6 +816,7 @@ namespace Models {
     }
 
     void ArtItemsModel::removeItemsAtIndices(const QVector<QPair<int, int> > &ranges) {
+        flushPendingUpdates();
         AbstractListModel::removeItemsAtIndices(ranges);
         emit artworksChanged(true);
     }
@@ -808,10 +824,12 @@ namespace Models {
     void ArtItemsModel::beginAccountingFiles(int filesCount) {
         int rowsCount = rowCount();
 
+        flushPendingUpdates();
         beginInsertRows(QModelIndex(), rowsCount, rowsCount + filesCount - 1);
     }
 
     void ArtItemsModel::beginAccountingFiles(int start, int end) {
+        flushPendingUpdates();
         beginInsertRows(QModelIndex(), start, end);
     }
 
@@ -820,6 +838,7 @@ namespace Models {
     }
 
     void ArtItemsModel::beginAccountingManyFiles() {
+        flushPendingUpdates();
         beginResetModel();
     }
 
@@ -871,7 +890,7 @@ namespace Models {
     void ArtItemsModel::updateItemsInRanges(const QVector<QPair<int, int> > &ranges) {
         QVector<int> roles;
         fillStandardRoles(roles);
-        AbstractListModel::updateItemsInRanges(ranges, roles);
+        scheduleItemsUpdate(ranges, roles);
     }
 
     void ArtItemsModel::setAllItemsSelected(bool selected) {
@@ -884,9 +903,8 @@ namespace Models {
         }
 
         if (length > 0) {
-            QModelIndex startIndex = index(0);
-            QModelIndex endIndex = index((int)length - 1);
-            emit dataChanged(startIndex, endIndex, QVector<int>() << IsSelectedRole);
+            scheduleItemsUpdate(QVector<QPair<int, int> >() << qMakePair(0, (int)length - 1),
+                                QVector<int>() << IsSelectedRole);
         }
     }
 
@@ -950,37 +968,89 @@ namespace Models {
         emit dataChanged(topLeft, bottomRight, roles);
     }
 
-    int ArtItemsModel::addDirectories(const QStringList &directories) {
+    void ArtItemsModel::addDirectories(const QStringList &directories) {
         LOG_INFO << directories;
-        int filesCount = 0;
-        QStringList files;
 
-        foreach(const QString &directory, directories) {
-            doAddDirectory(directory, files);
+        if (!directories.isEmpty()) {
+            startScanningDirectories(directories, QStringList());
         }
+    }
 
-        if (files.count() > 0) {
-            filesCount = addFiles(files);
+    void ArtItemsModel::startScanningDirectories(const QStringList &directories, const QStringList &files) {
+        LOG_DEBUG << directories.size() << "directories";
+
+        if (m_DirectoryScanner != NULL) {
+            LOG_INFO << "Restarting previous scan together with the new one";
+            stopScanningDirectories();
         }
 
-        return filesCount;
+        // unfinished scan is repeated so its files are not lost
+        m_ScanningDirectories.append(directories);
+        m_ScanningFiles.append(files);
+
+        Helpers::DirectoryScanner *scanner = new Helpers::DirectoryScanner(m_ScanningDirectories, m_ScanningFiles, 0);
+
+        QThread *thread = new QThread();
+        scanner->moveToThread(thread);
+
+        QObject::connect(thread, SIGNAL(started()), scanner, SLOT(process()));
+        // scanner thread does not spin event loop until process() returns
+        QObject::connect(scanner, SIGNAL(stopped()), thread, SLOT(quit()), Qt::DirectConnection);
+        QObject::connect(QCoreApplication::instance(), SIGNAL(aboutToQuit()),
+                         scanner, SLOT(cancel()), Qt::DirectConnection);
+
+        QObject::connect(thread, SIGNAL(finished()), this, SLOT(scannerThreadFinished()));
+
+        QObject::connect(scanner, SIGNAL(scanFinished(QStringList)),
+                         this, SLOT(directoriesScanned(QStringList)));
+
+        m_DirectoryScanner = scanner;
+        m_ScannerThread = thread;
+
+        thread->start();
     }
 
-    void ArtItemsModel::doAddDirectory(const QString &directory, QStringList &filesList) {
-        QDir dir(directory);
+    void ArtItemsModel::stopScanningDirectories() {
+        if (m_DirectoryScanner == NULL) { return; }
 
-        dir.setFilter(QDir::NoDotAndDotDot | QDir::Files);
+        LOG_DEBUG << "#";
+        Q_ASSERT(m_ScannerThread != NULL);
+
+        // cancel() is thread-safe and queued call would not be delivered
+        // while the scanner is busy in process()
+        m_DirectoryScanner->cancel();
+        m_ScannerThread->quit();
+        m_ScannerThread->wait();
 
-        QFileInfoList items = dir.entryInfoList();
-        int size = items.size();
-        filesList.reserve(filesList.size() + size);
+        delete m_DirectoryScanner;
+        delete m_ScannerThread;
+        m_DirectoryScanner = NULL;
+        m_ScannerThread = NULL;
+    }
 
-        for (int i = 0; i < size; ++i) {
-            QString filepath = items.at(i).absoluteFilePath();
-            filesList.append(filepath);
+    void ArtItemsModel::directoriesScanned(const QStringList &files) {
+        if (sender() != m_DirectoryScanner) {
+            LOG_DEBUG << "Skipping results of the stopped scan";
+            return;
         }
 
-        LOG_INFO << filesList.length() << "file(s) found";
+        LOG_INFO << files.size() << "file(s) found";
+        m_ScanningDirectories.clear();
+        m_ScanningFiles.clear();
+
+        addFiles(files);
+    }
+
+    void ArtItemsModel::scannerThreadFinished() {
+        if (sender() != m_ScannerThread) { return; }
+
+        LOG_DEBUG << "#";
+        m_ScannerThread->wait();
+
+        delete m_DirectoryScanner;
+        delete m_ScannerThread;
+        m_DirectoryScanner = NULL;
+        m_ScannerThread = NULL;
     }
 
     int ArtItemsModel::addFiles(const QStringList &rawFilenames) {
@@ -993,8 +1063,7 @@ namespace Models {
         knownImageSuffixes << "jpg" << "jpeg" << "tiff";
 
         foreach(const QString &filepath, rawFilenames) {
-            QFileInfo fi(filepath);
-            QString suffix = fi.suffix().toLower();
+            QString suffix = Helpers::getFileSuffix(filepath);
 
             if (knownImageSuffixes.contains(suffix)) {
                 filenames.append(filepath);
@@ -1062,7 +1131,7 @@ namespace Models {
         ArtworkMetadata *metadata = m_ArtworkList.at(row);
         m_ArtworkList.erase(m_ArtworkList.begin() + row);
         ArtworksRepository *artworksRepository = m_CommandManager->getArtworksRepository();
-        artworksRepository->removeFile(metadata->getFilepath(), metadata->getDirectory());
+        artworksRepository->removeFile(metadata->getFilepath(), metadata->getDirectoryID());
 
         ImageArtwork *image = dynamic_cast<ImageArtwork*>(metadata);
         if ((image != nullptr) && image->hasVectorAttached()) {
@@ -1097,7 +1166,7 @@ namespace Models {
         for (; it < itemsEnd; it++) {
             ArtworkMetadata *metadata = *it;
 
-            artworkRepository->removeFile(metadata->getFilepath(), metadata->getDirectory());
+            artworkRepository->removeFile(metadata->getFilepath(), metadata->getDirectoryID());
             if (metadata->isSelected()) {
                 selectedItems++;
             }
@@ -1153,6 +1222,46 @@ namespace Models {
             ArtworkTitleRole << KeywordsCountRole << HasVectorAttachedRole;
     }
 
+    void ArtItemsModel::scheduleItemsUpdate(const QVector<QPair<int, int> > &ranges, const QVector<int> &roles) {
+        if (ranges.isEmpty()) { return; }
+
+        for (auto &range: ranges) {
+            m_PendingRanges.emplace_back(range.first, range.second);
+        }
+
+        for (int role: roles) {
+            if (!m_PendingRoles.contains(role)) {
+                m_PendingRoles.append(role);
+            }
+        }
+
+        if (!m_UpdatesScheduled) {
+            m_UpdatesScheduled = true;
+            QMetaObject::invokeMethod(this, "flushPendingUpdates", Qt::QueuedConnection);
+        }
+    }
+
+    void ArtItemsModel::flushPendingUpdates() {
+        m_UpdatesScheduled = false;
+        if (m_PendingRanges.empty()) { return; }
+
+        Helpers::RangesVector ranges = Helpers::unionAdjacentRanges(m_PendingRanges);
+        QVector<int> roles;
+        roles.swap(m_PendingRoles);
+        m_PendingRanges.clear();
+
+        const int lastRow = (int)getArtworksCount() - 1;
+        LOG_DEBUG << ranges.size() << "range(s) to update";
+
+        for (auto &range: ranges) {
+            if (range.first > lastRow) { break; }
+
+            QModelIndex topLeft = index(range.first);
+            QModelIndex bottomRight = index(qMin(range.second, lastRow));
+            emit dataChanged(topLeft, bottomRight, roles);
+        }
+    }
+
     void ArtItemsModel::onFilesUnavailableHandler() {
         LOG_DEBUG << "#";
         Models::ArtworksRepository *artworksRepository = m_CommandManager->getArtworksRepository();
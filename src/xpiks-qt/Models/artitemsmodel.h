@@ -33,15 +33,22 @@
 #include <QVector>
 #include <deque>
 #include "../Common/abstractlistmodel.h"
+#include "../Helpers/indiceshelper.h"
 #include "../Common/baseentity.h"
 #include "../Common/ibasicartwork.h"
 #include "../Common/iartworkssource.h"
 #include "../Helpers/ifilenotavailablemodel.h"
 
+class QThread;
+
 namespace Common {
     class BasicMetadataModel;
 }
 
+namespace Helpers {
+    class DirectoryScanner;
+}
+
 namespace Models {
     class ArtworkMetadata;
     class MetadataElement;
@@ -77,7 +84,7 @@ namespace Models {
         };
 
     public:
-        virtual ArtworkMetadata *createMetadata(const QString &filepath);
+        virtual ArtworkMetadata *createMetadata(const QString &filepath, qint64 directoryID);
         void deleteAllItems();
 
     public:
@@ -101,7 +108,8 @@ namespace Models {
         Q_INVOKABLE void backupItem(int metadataIndex);
 
         Q_INVOKABLE void combineArtwork(int index) { doCombineArtwork(index); }
-        Q_INVOKABLE int dropFiles(const QList<QUrl> &urls);
+        // results are reported via artworksAdded() since directories are scanned in background
+        Q_INVOKABLE void dropFiles(const QList<QUrl> &urls);
 
         /*Q_INVOKABLE*/ void setSelectedItemsSaved(const QVector<int> &selectedIndices);
 
@@ -121,7 +129,7 @@ namespace Models {
         Q_INVOKABLE QString getAttachedVectorPath(int metadataIndex) const;
         Q_INVOKABLE QString getArtworkDateTaken(int metadataIndex) const;
 
-        Q_INVOKABLE int addRecentDirectory(const QString &directory);
+        Q_INVOKABLE void addRecentDirectory(const QString &directory);
         Q_INVOKABLE void initDescriptionHighlighting(int metadataIndex, QQuickTextDocument *document);
         Q_INVOKABLE void initTitleHighlighting(int metadataIndex, QQuickTextDocument *document);
 
@@ -146,7 +154,7 @@ namespace Models {
 
     public slots:
         int addLocalArtworks(const QList<QUrl> &artworksPaths);
-        int addLocalDirectories(const QList<QUrl> &directories);
+        void addLocalDirectories(const QList<QUrl> &directories);
 
         void itemModifiedChanged(bool) { updateModifiedCount(); }
         void spellCheckErrorsChanged();
@@ -156,6 +164,11 @@ namespace Models {
         void userDictUpdateHandler(const QStringList &keywords, bool overwritten);
         void userDictClearedHandler();
 
+    private slots:
+        void directoriesScanned(const QStringList &files);
+        void scannerThreadFinished();
+        void flushPendingUpdates();
+
     public:
         virtual void removeItemsAtIndices(const QVector<QPair<int, int> > &ranges) override;
         void beginAccountingFiles(int filesCount);
@@ -174,6 +187,7 @@ namespace Models {
         virtual void updateItemsInRanges(const QVector<QPair<int, int> > &ranges);
         void setAllItemsSelected(bool selected);
         int attachVectors(const QHash<QString, QHash<QString, QString> > &vectorsPaths, QVector<int> &indicesToUpdate) const;
+        void stopScanningDirectories();
 
     public:
         // IARTWORKSSOURCE
@@ -183,8 +197,8 @@ namespace Models {
 
     private:
         void updateItemAtIndex(int metadataIndex);
-        int addDirectories(const QStringList &directories);
-        void doAddDirectory(const QString &directory, QStringList &filesList);
+        void addDirectories(const QStringList &directories);
+        void startScanningDirectories(const QStringList &directories, const QStringList &files);
         int addFiles(const QStringList &filepath);
 
     private:
@@ -216,6 +230,10 @@ namespace Models {
 
     private:
         void fillStandardRoles(QVector<int> &roles) const;
+        // dataChanged() for all scheduled items is emitted once per event loop iteration
+        // scheduled row numbers are valid only until rows are inserted or removed
+        // so pending updates are flushed before every begin*() call
+        void scheduleItemsUpdate(const QVector<QPair<int, int> > &ranges, const QVector<int> &roles);
 
 #ifdef CORE_TESTS
 
@@ -226,7 +244,14 @@ namespace Models {
     private:
         std::deque<ArtworkMetadata *> m_ArtworkList;
         std::deque<ArtworkMetadata *> m_FinalizationList;
+        Helpers::RangesVector m_PendingRanges;
+        QVector<int> m_PendingRoles;
+        QStringList m_ScanningDirectories;
+        QStringList m_ScanningFiles;
+        Helpers::DirectoryScanner *m_DirectoryScanner;
+        QThread *m_ScannerThread;
         qint64 m_LastID;
+        bool m_UpdatesScheduled;
     };
 }
 
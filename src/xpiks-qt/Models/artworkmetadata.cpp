@@ -32,19 +32,16 @@
 #include "../Common/defines.h"
 
 namespace Models {
-    ArtworkMetadata::ArtworkMetadata(const QString &filepath, qint64 ID):
+    ArtworkMetadata::ArtworkMetadata(const QString &filepath, qint64 ID, qint64 directoryID):
         m_MetadataModel(m_Hold),
         m_FileSize(0),
         m_ArtworkFilepath(filepath),
         m_ID(ID),
+        m_DirectoryID(directoryID),
         m_MetadataFlags(0),
-        m_WarningsFlags(Common::WarningFlags::None),
-        m_IsLockedForEditing(false)
+        m_WarningsFlags(Common::WarningFlags::None)
     {
         m_MetadataModel.setSpellCheckInfo(&m_SpellCheckInfo);
-        m_BackupTimer.setSingleShot(true);
-
-        QObject::connect(&m_BackupTimer, SIGNAL(timeout()), this, SLOT(backupTimerTriggered()));
         QObject::connect(&m_MetadataModel, SIGNAL(spellCheckErrorsChanged()), this, SIGNAL(spellCheckErrorsChanged()));
     }
 
@@ -29,7 +29,6 @@
 #include <QString>
 #include <QVector>
 #include <QSet>
-#include <QTimer>
 #include <QQmlEngine>
 #include "../Common/basicmetadatamodel.h"
 #include "../Common/flags.h"
@@ -52,7 +51,7 @@ namespace Models {
         Q_OBJECT
 
     public:
-        ArtworkMetadata(const QString &filepath, qint64 ID);
+        ArtworkMetadata(const QString &filepath, qint64 ID, qint64 directoryID);
         virtual ~ArtworkMetadata();
 
     private:
@@ -60,18 +59,21 @@ namespace Models {
             FlagIsModified = 1 << 0,
             FlagsIsSelected = 1 << 1,
             FlagIsInitialized = 1 << 2,
-            FlagIsUnavailable = 1 << 3
+            FlagIsUnavailable = 1 << 3,
+            FlagIsLockedForEditing = 1 << 4
         };
 
         inline bool getIsModifiedFlag() const { return Common::HasFlag(m_MetadataFlags, FlagIsModified); }
         inline bool getIsSelectedFlag() const { return Common::HasFlag(m_MetadataFlags, FlagsIsSelected); }
         inline bool getIsUnavailableFlag() const { return Common::HasFlag(m_MetadataFlags, FlagIsUnavailable); }
         inline bool getIsInitializedFlag() const { return Common::HasFlag(m_MetadataFlags, FlagIsInitialized); }
+        inline bool getIsLockedForEditingFlag() const { return Common::HasFlag(m_MetadataFlags, FlagIsLockedForEditing); }
 
         inline void setIsModifiedFlag(bool value) { Common::ApplyFlag(m_MetadataFlags, value, FlagIsModified); }
         inline void setIsSelectedFlag(bool value) { Common::ApplyFlag(m_MetadataFlags, value, FlagsIsSelected); }
         inline void setIsUnavailableFlag(bool value) { Common::ApplyFlag(m_MetadataFlags, value, FlagIsUnavailable); }
         inline void setIsInitializedFlag(bool value) { Common::ApplyFlag(m_MetadataFlags, value, FlagIsInitialized); }
+        inline void setIsLockedForEditingFlag(bool value) { Common::ApplyFlag(m_MetadataFlags, value, FlagIsLockedForEditing); }
 
     public:
         bool initialize(const QString &title,
@@ -89,6 +91,7 @@ namespace Models {
         bool isInitialized() const { return getIsInitializedFlag(); }
         virtual qint64 getFileSize() const { return m_FileSize; }
         virtual qint64 getItemID() const override { return m_ID; }
+        qint64 getDirectoryID() const { return m_DirectoryID; }
 
     public:
         Common::WarningFlags getWarningsFlags() const { return m_WarningsFlags; }
@@ -100,8 +103,8 @@ namespace Models {
         Common::BasicMetadataModel *getBasicModel() { return &m_MetadataModel; }
         const Common::BasicMetadataModel *getBasicModel() const { return &m_MetadataModel; }
 
-        bool isLockedForEditing() const { return m_IsLockedForEditing; }
-        void setIsLockedForEditing(bool value) { m_IsLockedForEditing = value; }
+        bool isLockedForEditing() const { return getIsLockedForEditingFlag(); }
+        void setIsLockedForEditing(bool value) { setIsLockedForEditingFlag(value); }
 
         virtual void clearModel();
         virtual bool clearKeywords() override;
@@ -171,6 +174,7 @@ namespace Models {
         // IBasicArtwork interface
         virtual QSet<QString> getKeywordsSet() override { return m_MetadataModel.getKeywordsSet(); }
         virtual QStringList getKeywords() override { return m_MetadataModel.getKeywords(); }
+        QVector<Common::KeywordID> getKeywordIDs() { return m_MetadataModel.getKeywordIDs(); }
         virtual bool isEmpty() override { return m_MetadataModel.isEmpty(); }
         virtual QString getDescription() override { return m_MetadataModel.getDescription(); }
         virtual QString getTitle() override { return m_MetadataModel.getTitle(); }
@@ -180,7 +184,7 @@ namespace Models {
         void setUnavailable() { setIsUnavailableFlag(true); }
         void resetModified() { setIsModifiedFlag(false); }
         void requestFocus(int directionSign) { emit focusRequested(directionSign); }
-        void requestBackup() { m_BackupTimer.start(1000); }
+        void requestBackup() { emit backupRequired(); }
         virtual bool expandPreset(int keywordIndex, const QStringList &presetList) override;
 
 #ifndef CORE_TESTS
@@ -200,20 +204,17 @@ namespace Models {
         void aboutToBeRemoved();
         void spellCheckErrorsChanged();
 
-    private slots:
-        void backupTimerTriggered() { emit backupRequired(); }
-
     private:
         Common::Hold m_Hold;
         SpellCheck::SpellCheckItemInfo m_SpellCheckInfo;
         Common::BasicMetadataModel m_MetadataModel;
         qint64 m_FileSize;  // in bytes
         QString m_ArtworkFilepath;
-        QTimer m_BackupTimer;
         qint64 m_ID;
+        qint64 m_DirectoryID;
+        // all boolean state lives in flags so both ints fill the last 8 bytes
         volatile int m_MetadataFlags;
         volatile Common::WarningFlags m_WarningsFlags;
-        volatile bool m_IsLockedForEditing;
     };
 }
 
@@ -23,7 +23,7 @@
 #include <QDir>
 #include <QSet>
 #include <QFileInfo>
-#include <QRegExp>
+#include <algorithm>
 #include "../Common/defines.h"
 #include "../Helpers/indiceshelper.h"
 #include "../Commands/commandmanager.h"
@@ -31,10 +31,11 @@
 namespace Models {
     ArtworksRepository::ArtworksRepository(QObject *parent) :
         AbstractListModel(parent),
-        m_LastUnavailableFilesCount(0)
+        m_LastUnavailableFilesCount(0),
+        m_LastDirectoryID(0)
     {
-        QObject::connect(&m_FilesWatcher, SIGNAL(fileChanged(const QString &)),
-                     this, SLOT(checkFileUnavailable(const QString &)));
+        QObject::connect(&m_FilesWatcher, SIGNAL(filesUnavailable(QStringList)),
+                         this, SLOT(checkFilesUnavailable(QStringList)));
 
         m_Timer.setInterval(4000); //4 sec
         m_Timer.setSingleShot(true); //single shot
@@ -47,13 +48,12 @@ namespace Models {
 
     void ArtworksRepository::cleanupEmptyDirectories() {
         LOG_DEBUG << "#";
-        int count = m_DirectoriesList.length();
+        int count = (int)m_DirectoriesList.size();
         QVector<int> indicesToRemove;
         indicesToRemove.reserve(count);
 
         for (int i = 0; i < count; ++i) {
-            const QString &directory = m_DirectoriesList[i];
-            if (m_DirectoriesHash[directory] == 0) {
+            if (m_DirectoriesList[i].m_FilesCount == 0) {
                 indicesToRemove.append(i);
             }
         }
@@ -69,16 +69,7 @@ namespace Models {
 
     void ArtworksRepository::stopListeningToUnavailableFiles() {
         LOG_DEBUG << "#";
-
-        QStringList files = m_FilesWatcher.files();
-        if (!files.isEmpty()) {
-            m_FilesWatcher.removePaths(files);
-        }
-
-        QStringList directories = m_FilesWatcher.directories();
-        if (!directories.isEmpty()) {
-            m_FilesWatcher.removePaths(directories);
-        }
+        m_FilesWatcher.unwatchAll();
     }
 
     bool ArtworksRepository::beginAccountingFiles(const QStringList &items) {
@@ -118,7 +109,7 @@ namespace Models {
 
         int count = 0;
         foreach (const QString &directory, filteredDirectories) {
-            if (!m_DirectoriesHash.contains(directory)) {
+            if (!m_DirectoryIDsHash.contains(directory)) {
                 count++;
             }
         }
@@ -139,21 +130,22 @@ namespace Models {
         return count;
     }
 
-    bool ArtworksRepository::accountFile(const QString &filepath) {
+    bool ArtworksRepository::accountFile(const QString &filepath, qint64 &directoryID) {
         bool wasModified = false;
         QString absolutePath;
 
         if (this->checkFileExists(filepath, absolutePath) &&
                 !m_FilesSet.contains(filepath)) {
 
-            int occurances = 0;
-            QHash<QString, int>::iterator dirHashIterator = m_DirectoriesHash.find(absolutePath);
+            int directoryIndex = -1;
+            QHash<QString, qint64>::iterator dirHashIterator = m_DirectoryIDsHash.find(absolutePath);
 
-            if (dirHashIterator == m_DirectoriesHash.end()) {
-                LOG_INFO << "Adding new directory" << absolutePath << "with index" << m_DirectoriesList.length();
-                m_DirectoriesList.append(absolutePath);
-                m_DirectoriesSelectedHash.insert(absolutePath, 0);
-                dirHashIterator = m_DirectoriesHash.insert(absolutePath, 0);
+            if (dirHashIterator == m_DirectoryIDsHash.end()) {
+                directoryIndex = (int)m_DirectoriesList.size();
+                directoryID = m_LastDirectoryID++;
+                LOG_INFO << "Adding new directory" << absolutePath << "with index" << directoryIndex;
+                m_DirectoriesList.emplace_back(absolutePath, directoryID);
+                m_DirectoryIDsHash.insert(absolutePath, directoryID);
                 emit artworksSourcesCountChanged();
 #ifdef CORE_TESTS
                 if (m_CommandManager != nullptr)
@@ -162,12 +154,15 @@ namespace Models {
                     m_CommandManager->addToRecentDirectories(absolutePath);
                 }
             } else {
-                occurances = dirHashIterator.value();
+                directoryID = dirHashIterator.value();
+                directoryIndex = findDirectoryIndex(directoryID);
             }
 
+            Q_ASSERT(directoryIndex != -1);
+
             // watchFilePath(filepath);
             m_FilesSet.insert(filepath);
-            dirHashIterator.value() = occurances + 1;
+            m_DirectoriesList[directoryIndex].m_FilesCount++;
             wasModified = true;
         }
 
@@ -178,16 +173,16 @@ namespace Models {
         watchFilePath(vectorPath);
     }
 
-    bool ArtworksRepository::removeFile(const QString &filepath, const QString &fileDirectory) {
+    bool ArtworksRepository::removeFile(const QString &filepath, qint64 directoryID) {
         bool result = false;
+        int directoryIndex = findDirectoryIndex(directoryID);
 
-        if (m_FilesSet.contains(filepath) && m_DirectoriesHash.contains(fileDirectory)) {
-            int occurances = m_DirectoriesHash[fileDirectory] - 1;
-            int selectedCount = m_DirectoriesSelectedHash[fileDirectory] - 1;
+        if ((directoryIndex != -1) && m_FilesSet.contains(filepath)) {
+            RepoDirectory &directory = m_DirectoriesList[directoryIndex];
+            directory.m_FilesCount--;
+            directory.m_SelectedFilesCount--;
 
-            m_DirectoriesHash[fileDirectory] = occurances;
-            m_DirectoriesSelectedHash[fileDirectory] = selectedCount;
-            m_FilesWatcher.removePath(filepath);
+            m_FilesWatcher.unwatchFiles(QStringList() << filepath);
             m_FilesSet.remove(filepath);
             result = true;
         }
@@ -196,18 +191,16 @@ namespace Models {
     }
 
     void ArtworksRepository::removeVector(const QString &vectorPath) {
-        m_FilesWatcher.removePath(vectorPath);
+        m_FilesWatcher.unwatchFiles(QStringList() << vectorPath);
     }
 
-    void ArtworksRepository::setFileSelected(const QString &filepath, bool selected) {
-        QFileInfo fi(filepath);
-        const QString absolutePath = fi.absolutePath();
+    void ArtworksRepository::setFileSelected(qint64 directoryID, bool selected) {
+        int directoryIndex = findDirectoryIndex(directoryID);
 
-        if (m_DirectoriesSelectedHash.contains(absolutePath)) {
+        if (directoryIndex != -1) {
             int plus = selected ? +1 : -1;
-            m_DirectoriesSelectedHash[absolutePath] = m_DirectoriesSelectedHash[absolutePath] + plus;
+            m_DirectoriesList[directoryIndex].m_SelectedFilesCount += plus;
 
-            int directoryIndex = m_DirectoriesList.indexOf(QRegExp(absolutePath));
             QModelIndex index = this->index(directoryIndex);
             emit dataChanged(index, index, QVector<int>() << IsSelectedRole);
         }
@@ -222,7 +215,7 @@ namespace Models {
     void ArtworksRepository::watchFilePaths(const QStringList &filePaths) {
 #ifndef CORE_TESTS
         if (!filePaths.empty()) {
-            m_FilesWatcher.addPaths(filePaths);
+            m_FilesWatcher.watchFiles(filePaths);
         }
 #else
         Q_UNUSED(filePaths);
@@ -232,7 +225,7 @@ namespace Models {
     void ArtworksRepository::unwatchFilePaths(const QStringList &filePaths) {
 #ifndef CORE_TESTS
         if (!filePaths.empty()) {
-            m_FilesWatcher.removePaths(filePaths);
+            m_FilesWatcher.unwatchFiles(filePaths);
         }
 #else
         Q_UNUSED(filePaths);
@@ -241,12 +234,24 @@ namespace Models {
 
     void ArtworksRepository::watchFilePath(const QString &filepath) {
 #ifndef CORE_TESTS
-        m_FilesWatcher.addPath(filepath);
+        m_FilesWatcher.watchFiles(QStringList() << filepath);
 #else
         Q_UNUSED(filepath);
 #endif
     }
 
+    int ArtworksRepository::findDirectoryIndex(qint64 directoryID) const {
+        auto it = std::lower_bound(m_DirectoriesList.begin(), m_DirectoriesList.end(), directoryID,
+                                   [](const RepoDirectory &directory, qint64 id) { return directory.m_ID < id; });
+
+        int index = -1;
+        if ((it != m_DirectoriesList.end()) && (it->m_ID == directoryID)) {
+            index = (int)std::distance(m_DirectoriesList.begin(), it);
+        }
+
+        return index;
+    }
+
     bool ArtworksRepository::isFileUnavailable(const QString &filepath) const {
         bool isUnavailable = false;
 
@@ -266,32 +271,30 @@ namespace Models {
 
 #ifdef INTEGRATION_TESTS
     void ArtworksRepository::resetEverything() {
-        m_DirectoriesHash.clear();
+        m_DirectoryIDsHash.clear();
         m_DirectoriesList.clear();
-        m_DirectoriesSelectedHash.clear();
         m_FilesSet.clear();
     }
 #endif
 
     int ArtworksRepository::rowCount(const QModelIndex &parent) const {
         Q_UNUSED(parent);
-        return m_DirectoriesList.count();
+        return (int)m_DirectoriesList.size();
     }
 
     QVariant ArtworksRepository::data(const QModelIndex &index, int role) const {
-        if (index.row() < 0 || index.row() >= m_DirectoriesList.count())
+        if (index.row() < 0 || index.row() >= (int)m_DirectoriesList.size())
             return QVariant();
 
-        const QString &directory = m_DirectoriesList.at(index.row());
-        QDir dir(directory);
+        const RepoDirectory &directory = m_DirectoriesList.at(index.row());
 
         switch (role) {
         case PathRole:
-            return dir.dirName();
+            return QDir(directory.m_AbsolutePath).dirName();
         case UsedImagesCountRole:
-            return QVariant(m_DirectoriesHash[directory]);
+            return QVariant(directory.m_FilesCount);
         case IsSelectedRole:
-            return m_DirectoriesSelectedHash[directory] > 0;
+            return directory.m_SelectedFilesCount > 0;
         default:
             return QVariant();
         }
@@ -323,13 +326,15 @@ namespace Models {
         return exists;
     }
 
-    void ArtworksRepository::checkFileUnavailable(const QString &path) {
-        LOG_INFO << "File changed:" << path;
+    void ArtworksRepository::checkFilesUnavailable(const QStringList &filepaths) {
+        LOG_INFO << filepaths.size() << "file(s) became unavailable";
+
+        foreach (const QString &filepath, filepaths) {
+            LOG_DEBUG << "File become unavailable:" << filepath;
+            m_UnavailableFiles.insert(filepath);
+        }
 
-        QFileInfo fi(path);
-        if (!fi.exists()) {
-            LOG_INFO << "File become unavailable:" << path;
-            m_UnavailableFiles.insert(fi.absoluteFilePath());
+        if (!filepaths.isEmpty()) {
             LOG_DEBUG << "Starting availability timer...";
             m_Timer.start();
         }
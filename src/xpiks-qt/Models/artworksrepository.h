@@ -28,9 +28,10 @@
 #include <QPair>
 #include <QSet>
 #include <QTimer>
+#include <vector>
 #include "../Common/abstractlistmodel.h"
 #include "../Common/baseentity.h"
-#include <QFileSystemWatcher>
+#include "../Helpers/fileswatcher.h"
 
 namespace Models {
     class ArtworksRepository : public Common::AbstractListModel, public Common::BaseEntity {
@@ -60,7 +61,7 @@ namespace Models {
     public:
         virtual int getNewDirectoriesCount(const QStringList &items) const;
         int getNewFilesCount(const QStringList &items) const;
-        int getArtworksSourcesCount() const { return m_DirectoriesList.length(); }
+        int getArtworksSourcesCount() const { return (int)m_DirectoriesList.size(); }
         bool canPurgeUnavailableFiles() const { return m_UnavailableFiles.size() == m_LastUnavailableFilesCount; }
 
     signals:
@@ -74,31 +75,33 @@ namespace Models {
         const QSet<QString> &getFilesSet() const { return m_FilesSet; }
 #endif
 
-    public slots:
-        void fileSelectedChanged(const QString &filepath, bool isSelected) { setFileSelected(filepath, isSelected); }
-
     private slots:
-        void checkFileUnavailable(const QString & path);
+        void checkFilesUnavailable(const QStringList &filepaths);
         void onAvailabilityTimer();
 
     public:
-        bool accountFile(const QString &filepath);
+        bool accountFile(const QString &filepath, qint64 &directoryID);
+        bool accountFile(const QString &filepath) { qint64 directoryID; return accountFile(filepath, directoryID); }
         void accountVector(const QString &vectorPath);
-        bool removeFile(const QString &filepath, const QString &fileDirectory);
+        bool removeFile(const QString &filepath, qint64 directoryID);
         void removeVector(const QString &vectorPath);
-        void setFileSelected(const QString &filepath, bool selected);
+        void setFileSelected(qint64 directoryID, bool selected);
         void purgeUnavailableFiles();
         void watchFilePaths(const QStringList &filePaths);
         void unwatchFilePaths(const QStringList &filePaths);
 
     private:
         void watchFilePath(const QString &filepath);
+        int findDirectoryIndex(qint64 directoryID) const;
 
     public:
-        const QString &getDirectory(int index) const { return m_DirectoriesList[index]; }
+        const QString &getDirectory(int index) const { return m_DirectoriesList[index].m_AbsolutePath; }
+        qint64 getDirectoryID(int index) const { return m_DirectoriesList[index].m_ID; }
 #ifdef CORE_TESTS
-        int getFilesCountForDirectory(const QString &directory) const { return m_DirectoriesHash[directory]; }
-        int getFilesCountForDirectory(int index) const { return m_DirectoriesHash[m_DirectoriesList[index]]; }
+        int getFilesCountForDirectory(const QString &directory) const {
+            return m_DirectoriesList[findDirectoryIndex(m_DirectoryIDsHash.value(directory))].m_FilesCount;
+        }
+        int getFilesCountForDirectory(int index) const { return m_DirectoriesList[index].m_FilesCount; }
 #endif
         bool isFileUnavailable(const QString &filepath) const;
 
@@ -115,23 +118,38 @@ namespace Models {
 
     protected:
         virtual void removeInnerItem(int index) override {
-            QString directoryToRemove = m_DirectoriesList.takeAt(index);
-            m_DirectoriesSelectedHash.remove(directoryToRemove);
-            m_DirectoriesHash.remove(directoryToRemove);
+            m_DirectoryIDsHash.remove(m_DirectoriesList[index].m_AbsolutePath);
+            m_DirectoriesList.erase(m_DirectoriesList.begin() + index);
             emit artworksSourcesCountChanged();
         }
 
         virtual bool checkFileExists(const QString &filename, QString &directory) const;
 
     private:
-        QStringList m_DirectoriesList;
-        QHash<QString, int> m_DirectoriesHash;
+        struct RepoDirectory {
+            RepoDirectory(const QString &absolutePath, qint64 directoryID):
+                m_AbsolutePath(absolutePath),
+                m_ID(directoryID),
+                m_FilesCount(0),
+                m_SelectedFilesCount(0)
+            { }
+
+            QString m_AbsolutePath;
+            qint64 m_ID;
+            int m_FilesCount;
+            int m_SelectedFilesCount;
+        };
+
+    private:
+        // IDs only grow and rows are only appended so the list stays sorted by ID
+        std::vector<RepoDirectory> m_DirectoriesList;
+        QHash<QString, qint64> m_DirectoryIDsHash;
         QSet<QString> m_FilesSet;
-        QHash<QString, int> m_DirectoriesSelectedHash;
-        QFileSystemWatcher m_FilesWatcher;
+        Helpers::FilesWatcher m_FilesWatcher;
         QTimer m_Timer;
         QSet<QString> m_UnavailableFiles;
         int m_LastUnavailableFilesCount;
+        qint64 m_LastDirectoryID;
     };
 }
 
@@ -22,6 +22,7 @@
 #include "artworkuploader.h"
 #include <QtConcurrent>
 #include <QFileInfo>
+#include <QTimer>
 #include "uploadinforepository.h"
 #include "uploadinfo.h"
 #include "../Common/defines.h"
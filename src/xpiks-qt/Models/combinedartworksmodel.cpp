@@ -340,8 +340,9 @@ namespace Models {
         bool descriptionsDiffer = false;
         bool titleDiffer = false;
         QString description, title;
-        QSet<QString> commonKeywords, unitedKeywords;
-        QStringList firstItemKeywords;
+        // pooled ids are case sensitive same as keywords themselves
+        QSet<Common::KeywordID> commonKeywords, unitedKeywords;
+        QVector<Common::KeywordID> firstItemKeywords;
         int firstItemKeywordsCount = 0;
 
         processArtworks(pred,
@@ -349,11 +350,9 @@ namespace Models {
             if (!anyItemsProcessed) {
                 description = metadata->getDescription();
                 title = metadata->getTitle();
-                firstItemKeywords = metadata->getKeywords();
-                // preserve case with List to Set convertion
-                auto firstSet = firstItemKeywords.toSet();
-                commonKeywords.unite(firstSet);
-                firstItemKeywordsCount = firstSet.count();
+                firstItemKeywords = metadata->getKeywordIDs();
+                for (auto id: firstItemKeywords) { commonKeywords.insert(id); }
+                firstItemKeywordsCount = commonKeywords.count();
                 anyItemsProcessed = true;
                 return;
             }
@@ -362,8 +361,10 @@ namespace Models {
             QString currTitle = metadata->getTitle();
             descriptionsDiffer = descriptionsDiffer || description != currDescription;
             titleDiffer = titleDiffer || title != currTitle;
-            // preserve case with List to Set convertion
-            auto currentSet = metadata->getKeywords().toSet();
+
+            QSet<Common::KeywordID> currentSet;
+            const auto &currentKeywords = metadata->getKeywordIDs();
+            for (auto id: currentKeywords) { currentSet.insert(id); }
             commonKeywords.intersect(currentSet);
 
             // used to detect if all items have same keywords
@@ -386,11 +387,23 @@ namespace Models {
             initTitle(title);
 
             if (!areKeywordsModified()) {
+                Common::KeywordsPool &pool = Common::KeywordsPool::getInstance();
+
                 if (unitedKeywords.subtract(commonKeywords).isEmpty()) {
                     // all keywords are the same
-                    initKeywords(firstItemKeywords);
+                    initKeywords(pool.getKeywords(firstItemKeywords));
                 } else {
-                    initKeywords(commonKeywords.toList());
+                    // keep order of the first item
+                    QVector<Common::KeywordID> commonKeywordsList;
+                    commonKeywordsList.reserve(commonKeywords.size());
+
+                    for (auto id: firstItemKeywords) {
+                        if (commonKeywords.contains(id)) {
+                            commonKeywordsList.append(id);
+                        }
+                    }
+
+                    initKeywords(pool.getKeywords(commonKeywordsList));
                 }
             }
         }
@@ -149,11 +149,11 @@ namespace Models {
 
     void DeleteKeywordsViewModel::recombineKeywords() {
         LOG_DEBUG << "#";
-        QHash<QString, int> keywordsHash;
+        QHash<Common::KeywordID, int> keywordsHash;
         fillKeywordsHash(keywordsHash);
         LOG_INFO << "Found" << keywordsHash.size() << "keyword(s)";
 
-        QMultiMap<int, QString> selectedKeywords;
+        QMultiMap<int, Common::KeywordID> selectedKeywords;
 
         auto hashIt = keywordsHash.constBegin();
         auto hashItEnd = keywordsHash.constEnd();
@@ -165,7 +165,7 @@ namespace Models {
         auto it = selectedKeywords.constEnd();
         auto itBegin = selectedKeywords.constBegin();
 
-        QStringList commonKeywords;
+        QVector<Common::KeywordID> commonKeywords;
         commonKeywords.reserve(50);
 
         qsrand(QTime::currentTime().msec());
@@ -177,29 +177,23 @@ namespace Models {
             int frequency = it.key();
             if (frequency == 0) { continue; }
 
-            const QString &frequentKeyword = it.value();
-
-            commonKeywords.append(frequentKeyword);
+            commonKeywords.append(it.value());
             if (commonKeywords.size() > maxSize) { break; }
         }
 
         LOG_INFO << "Found" << commonKeywords.size() << "common keywords";
-        m_CommonKeywordsModel.setKeywords(commonKeywords);
+        m_CommonKeywordsModel.setKeywords(Common::KeywordsPool::getInstance().getKeywords(commonKeywords));
         emit commonKeywordsCountChanged();
     }
 
-    void DeleteKeywordsViewModel::fillKeywordsHash(QHash<QString, int> &keywordsHash) {
+    void DeleteKeywordsViewModel::fillKeywordsHash(QHash<Common::KeywordID, int> &keywordsHash) {
         LOG_DEBUG << "#";
         processArtworks([](const MetadataElement&) { return true; },
         [&keywordsHash](int, ArtworkMetadata *metadata) {
-            const auto &keywords = metadata->getKeywords();
-
-            for (auto &keyword: keywords) {
-                if (keywordsHash.contains(keyword)) {
-                    keywordsHash[keyword]++;
-                } else {
-                    keywordsHash.insert(keyword, 1);
-                }
+            const auto &keywordIDs = metadata->getKeywordIDs();
+
+            for (auto id: keywordIDs) {
+                keywordsHash[id]++;
             }
         });
     }
@@ -93,7 +93,7 @@ namespace Models {
 
     private:
         void recombineKeywords();
-        void fillKeywordsHash(QHash<QString, int> &keywordsHash);
+        void fillKeywordsHash(QHash<Common::KeywordID, int> &keywordsHash);
 
     private:
         Common::Hold m_HoldForDeleters;
@@ -23,6 +23,7 @@
 #include <QDir>
 #include "artitemsmodel.h"
 #include "artworkmetadata.h"
+#include "imageartwork.h"
 #include "artworksrepository.h"
 #include "metadataelement.h"
 #include "settingsmodel.h"
@@ -35,14 +36,62 @@
 #include "../Models/previewmetadataelement.h"
 #include "../QuickBuffer/quickbuffer.h"
 
+#define SORTING_NUMBER_WIDTH 20
+
 namespace Models {
+    static bool collatorSortsNaturally(const QCollator &collator) {
+        const bool numericOk = collator.compare("file2", "file10") < 0;
+        const bool caseOk = collator.compare("file", "FILE") == 0;
+        return numericOk && caseOk;
+    }
+
+    // lower-cased text with numbers padded by zeroes
+    // so numbers are compared by value by any collator
+    static QString normalizeForSorting(const QString &text) {
+        const QString lowered = text.toLower();
+        const int size = lowered.size();
+
+        QString result;
+        result.reserve(size + SORTING_NUMBER_WIDTH);
+
+        int i = 0;
+        while (i < size) {
+            if (!lowered.at(i).isDigit()) {
+                result.append(lowered.at(i));
+                i++;
+                continue;
+            }
+
+            int end = i;
+            while ((end < size) && lowered.at(end).isDigit()) { end++; }
+
+            const int digitsCount = end - i;
+            if (digitsCount < SORTING_NUMBER_WIDTH) {
+                result.append(QString(SORTING_NUMBER_WIDTH - digitsCount, QChar('0')));
+            }
+
+            result.append(lowered.midRef(i, digitsCount));
+            i = end;
+        }
+
+        return result;
+    }
+
     FilteredArtItemsProxyModel::FilteredArtItemsProxyModel(QObject *parent):
         QSortFilterProxyModel(parent),
         Common::BaseEntity(),
+        m_UseFilterResults(false),
         m_SelectedArtworksCount(0),
-        m_SortingEnabled(false) {
-        // m_SortingEnabled = true;
-        // this->sort(0);
+        m_SelectedCountUpdateScheduled(false),
+        m_SortingMode(NoSorting),
+        m_NormalizeSortKeys(false) {
+        m_Collator.setNumericMode(true);
+        m_Collator.setCaseSensitivity(Qt::CaseInsensitive);
+
+        m_NormalizeSortKeys = !collatorSortsNaturally(m_Collator);
+        if (m_NormalizeSortKeys) {
+            LOG_INFO << "Collator does not support numeric mode. Using normalized sort keys";
+        }
     }
 
     void FilteredArtItemsProxyModel::setSearchTerm(const QString &value) {
@@ -54,7 +103,7 @@ namespace Models {
             emit searchTermChanged(value);
         }
 
-        invalidateFilter();
+        invalidateSearchFilter();
         emit afterInvalidateFilter();
         forceUnselectAllItems();
     }
@@ -91,12 +140,10 @@ namespace Models {
         ArtItemsModel *artItemsModel = getArtItemsModel();
         const ArtworksRepository *artworksRepository = m_CommandManager->getArtworksRepository();
         const QString &directory = artworksRepository->getDirectory(directoryIndex);
+        const qint64 directoryID = artworksRepository->getDirectoryID(directoryIndex);
 
         LOG_DEBUG << directory;
 
-        QDir dir(directory);
-        QString directoryAbsolutePath = dir.absolutePath();
-
         for (int row = 0; row < size; ++row) {
             QModelIndex proxyIndex = this->index(row, 0);
             QModelIndex originalIndex = this->mapToSource(proxyIndex);
@@ -105,7 +152,7 @@ namespace Models {
             ArtworkMetadata *metadata = artItemsModel->getArtwork(index);
             Q_ASSERT(metadata != NULL);
 
-            if (metadata->isInDirectory(directoryAbsolutePath)) {
+            if (metadata->getDirectoryID() == directoryID) {
                 directoryItems.append(index);
                 metadata->setIsSelected(!metadata->isSelected());
             }
@@ -320,20 +367,37 @@ namespace Models {
     }
 
     void FilteredArtItemsProxyModel::toggleSorted() {
-        LOG_INFO << "current sorted is" << m_SortingEnabled;
+        LOG_INFO << "current sorting mode is" << m_SortingMode;
+        setSortingMode((m_SortingMode == NoSorting) ? SortByFilename : NoSorting);
+    }
+
+    void FilteredArtItemsProxyModel::setSortingMode(int mode) {
+        LOG_INFO << mode;
+
+        if ((mode < NoSorting) || (mode > SortByModified)) {
+            LOG_WARNING << "Unknown sorting mode" << mode;
+            return;
+        }
+
+        if (mode == m_SortingMode) { return; }
+
         forceUnselectAllItems();
 
-        if (!m_SortingEnabled) {
-            m_SortingEnabled = true;
+        m_SortingMode = mode;
+
+        if (mode != NoSorting) {
+            rebuildSortKeys();
             sort(0);
             invalidate();
         } else {
-            m_SortingEnabled = false;
             setSortRole(Qt::InitialSortOrderRole);
             sort(-1);
             invalidate();
+            m_SortKeys.clear();
         }
 
+        emit sortingModeChanged();
+
         ArtItemsModel *artItemsModel = getArtItemsModel();
         artItemsModel->updateAllItems();
     }
@@ -451,6 +515,15 @@ namespace Models {
         int plus = value ? +1 : -1;
 
         m_SelectedArtworksCount += plus;
+
+        if (!m_SelectedCountUpdateScheduled) {
+            m_SelectedCountUpdateScheduled = true;
+            QMetaObject::invokeMethod(this, "selectedCountUpdateRequested", Qt::QueuedConnection);
+        }
+    }
+
+    void FilteredArtItemsProxyModel::selectedCountUpdateRequested() {
+        m_SelectedCountUpdateScheduled = false;
         emit selectedArtworksCountChanged();
     }
 
@@ -624,6 +697,153 @@ namespace Models {
         return artItemsModel;
     }
 
+    FilteredArtItemsProxyModel::SortKey::SortKey(ArtworkMetadata *metadata, const QString &filename, const QString &filepath, const QCollator &collator):
+        m_ItemID(metadata->getItemID()),
+        m_FilenameKey(collator.sortKey(filename)),
+        m_FilepathKey(collator.sortKey(filepath))
+    {
+    }
+
+    QString FilteredArtItemsProxyModel::getCollationString(const QString &text) const {
+        return m_NormalizeSortKeys ? normalizeForSorting(text) : text;
+    }
+
+    void FilteredArtItemsProxyModel::setSourceModel(QAbstractItemModel *sourceModel) {
+        QSortFilterProxyModel::setSourceModel(sourceModel);
+        m_SortKeys.clear();
+
+        QObject::connect(sourceModel, SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)),
+                         this, SLOT(sourceRowsAboutToBeRemoved(QModelIndex,int,int)));
+        QObject::connect(sourceModel, SIGNAL(modelReset()),
+                         this, SLOT(sourceModelReset()));
+    }
+
+    void FilteredArtItemsProxyModel::sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last) {
+        Q_UNUSED(parent);
+        if (m_SortKeys.empty()) { return; }
+
+        ArtItemsModel *artItemsModel = getArtItemsModel();
+        if (artItemsModel == NULL) { return; }
+
+        for (int i = first; i <= last; ++i) {
+            ArtworkMetadata *metadata = artItemsModel->getArtwork(i);
+            if (metadata != NULL) {
+                m_SortKeys.erase(metadata);
+            }
+        }
+    }
+
+    void FilteredArtItemsProxyModel::sourceModelReset() {
+        LOG_DEBUG << "#";
+        m_SortKeys.clear();
+    }
+
+    void FilteredArtItemsProxyModel::rebuildSortKeys() {
+        m_SortKeys.clear();
+
+        ArtItemsModel *artItemsModel = getArtItemsModel();
+        const int size = artItemsModel->getArtworksCount();
+        m_SortKeys.reserve(size);
+
+        for (int i = 0; i < size; ++i) {
+            ArtworkMetadata *metadata = artItemsModel->getArtwork(i);
+            if (metadata == NULL) { continue; }
+
+            m_SortKeys.emplace(metadata, SortKey(metadata,
+                                                 getCollationString(metadata->getBaseFilename()),
+                                                 getCollationString(metadata->getFilepath()),
+                                                 m_Collator));
+        }
+
+        LOG_DEBUG << "Computed" << m_SortKeys.size() << "sort keys";
+    }
+
+    const FilteredArtItemsProxyModel::SortKey &FilteredArtItemsProxyModel::getSortKey(ArtworkMetadata *metadata) const {
+        auto it = m_SortKeys.find(metadata);
+
+        if ((it != m_SortKeys.end()) && (it->second.m_ItemID != metadata->getItemID())) {
+            // memory of removed artwork was reused
+            m_SortKeys.erase(it);
+            it = m_SortKeys.end();
+        }
+
+        if (it == m_SortKeys.end()) {
+            it = m_SortKeys.emplace(metadata, SortKey(metadata,
+                                                      getCollationString(metadata->getBaseFilename()),
+                                                      getCollationString(metadata->getFilepath()),
+                                                      m_Collator)).first;
+        }
+
+        return it->second;
+    }
+
+    int FilteredArtItemsProxyModel::compareFilenames(ArtworkMetadata *left, ArtworkMetadata *right) const {
+        const SortKey &leftKey = getSortKey(left);
+        const SortKey &rightKey = getSortKey(right);
+
+        int result = leftKey.m_FilenameKey.compare(rightKey.m_FilenameKey);
+
+        if (result == 0) {
+            result = leftKey.m_FilepathKey.compare(rightKey.m_FilepathKey);
+        }
+
+        if (result == 0) {
+            result = QString::compare(left->getFilepath(), right->getFilepath());
+        }
+
+        return result;
+    }
+
+    void FilteredArtItemsProxyModel::prefetchSearchTerm(const QString &value) {
+        // results for the current term are already in the proxy
+        if ((value == m_SearchTerm) || value.trimmed().isEmpty()) {
+            m_FilterEngine.cancelEvaluation();
+            return;
+        }
+
+        ArtItemsModel *artItemsModel = getArtItemsModel();
+        if (artItemsModel == NULL) { return; }
+
+        SettingsModel *settingsModel = m_CommandManager->getSettingsModel();
+        bool searchUsingAnd = settingsModel->getSearchUsingAnd();
+
+        updateSearchIndex(value, searchUsingAnd);
+        m_FilterEngine.startEvaluation(artItemsModel, m_SearchIndex, value, searchUsingAnd);
+    }
+
+    void FilteredArtItemsProxyModel::updateSearchIndex(const QString &searchTerm, bool searchUsingAnd) {
+        ArtItemsModel *artItemsModel = getArtItemsModel();
+        Q_ASSERT(artItemsModel != NULL);
+
+        m_SearchIndex.update(artItemsModel);
+        m_SearchIndex.findCandidates(searchTerm, searchUsingAnd);
+    }
+
+    void FilteredArtItemsProxyModel::invalidateSearchFilter() {
+        ArtItemsModel *artItemsModel = getArtItemsModel();
+
+        if ((artItemsModel != NULL) && !m_SearchTerm.trimmed().isEmpty()) {
+            SettingsModel *settingsModel = m_CommandManager->getSettingsModel();
+            bool searchUsingAnd = settingsModel->getSearchUsingAnd();
+
+            m_SearchQuery = Helpers::SearchQuery(m_SearchTerm, Helpers::getSearchFlags(searchUsingAnd));
+
+            if (!m_FilterEngine.canReuseResults(m_SearchTerm, searchUsingAnd)) {
+                updateSearchIndex(m_SearchTerm, searchUsingAnd);
+                m_FilterEngine.evaluate(artItemsModel, m_SearchIndex, m_SearchTerm, searchUsingAnd);
+            } else {
+                LOG_DEBUG << "Reusing prefetched results for" << m_SearchTerm;
+                m_FilterEngine.cancelEvaluation();
+                updateSearchIndex(m_SearchTerm, searchUsingAnd);
+            }
+
+            m_UseFilterResults = true;
+        }
+
+        invalidateFilter();
+        m_UseFilterResults = false;
+    }
+
     bool FilteredArtItemsProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const {
         Q_UNUSED(sourceParent);
 
@@ -640,14 +860,44 @@ namespace Models {
             SettingsModel *settingsModel = m_CommandManager->getSettingsModel();
             bool searchUsingAnd = settingsModel->getSearchUsingAnd();
 
-            hasMatch = Helpers::containsPartsSearch(m_SearchTerm, metadata, searchUsingAnd);
+            if (m_UseFilterResults && m_FilterEngine.tryGetResult(sourceRow, metadata, hasMatch)) {
+                return hasMatch;
+            }
+
+            // index gives a superset of matches so the exact check is still needed
+            if (m_SearchIndex.isCandidate(metadata, m_SearchTerm, searchUsingAnd)) {
+                const bool queryIsActual = (m_SearchQuery.getSearchTerm() == m_SearchTerm) &&
+                        (m_SearchQuery.getSearchFlags() == Helpers::getSearchFlags(searchUsingAnd));
+
+                hasMatch = queryIsActual ? m_SearchQuery.matches(metadata) :
+                                           Helpers::containsPartsSearch(m_SearchTerm, metadata, searchUsingAnd);
+            }
         }
 
         return hasMatch;
     }
 
+    static int compareDatesTaken(ArtworkMetadata *left, ArtworkMetadata *right) {
+        ImageArtwork *leftImage = dynamic_cast<ImageArtwork *>(left);
+        ImageArtwork *rightImage = dynamic_cast<ImageArtwork *>(right);
+
+        const bool leftIsValid = (leftImage != NULL) && leftImage->getDateTimeOriginal().isValid();
+        const bool rightIsValid = (rightImage != NULL) && rightImage->getDateTimeOriginal().isValid();
+
+        // artworks without date go last
+        if (!leftIsValid || !rightIsValid) {
+            return (int)rightIsValid - (int)leftIsValid;
+        }
+
+        const QDateTime &leftDate = leftImage->getDateTimeOriginal();
+        const QDateTime &rightDate = rightImage->getDateTimeOriginal();
+
+        return (leftDate < rightDate) ? -1 : ((rightDate < leftDate) ? 1 : 0);
+    }
+
     bool FilteredArtItemsProxyModel::lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const {
-        if (!m_SortingEnabled) {
+        const int sortingMode = m_SortingMode;
+        if (sortingMode == NoSorting) {
             return QSortFilterProxyModel::lessThan(sourceLeft, sourceRight);
         }
 
@@ -659,22 +909,38 @@ namespace Models {
         bool result = false;
 
         if (leftMetadata != NULL && rightMetadata != NULL) {
-            const QString &leftFilepath = leftMetadata->getFilepath();
-            const QString &rightFilepath = rightMetadata->getFilepath();
-
-            QFileInfo leftFI(leftFilepath);
-            QFileInfo rightFI(rightFilepath);
+            int compareResult = 0;
 
-            QString leftFilename = leftFI.fileName();
-            QString rightFilename = rightFI.fileName();
-
-            int filenamesResult = QString::compare(leftFilename, rightFilename);
+            switch (sortingMode) {
+            case SortByDateTaken: {
+                compareResult = compareDatesTaken(leftMetadata, rightMetadata);
+                break;
+            }
+            case SortByFileSize: {
+                const qint64 leftSize = leftMetadata->getFileSize();
+                const qint64 rightSize = rightMetadata->getFileSize();
+                compareResult = (leftSize < rightSize) ? -1 : ((leftSize > rightSize) ? 1 : 0);
+                break;
+            }
+            case SortByKeywordsCount: {
+                compareResult = leftMetadata->getBasicModel()->getKeywordsCount() -
+                        rightMetadata->getBasicModel()->getKeywordsCount();
+                break;
+            }
+            case SortByModified: {
+                // modified items go first
+                compareResult = (int)rightMetadata->isModified() - (int)leftMetadata->isModified();
+                break;
+            }
+            default:
+                break;
+            }
 
-            if (filenamesResult == 0) {
-                result = QString::compare(leftFilepath, rightFilepath) < 0;
-            } else {
-                result = filenamesResult < 0;
+            if (compareResult == 0) {
+                compareResult = compareFilenames(leftMetadata, rightMetadata);
             }
+
+            result = compareResult < 0;
         }
 
         return result;
@@ -688,18 +954,22 @@ namespace Models {
 #endif
 
     std::vector<MetadataElement> FilteredArtItemsProxyModel::getSearchableOriginalItems(const QString &searchTerm, Common::SearchFlags flags) const {
+        const Helpers::SearchQuery query(searchTerm, flags);
+
         return getFilteredOriginalItems<MetadataElement>(
-            [&searchTerm, flags](ArtworkMetadata *artwork) {
-            return Helpers::hasSearchMatch(searchTerm, artwork, flags);
+            [&query](ArtworkMetadata *artwork) {
+            return query.matches(artwork);
         },
             [] (ArtworkMetadata *metadata, int index, int) { return MetadataElement(metadata, index); });
     }
 
     std::vector<PreviewMetadataElement> FilteredArtItemsProxyModel::getSearchablePreviewOriginalItems(const QString &searchTerm, Common::SearchFlags
                                                                                                       flags) const {
+        const Helpers::SearchQuery query(searchTerm, flags);
+
         return getFilteredOriginalItems<PreviewMetadataElement>(
-            [&searchTerm, flags](ArtworkMetadata *artwork) {
-            return Helpers::hasSearchMatch(searchTerm, artwork, flags);
+            [&query](ArtworkMetadata *artwork) {
+            return query.matches(artwork);
         },
             [] (ArtworkMetadata *metadata, int index, int) { return PreviewMetadataElement(metadata, index); });
     }
@@ -25,9 +25,15 @@
 #include <QSortFilterProxyModel>
 #include <QString>
 #include <QList>
+#include <QCollator>
+#include <QCollatorSortKey>
 #include <functional>
+#include <unordered_map>
 #include "../Common/flags.h"
 #include "../Common/baseentity.h"
+#include "searchindex.h"
+#include "filterengine.h"
+#include "../Helpers/filterhelpers.h"
 
 namespace Models {
     class ArtworkMetadata;
@@ -41,15 +47,28 @@ namespace Models {
         Q_OBJECT
         Q_PROPERTY(QString searchTerm READ getSearchTerm WRITE setSearchTerm NOTIFY searchTermChanged)
         Q_PROPERTY(int selectedArtworksCount READ getSelectedArtworksCount NOTIFY selectedArtworksCountChanged)
+        Q_PROPERTY(int sortingMode READ getSortingMode NOTIFY sortingModeChanged)
+        Q_ENUMS(SortingMode)
 
     public:
         FilteredArtItemsProxyModel(QObject *parent=0);
 
+    public:
+        enum SortingMode {
+            NoSorting = 0,
+            SortByFilename,
+            SortByDateTaken,
+            SortByFileSize,
+            SortByKeywordsCount,
+            SortByModified
+        };
+
     public:
         const QString &getSearchTerm() const { return m_SearchTerm; }
         void setSearchTerm(const QString &value);
 
         int getSelectedArtworksCount() const { return m_SelectedArtworksCount; }
+        int getSortingMode() const { return m_SortingMode; }
         void spellCheckAllItems();
 
         std::vector<MetadataElement> getSearchableOriginalItems(const QString &searchTerm, Common::SearchFlags flags) const;
@@ -58,6 +77,7 @@ namespace Models {
 
 #ifdef CORE_TESTS
         int retrieveNumberOfSelectedItems();
+        int getSortKeysCount() const { return (int)m_SortKeys.size(); }
 #endif
 
     public:
@@ -87,12 +107,14 @@ namespace Models {
         Q_INVOKABLE void removeMetadataInSelected() const;
         Q_INVOKABLE void clearKeywords(int index);
 
-        Q_INVOKABLE void updateFilter() { invalidateFilter(); emit afterInvalidateFilter(); }
+        Q_INVOKABLE void updateFilter() { invalidateSearchFilter(); emit afterInvalidateFilter(); }
+        Q_INVOKABLE void prefetchSearchTerm(const QString &value);
         Q_INVOKABLE void focusNextItem(int index);
         Q_INVOKABLE void focusPreviousItem(int index);
         Q_INVOKABLE void spellCheckDescription(int index);
         Q_INVOKABLE void spellCheckTitle(int index);
         Q_INVOKABLE void toggleSorted();
+        Q_INVOKABLE void setSortingMode(int mode);
         Q_INVOKABLE void detachVectorFromSelected();
         Q_INVOKABLE QObject *getArtworkMetadata(int index);
         Q_INVOKABLE QObject *getBasicModel(int index);
@@ -110,12 +132,18 @@ namespace Models {
         void onSelectedArtworksRemoved(int value);
         void onSpellCheckerAvailable(bool afterRestart);
 
+    private slots:
+        void selectedCountUpdateRequested();
+        void sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+        void sourceModelReset();
+
     signals:
         void searchTermChanged(const QString &searchTerm);
         void selectedArtworksCountChanged();
         void afterInvalidateFilter();
         void allItemsSelectedChanged();
         void forceUnselected();
+        void sortingModeChanged();
 
     private:
         void removeMetadataInItems(std::vector<MetadataElement> &itemsToClear, Common::CombinedEditFlags flags) const;
@@ -139,6 +167,25 @@ namespace Models {
         QVector<int> getSelectedIndices() const;
         void forceUnselectAllItems();
         ArtItemsModel *getArtItemsModel() const;
+        void updateSearchIndex(const QString &searchTerm, bool searchUsingAnd);
+        void invalidateSearchFilter();
+
+    private:
+        struct SortKey {
+            SortKey(ArtworkMetadata *metadata, const QString &filename, const QString &filepath, const QCollator &collator);
+
+            qint64 m_ItemID;
+            QCollatorSortKey m_FilenameKey;
+            QCollatorSortKey m_FilepathKey;
+        };
+
+        QString getCollationString(const QString &text) const;
+        void rebuildSortKeys();
+        const SortKey &getSortKey(ArtworkMetadata *metadata) const;
+        int compareFilenames(ArtworkMetadata *left, ArtworkMetadata *right) const;
+
+    public:
+        virtual void setSourceModel(QAbstractItemModel *sourceModel) override;
 
     protected:
         virtual bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
@@ -147,8 +194,20 @@ namespace Models {
     private:
         // ignore default regexp from proxymodel
         QString m_SearchTerm;
+        Helpers::SearchQuery m_SearchQuery;
+        SearchIndex m_SearchIndex;
+        FilterEngine m_FilterEngine;
+        // precomputed results are used only during own invalidation
+        bool m_UseFilterResults;
         volatile int m_SelectedArtworksCount;
-        volatile bool m_SortingEnabled;
+        // bulk selection notifies QML about count only once
+        volatile bool m_SelectedCountUpdateScheduled;
+        volatile int m_SortingMode;
+        QCollator m_Collator;
+        // platform collator might ignore numeric mode and case sensitivity
+        bool m_NormalizeSortKeys;
+        // filename keys are computed once instead of on every comparison
+        mutable std::unordered_map<ArtworkMetadata *, SortKey> m_SortKeys;
     };
 }
 
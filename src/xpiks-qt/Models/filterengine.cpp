@@ -0,0 +1,238 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "filterengine.h"
+#include <QtConcurrent>
+#include "artitemsmodel.h"
+#include "artworkmetadata.h"
+#include "searchindex.h"
+#include "../Common/basickeywordsmodel.h"
+#include "../Common/defines.h"
+
+#define FILTER_CHUNK_SIZE 512
+
+namespace Models {
+    static void splitToChunks(int size, std::vector<QPair<int, int> > &chunks) {
+        chunks.clear();
+        chunks.reserve(size / FILTER_CHUNK_SIZE + 1);
+
+        for (int start = 0; start < size; start += FILTER_CHUNK_SIZE) {
+            chunks.emplace_back(start, qMin(start + FILTER_CHUNK_SIZE, size));
+        }
+    }
+
+    static bool isVolatileSearchTerm(const QString &searchTerm) {
+        const QStringList searchTerms = searchTerm.split(QChar::Space, QString::SkipEmptyParts);
+        for (auto &term: searchTerms) {
+            if (term.startsWith(QLatin1String("x:"))) { return true; }
+        }
+
+        return false;
+    }
+
+    FilterEngine::ChunkEvaluator::ChunkEvaluator(std::vector<FilterItem> &items, const Helpers::SearchQuery &query,
+                                                 const QAtomicInt &generation, int expectedGeneration):
+        m_Items(items),
+        m_Query(query),
+        m_Generation(generation),
+        m_ExpectedGeneration(expectedGeneration)
+    {
+    }
+
+    void FilterEngine::ChunkEvaluator::operator()(const QPair<int, int> &range) {
+        // stale evaluation is abandoned as soon as next one is requested
+        if (m_Generation.load() != m_ExpectedGeneration) { return; }
+
+        for (int i = range.first; i < range.second; ++i) {
+            FilterItem &item = m_Items[i];
+            if (item.m_NeedsCheck) {
+                item.m_Accepted = m_Query.matches(item.m_Artwork);
+            }
+        }
+    }
+
+    FilterEngine::FilterEngine(QObject *parent):
+        QObject(parent),
+        m_Generation(0),
+        m_SearchUsingAnd(false),
+        m_PendingSearchUsingAnd(false),
+        m_HasResults(false),
+        m_IsVolatile(false)
+    {
+        QObject::connect(&m_EvaluationWatcher, SIGNAL(finished()), this, SLOT(evaluationWatcherFinished()));
+    }
+
+    FilterEngine::~FilterEngine() {
+        cancelEvaluation();
+    }
+
+    void FilterEngine::evaluate(ArtItemsModel *artItemsModel, const SearchIndex &searchIndex,
+                                const QString &searchTerm, bool searchUsingAnd) {
+        cancelEvaluation();
+
+        m_HasResults = false;
+        const int toCheckCount = prepareItems(artItemsModel, searchIndex, searchTerm, searchUsingAnd, m_Items, false);
+        const int size = (int)m_Items.size();
+
+        m_Generation.ref();
+        Helpers::SearchQuery query(searchTerm, Helpers::getSearchFlags(searchUsingAnd));
+        ChunkEvaluator evaluator(m_Items, query, m_Generation, m_Generation.load());
+
+        if (toCheckCount <= FILTER_CHUNK_SIZE) {
+            evaluator(qMakePair(0, size));
+        } else {
+            std::vector<QPair<int, int> > chunks;
+            splitToChunks(size, chunks);
+            QtConcurrent::blockingMap(chunks, evaluator);
+        }
+
+        LOG_DEBUG << "Evaluated" << toCheckCount << "of" << size << "artworks";
+
+        m_SearchTerm = searchTerm;
+        m_SearchUsingAnd = searchUsingAnd;
+        m_IsVolatile = isVolatileSearchTerm(searchTerm);
+        m_HasResults = true;
+    }
+
+    void FilterEngine::startEvaluation(ArtItemsModel *artItemsModel, const SearchIndex &searchIndex,
+                                       const QString &searchTerm, bool searchUsingAnd) {
+        cancelEvaluation();
+
+        prepareItems(artItemsModel, searchIndex, searchTerm, searchUsingAnd, m_PendingItems, true);
+        splitToChunks((int)m_PendingItems.size(), m_PendingChunks);
+        m_PendingSearchTerm = searchTerm;
+        m_PendingSearchUsingAnd = searchUsingAnd;
+
+        m_Generation.ref();
+        Helpers::SearchQuery query(searchTerm, Helpers::getSearchFlags(searchUsingAnd));
+        ChunkEvaluator evaluator(m_PendingItems, query, m_Generation, m_Generation.load());
+        m_EvaluationWatcher.setFuture(QtConcurrent::map(m_PendingChunks, evaluator));
+    }
+
+    void FilterEngine::cancelEvaluation() {
+        if (m_EvaluationWatcher.isRunning()) {
+            LOG_DEBUG << "Cancelling evaluation of" << m_PendingSearchTerm;
+            m_Generation.ref();
+            m_EvaluationWatcher.cancel();
+            m_EvaluationWatcher.waitForFinished();
+        }
+
+        releasePendingItems();
+    }
+
+    bool FilterEngine::hasResultsFor(const QString &searchTerm, bool searchUsingAnd) const {
+        return m_HasResults &&
+                (m_SearchUsingAnd == searchUsingAnd) &&
+                (m_SearchTerm == searchTerm);
+    }
+
+    bool FilterEngine::canReuseResults(const QString &searchTerm, bool searchUsingAnd) const {
+        return !m_IsVolatile && hasResultsFor(searchTerm, searchUsingAnd);
+    }
+
+    bool FilterEngine::tryGetResult(int row, ArtworkMetadata *metadata, bool &accepted) const {
+        if (!m_HasResults) { return false; }
+        if ((row < 0) || (row >= (int)m_Items.size())) { return false; }
+
+        const FilterItem &item = m_Items[row];
+        if ((item.m_Artwork != metadata) ||
+                (item.m_ItemID != metadata->getItemID()) ||
+                (item.m_Revision != metadata->getBasicModel()->getRevision())) {
+            return false;
+        }
+
+        accepted = item.m_Accepted;
+        return true;
+    }
+
+    void FilterEngine::evaluationWatcherFinished() {
+        // notification from previous future could be delivered after the new one was started
+        if (!m_EvaluationWatcher.isFinished()) { return; }
+
+        if (m_EvaluationWatcher.isCanceled() || m_PendingItems.empty()) {
+            releasePendingItems();
+            return;
+        }
+
+        releaseHolds(m_PendingItems);
+        m_Items.swap(m_PendingItems);
+        m_PendingItems.clear();
+        m_PendingChunks.clear();
+
+        m_SearchTerm = m_PendingSearchTerm;
+        m_SearchUsingAnd = m_PendingSearchUsingAnd;
+        m_IsVolatile = isVolatileSearchTerm(m_SearchTerm);
+        m_HasResults = true;
+
+        LOG_DEBUG << "Finished evaluation of" << m_SearchTerm;
+        emit evaluationFinished();
+    }
+
+    int FilterEngine::prepareItems(ArtItemsModel *artItemsModel, const SearchIndex &searchIndex,
+                                   const QString &searchTerm, bool searchUsingAnd,
+                                   std::vector<FilterItem> &items, bool holdArtworks) {
+        Q_ASSERT(artItemsModel != NULL);
+        const int size = artItemsModel->getArtworksCount();
+        int toCheckCount = 0;
+
+        items.clear();
+        items.resize(size);
+
+        for (int i = 0; i < size; ++i) {
+            FilterItem &item = items[i];
+            ArtworkMetadata *metadata = artItemsModel->getArtwork(i);
+
+            item.m_Artwork = metadata;
+            item.m_Accepted = false;
+            item.m_NeedsCheck = false;
+            item.m_ItemID = 0;
+            item.m_Revision = 0;
+
+            if (metadata == NULL) { continue; }
+
+            item.m_ItemID = metadata->getItemID();
+            // revision is read before evaluation so that concurrent edit invalidates result
+            item.m_Revision = metadata->getBasicModel()->getRevision();
+            item.m_NeedsCheck = searchIndex.isCandidate(metadata, searchTerm, searchUsingAnd);
+
+            if (item.m_NeedsCheck) {
+                toCheckCount++;
+                if (holdArtworks) { metadata->acquire(); }
+            }
+        }
+
+        return toCheckCount;
+    }
+
+    void FilterEngine::releaseHolds(std::vector<FilterItem> &items) {
+        for (auto &item: items) {
+            if (item.m_NeedsCheck) {
+                item.m_Artwork->release();
+            }
+        }
+    }
+
+    void FilterEngine::releasePendingItems() {
+        releaseHolds(m_PendingItems);
+        m_PendingItems.clear();
+        m_PendingChunks.clear();
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FILTERENGINE_H
+#define FILTERENGINE_H
+
+#include <QObject>
+#include <QString>
+#include <QFutureWatcher>
+#include <QAtomicInt>
+#include <QPair>
+#include <vector>
+#include "../Helpers/filterhelpers.h"
+
+namespace Models {
+    class ArtItemsModel;
+    class ArtworkMetadata;
+    class SearchIndex;
+
+    // evaluates search term for all artworks in chunks on the global
+    // thread pool and keeps accept flag for every source row
+    class FilterEngine : public QObject
+    {
+        Q_OBJECT
+    public:
+        explicit FilterEngine(QObject *parent = 0);
+        virtual ~FilterEngine();
+
+    private:
+        struct FilterItem {
+            ArtworkMetadata *m_Artwork;
+            qint64 m_ItemID;
+            int m_Revision;
+            bool m_Accepted;
+            bool m_NeedsCheck;
+        };
+
+        class ChunkEvaluator {
+        public:
+            typedef void result_type;
+
+            ChunkEvaluator(std::vector<FilterItem> &items, const Helpers::SearchQuery &query,
+                           const QAtomicInt &generation, int expectedGeneration);
+            void operator()(const QPair<int, int> &range);
+
+        private:
+            std::vector<FilterItem> &m_Items;
+            Helpers::SearchQuery m_Query;
+            const QAtomicInt &m_Generation;
+            int m_ExpectedGeneration;
+        };
+
+    public:
+        void evaluate(ArtItemsModel *artItemsModel, const SearchIndex &searchIndex,
+                      const QString &searchTerm, bool searchUsingAnd);
+        void startEvaluation(ArtItemsModel *artItemsModel, const SearchIndex &searchIndex,
+                             const QString &searchTerm, bool searchUsingAnd);
+        void cancelEvaluation();
+        bool hasResultsFor(const QString &searchTerm, bool searchUsingAnd) const;
+        bool canReuseResults(const QString &searchTerm, bool searchUsingAnd) const;
+        // returns false if there's no up to date result for the row
+        bool tryGetResult(int row, ArtworkMetadata *metadata, bool &accepted) const;
+        bool isEvaluating() const { return m_EvaluationWatcher.isRunning(); }
+
+    signals:
+        void evaluationFinished();
+
+    private slots:
+        void evaluationWatcherFinished();
+
+    private:
+        int prepareItems(ArtItemsModel *artItemsModel, const SearchIndex &searchIndex,
+                         const QString &searchTerm, bool searchUsingAnd,
+                         std::vector<FilterItem> &items, bool holdArtworks);
+        void releaseHolds(std::vector<FilterItem> &items);
+        void releasePendingItems();
+
+    private:
+        std::vector<FilterItem> m_Items;
+        std::vector<FilterItem> m_PendingItems;
+        std::vector<QPair<int, int> > m_PendingChunks;
+        QFutureWatcher<void> m_EvaluationWatcher;
+        QAtomicInt m_Generation;
+        QString m_SearchTerm;
+        QString m_PendingSearchTerm;
+        bool m_SearchUsingAnd;
+        bool m_PendingSearchUsingAnd;
+        bool m_HasResults;
+        // results of reserved terms depend on flags which are not tracked by revision
+        bool m_IsVolatile;
+    };
+}
+
+#endif // FILTERENGINE_H
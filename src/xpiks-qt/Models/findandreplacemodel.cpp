@@ -92,35 +92,37 @@ namespace Models {
 
         LOG_INFO << "Found" << m_ArtworksList.size() << "item(s)";
 
+        Common::SearchFlags titleFlags = m_Flags;
+        Common::UnsetFlag(titleFlags, Common::SearchFlags::Description);
+        Common::UnsetFlag(titleFlags, Common::SearchFlags::Keywords);
+        const Helpers::SearchQuery titleQuery(m_ReplaceFrom, titleFlags);
+
+        Common::SearchFlags descriptionFlags = m_Flags;
+        Common::UnsetFlag(descriptionFlags, Common::SearchFlags::Title);
+        Common::UnsetFlag(descriptionFlags, Common::SearchFlags::Keywords);
+        const Helpers::SearchQuery descriptionQuery(m_ReplaceFrom, descriptionFlags);
+
+        Common::SearchFlags keywordsFlags = m_Flags;
+        Common::UnsetFlag(keywordsFlags, Common::SearchFlags::Description);
+        Common::UnsetFlag(keywordsFlags, Common::SearchFlags::Title);
+        const Helpers::SearchQuery keywordsQuery(m_ReplaceFrom, keywordsFlags);
+
         for (auto &preview: m_ArtworksList) {
             Models::ArtworkMetadata *metadata = preview.getOrigin();
             bool hasMatch = false;
-            Common::SearchFlags flags = Common::SearchFlags::None;
 
             if (getSearchInTitle()) {
-                flags = m_Flags;
-                Common::UnsetFlag(flags, Common::SearchFlags::Description);
-                Common::UnsetFlag(flags, Common::SearchFlags::Keywords);
-
-                hasMatch = Helpers::hasSearchMatch(m_ReplaceFrom, metadata, flags);
+                hasMatch = titleQuery.matches(metadata);
                 preview.setHasTitleMatch(hasMatch);
             }
 
             if (getSearchInDescription()) {
-                flags = m_Flags;
-                Common::UnsetFlag(flags, Common::SearchFlags::Title);
-                Common::UnsetFlag(flags, Common::SearchFlags::Keywords);
-
-                hasMatch = Helpers::hasSearchMatch(m_ReplaceFrom, metadata, flags);
+                hasMatch = descriptionQuery.matches(metadata);
                 preview.setHasDescriptionMatch(hasMatch);
             }
 
             if (getSearchInKeywords()) {
-                flags = m_Flags;
-                Common::UnsetFlag(flags, Common::SearchFlags::Description);
-                Common::UnsetFlag(flags, Common::SearchFlags::Title);
-
-                hasMatch = Helpers::hasSearchMatch(m_ReplaceFrom, metadata, flags);
+                hasMatch = keywordsQuery.matches(metadata);
                 preview.setHasKeywordsMatch(hasMatch);
             }
         }
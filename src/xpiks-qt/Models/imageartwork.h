@@ -33,7 +33,7 @@ namespace Models {
     {
         Q_OBJECT
     public:
-        ImageArtwork(const QString &filepath, qint64 ID);
+        ImageArtwork(const QString &filepath, qint64 ID, qint64 directoryID);
 
     private:
         enum ImageArtworkFlags {
@@ -47,6 +47,7 @@ namespace Models {
         QSize getImageSize() const { return m_ImageSize; }
         void setImageSize(const QSize &size) { m_ImageSize = size; }
         void setDateTimeOriginal(const QDateTime &dateTime) { m_DateTimeOriginal = dateTime; }
+        const QDateTime &getDateTimeOriginal() const { return m_DateTimeOriginal; }
         const QString &getAttachedVectorPath() const { return m_AttachedVector; }
         QString getDateTaken() const { return m_DateTimeOriginal.toString(); }
         bool hasVectorAttached() const { return getHasVectorAttachedFlag(); }
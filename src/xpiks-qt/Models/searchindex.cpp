@@ -0,0 +1,359 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "searchindex.h"
+#include "artitemsmodel.h"
+#include "artworkmetadata.h"
+#include "../Common/basickeywordsmodel.h"
+#include "../Common/defines.h"
+
+#define TRIGRAM_LENGTH 3
+#define MIN_POSTINGS_TO_COMPACT 10000
+
+namespace Models {
+    static quint64 packTrigram(const QChar *chars) {
+        quint64 result = ((quint64)chars[0].unicode() << 32) |
+                ((quint64)chars[1].unicode() << 16) |
+                (quint64)chars[2].unicode();
+        return result;
+    }
+
+    static bool isUnindexableTerm(const QString &term) {
+        if (term.startsWith(QLatin1String("x:"))) { return true; }
+
+        const int length = term.length();
+        for (int i = 0; i < length; ++i) {
+            if (term[i].isSpace()) { return true; }
+        }
+
+        return false;
+    }
+
+    SearchIndex::SearchIndex():
+        m_PostingsCount(0),
+        m_LivePostingsCount(0),
+        m_Generation(0),
+        m_CandidatesUseAnd(false),
+        m_HasCandidates(false)
+    {
+    }
+
+    void SearchIndex::update(ArtItemsModel *artItemsModel) {
+        Q_ASSERT(artItemsModel != NULL);
+
+        m_HasCandidates = false;
+        m_Generation++;
+
+        int reindexedCount = 0;
+        const int size = artItemsModel->getArtworksCount();
+
+        for (int i = 0; i < size; ++i) {
+            ArtworkMetadata *metadata = artItemsModel->getArtwork(i);
+            if (metadata == NULL) { continue; }
+
+            int slot = -1;
+            auto it = m_SlotsHash.find(metadata);
+
+            if (it == m_SlotsHash.end()) {
+                slot = acquireSlot();
+                m_SlotsHash.insert(metadata, slot);
+                indexArtwork(slot, metadata);
+                reindexedCount++;
+            } else {
+                slot = it.value();
+                const IndexedArtwork &item = m_Slots[slot];
+
+                if ((item.m_ItemID != metadata->getItemID()) ||
+                        (item.m_Revision != metadata->getBasicModel()->getRevision())) {
+                    m_LivePostingsCount -= item.m_TokensCount;
+                    indexArtwork(slot, metadata);
+                    reindexedCount++;
+                }
+            }
+
+            m_Slots[slot].m_Generation = m_Generation;
+        }
+
+        int removedCount = 0;
+        auto it = m_SlotsHash.begin();
+        while (it != m_SlotsHash.end()) {
+            const int slot = it.value();
+            if (m_Slots[slot].m_Generation != m_Generation) {
+                releaseSlot(slot);
+                it = m_SlotsHash.erase(it);
+                removedCount++;
+            } else {
+                ++it;
+            }
+        }
+
+        if (needsCompaction()) {
+            LOG_INFO << "Compacting index:" << m_PostingsCount << "postings," << m_LivePostingsCount << "live";
+            clear();
+            update(artItemsModel);
+            return;
+        }
+
+        if ((reindexedCount > 0) || (removedCount > 0)) {
+            LOG_DEBUG << "Reindexed" << reindexedCount << "removed" << removedCount << "artworks." <<
+                         "Tokens:" << m_Tokens.size();
+        }
+    }
+
+    void SearchIndex::findCandidates(const QString &searchTerm, bool searchUsingAnd) {
+        m_CandidatesTerm = searchTerm;
+        m_CandidatesUseAnd = searchUsingAnd;
+        m_HasCandidates = false;
+
+        const QStringList searchTerms = searchTerm.split(QChar::Space, QString::SkipEmptyParts);
+        const int slotsCount = (int)m_Slots.size();
+        QBitArray result(slotsCount, false);
+        bool anyNarrowed = false;
+
+        for (auto &term: searchTerms) {
+            QString part = term;
+            // "!term" is a whole keyword match which is a subset of "term"
+            if ((part.length() > 1) && (part[0] == QLatin1Char('!'))) {
+                part.remove(0, 1);
+            }
+
+            if (isUnindexableTerm(part)) {
+                if (searchUsingAnd) { continue; }
+                // any row can match this term
+                return;
+            }
+
+            QBitArray termCandidates(slotsCount, false);
+            findTermCandidates(part.toCaseFolded(), termCandidates);
+
+            if (!anyNarrowed) {
+                result = termCandidates;
+                anyNarrowed = true;
+            } else if (searchUsingAnd) {
+                result &= termCandidates;
+            } else {
+                result |= termCandidates;
+            }
+        }
+
+        if (anyNarrowed) {
+            m_Candidates = result;
+            m_HasCandidates = true;
+            LOG_DEBUG << m_Candidates.count(true) << "candidates of" << m_SlotsHash.size() << "for" << searchTerm;
+        }
+    }
+
+    bool SearchIndex::isCandidate(ArtworkMetadata *metadata, const QString &searchTerm, bool searchUsingAnd) const {
+        if (!m_HasCandidates ||
+                (searchUsingAnd != m_CandidatesUseAnd) ||
+                (searchTerm != m_CandidatesTerm)) {
+            return true;
+        }
+
+        auto it = m_SlotsHash.find(metadata);
+        if (it == m_SlotsHash.end()) { return true; }
+
+        const int slot = it.value();
+        if (slot >= m_Candidates.size()) { return true; }
+
+        const IndexedArtwork &item = m_Slots[slot];
+        if ((item.m_ItemID != metadata->getItemID()) ||
+                (item.m_Revision != metadata->getBasicModel()->getRevision())) {
+            // changed since last update
+            return true;
+        }
+
+        return m_Candidates.testBit(slot);
+    }
+
+    void SearchIndex::clear() {
+        m_SlotsHash.clear();
+        m_Slots.clear();
+        m_FreeSlots.clear();
+        m_TokenIDs.clear();
+        m_Tokens.clear();
+        m_Postings.clear();
+        m_Trigrams.clear();
+        m_PostingsCount = 0;
+        m_LivePostingsCount = 0;
+        m_Candidates.clear();
+        m_HasCandidates = false;
+    }
+
+    int SearchIndex::acquireSlot() {
+        int slot = -1;
+
+        if (!m_FreeSlots.empty()) {
+            slot = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        } else {
+            slot = (int)m_Slots.size();
+            m_Slots.emplace_back();
+        }
+
+        IndexedArtwork &item = m_Slots[slot];
+        item.m_Artwork = NULL;
+        item.m_ItemID = 0;
+        item.m_Revision = 0;
+        item.m_TokensCount = 0;
+        item.m_Generation = 0;
+
+        return slot;
+    }
+
+    void SearchIndex::releaseSlot(int slot) {
+        IndexedArtwork &item = m_Slots[slot];
+        m_LivePostingsCount -= item.m_TokensCount;
+        item.m_Artwork = NULL;
+        item.m_TokensCount = 0;
+        m_FreeSlots.push_back(slot);
+    }
+
+    void SearchIndex::indexArtwork(int slot, ArtworkMetadata *metadata) {
+        IndexedArtwork &item = m_Slots[slot];
+        item.m_Artwork = metadata;
+        item.m_ItemID = metadata->getItemID();
+        // revision is read before the data so concurrent edit makes entry stale
+        item.m_Revision = metadata->getBasicModel()->getRevision();
+
+        QSet<int> tokenIDs;
+        tokenize(metadata->getTitle(), tokenIDs);
+        tokenize(metadata->getDescription(), tokenIDs);
+        tokenize(metadata->getFilepath(), tokenIDs);
+
+        const QStringList keywords = metadata->getKeywords();
+        for (auto &keyword: keywords) {
+            tokenize(keyword, tokenIDs);
+        }
+
+        for (int tokenID: tokenIDs) {
+            m_Postings[tokenID].push_back(slot);
+        }
+
+        item.m_TokensCount = tokenIDs.size();
+        m_PostingsCount += item.m_TokensCount;
+        m_LivePostingsCount += item.m_TokensCount;
+    }
+
+    void SearchIndex::tokenize(const QString &text, QSet<int> &tokenIDs) {
+        if (text.isEmpty()) { return; }
+
+        const QString folded = text.toCaseFolded();
+        const int length = folded.length();
+        int start = -1;
+
+        for (int i = 0; i <= length; ++i) {
+            const bool isSeparator = (i == length) || folded[i].isSpace();
+
+            if (isSeparator) {
+                if (start != -1) {
+                    tokenIDs.insert(getTokenID(folded.mid(start, i - start)));
+                    start = -1;
+                }
+            } else if (start == -1) {
+                start = i;
+            }
+        }
+    }
+
+    int SearchIndex::getTokenID(const QString &token) {
+        auto it = m_TokenIDs.find(token);
+        if (it != m_TokenIDs.end()) {
+            return it.value();
+        }
+
+        const int tokenID = (int)m_Tokens.size();
+        m_TokenIDs.insert(token, tokenID);
+        m_Tokens.push_back(token);
+        m_Postings.emplace_back();
+        addTrigrams(token, tokenID);
+
+        return tokenID;
+    }
+
+    void SearchIndex::addTrigrams(const QString &token, int tokenID) {
+        const int length = token.length();
+        if (length < TRIGRAM_LENGTH) { return; }
+
+        QSet<quint64> trigrams;
+        const QChar *chars = token.constData();
+        for (int i = 0; i + TRIGRAM_LENGTH <= length; ++i) {
+            trigrams.insert(packTrigram(chars + i));
+        }
+
+        for (quint64 trigram: trigrams) {
+            m_Trigrams[trigram].push_back(tokenID);
+        }
+    }
+
+    bool SearchIndex::findTermCandidates(const QString &term, QBitArray &candidates) const {
+        bool anyFound = false;
+        const int length = term.length();
+
+        if (length < TRIGRAM_LENGTH) {
+            const int tokensCount = (int)m_Tokens.size();
+            for (int i = 0; i < tokensCount; ++i) {
+                if (m_Tokens[i].contains(term)) {
+                    markPostings(i, candidates);
+                    anyFound = true;
+                }
+            }
+
+            return anyFound;
+        }
+
+        // the rarest trigram gives the shortest list of tokens to verify
+        const std::vector<int> *rarest = NULL;
+        const QChar *chars = term.constData();
+
+        for (int i = 0; i + TRIGRAM_LENGTH <= length; ++i) {
+            auto it = m_Trigrams.find(packTrigram(chars + i));
+            if (it == m_Trigrams.end()) { return false; }
+
+            if ((rarest == NULL) || (it.value().size() < rarest->size())) {
+                rarest = &it.value();
+            }
+        }
+
+        Q_ASSERT(rarest != NULL);
+
+        for (int tokenID: *rarest) {
+            if (m_Tokens[tokenID].contains(term)) {
+                markPostings(tokenID, candidates);
+                anyFound = true;
+            }
+        }
+
+        return anyFound;
+    }
+
+    void SearchIndex::markPostings(int tokenID, QBitArray &candidates) const {
+        const std::vector<int> &postings = m_Postings[tokenID];
+        for (int slot: postings) {
+            candidates.setBit(slot);
+        }
+    }
+
+    bool SearchIndex::needsCompaction() const {
+        const qint64 stalePostings = m_PostingsCount - m_LivePostingsCount;
+        return (m_PostingsCount > MIN_POSTINGS_TO_COMPACT) && (stalePostings > m_LivePostingsCount);
+    }
+}
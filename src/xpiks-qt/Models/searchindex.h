@@ -0,0 +1,98 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+#include <QBitArray>
+#include <vector>
+
+namespace Models {
+    class ArtItemsModel;
+    class ArtworkMetadata;
+
+    // inverted index over whitespace-separated tokens of title, description,
+    // keywords and filepath together with trigram index over the tokens
+    // used to narrow down rows which have to be checked by the main filter
+    class SearchIndex
+    {
+    public:
+        SearchIndex();
+
+    private:
+        struct IndexedArtwork {
+            ArtworkMetadata *m_Artwork;
+            qint64 m_ItemID;
+            int m_Revision;
+            int m_TokensCount;
+            quint32 m_Generation;
+        };
+
+    public:
+        void update(ArtItemsModel *artItemsModel);
+        void findCandidates(const QString &searchTerm, bool searchUsingAnd);
+        // false only when artwork surely does not match the search term
+        bool isCandidate(ArtworkMetadata *metadata, const QString &searchTerm, bool searchUsingAnd) const;
+        void clear();
+
+    public:
+        int getIndexedArtworksCount() const { return m_SlotsHash.size(); }
+        int getTokensCount() const { return (int)m_Tokens.size(); }
+        bool hasCandidates() const { return m_HasCandidates; }
+        int getCandidatesCount() const { return m_HasCandidates ? m_Candidates.count(true) : -1; }
+
+    private:
+        int acquireSlot();
+        void releaseSlot(int slot);
+        void indexArtwork(int slot, ArtworkMetadata *metadata);
+        void tokenize(const QString &text, QSet<int> &tokenIDs);
+        int getTokenID(const QString &token);
+        void addTrigrams(const QString &token, int tokenID);
+        bool findTermCandidates(const QString &term, QBitArray &candidates) const;
+        void markPostings(int tokenID, QBitArray &candidates) const;
+        bool needsCompaction() const;
+
+    private:
+        QHash<ArtworkMetadata *, int> m_SlotsHash;
+        std::vector<IndexedArtwork> m_Slots;
+        std::vector<int> m_FreeSlots;
+        // case folded token -> token id
+        QHash<QString, int> m_TokenIDs;
+        std::vector<QString> m_Tokens;
+        // token id -> slots (might contain stale entries until compaction)
+        std::vector<std::vector<int> > m_Postings;
+        // packed trigram -> ids of tokens containing it
+        QHash<quint64, std::vector<int> > m_Trigrams;
+        qint64 m_PostingsCount;
+        qint64 m_LivePostingsCount;
+        quint32 m_Generation;
+        QBitArray m_Candidates;
+        QString m_CandidatesTerm;
+        bool m_CandidatesUseAnd;
+        bool m_HasCandidates;
+    };
+}
+
+#endif // SEARCHINDEX_H
@@ -41,6 +41,7 @@
 #define DEFAULT_KEYWORD_SIZE_SCALE 1.0
 #define DEFAULT_DISMISS_DURATION 10
 #define DEFAULT_MAX_PARALLEL_UPLOADS 2
+#define DEFAULT_MAX_METADATA_THREADS 4
 #define DEFAULT_FIT_SMALL_PREVIEW false
 #define DEFAULT_SEARCH_USING_AND true
 #define DEFAULT_SCROLL_SPEED_SCALE 1.0
@@ -79,6 +80,7 @@ namespace Models {
         m_UploadTimeout(DEFAULT_UPLOAD_TIMEOUT),
         m_DismissDuration(DEFAULT_DISMISS_DURATION),
         m_MaxParallelUploads(DEFAULT_MAX_PARALLEL_UPLOADS),
+        m_MaxMetadataThreads(DEFAULT_MAX_METADATA_THREADS),
         m_SelectedThemeIndex(DEFAULT_SELECTED_THEME_INDEX),
         m_SelectedDictIndex(DEFAULT_SELECTED_DICT_INDEX),
         m_MustUseMasterPassword(DEFAULT_USE_MASTERPASSWORD),
@@ -141,6 +143,7 @@ namespace Models {
         appSettings.setValue(appSettings.getKeywordSizeScaleKey(), m_KeywordSizeScale);
         appSettings.setValue(appSettings.getDismissDurationKey(), m_DismissDuration);
         appSettings.setValue(appSettings.getMaxParallelUploadsKey(), m_MaxParallelUploads);
+        appSettings.setValue(appSettings.getMaxMetadataThreadsKey(), m_MaxMetadataThreads);
         appSettings.setValue(appSettings.getFitSmallPreviewKey(), m_FitSmallPreview);
         appSettings.setValue(appSettings.getSearchUsingAndKey(), m_SearchUsingAnd);
         appSettings.setValue(appSettings.getScrollSpeedScaleKey(), m_ScrollSpeedScale);
@@ -206,6 +209,7 @@ namespace Models {
         setKeywordSizeScale(appSettings.doubleValue(appSettings.getKeywordSizeScaleKey(), DEFAULT_KEYWORD_SIZE_SCALE));
         setDismissDuration(appSettings.value(appSettings.getDismissDurationKey(), DEFAULT_DISMISS_DURATION).toInt());
         setMaxParallelUploads(appSettings.value(appSettings.getMaxParallelUploadsKey(), DEFAULT_MAX_PARALLEL_UPLOADS).toInt());
+        setMaxMetadataThreads(appSettings.value(appSettings.getMaxMetadataThreadsKey(), DEFAULT_MAX_METADATA_THREADS).toInt());
         setFitSmallPreview(appSettings.boolValue(appSettings.getFitSmallPreviewKey(), DEFAULT_FIT_SMALL_PREVIEW));
         setSearchUsingAnd(appSettings.boolValue(appSettings.getSearchUsingAndKey(), DEFAULT_SEARCH_USING_AND));
         setScrollSpeedScale(appSettings.doubleValue(appSettings.getScrollSpeedScaleKey(), DEFAULT_SCROLL_SPEED_SCALE));
@@ -240,6 +244,7 @@ namespace Models {
         setKeywordSizeScale(DEFAULT_KEYWORD_SIZE_SCALE);
         setDismissDuration(DEFAULT_DISMISS_DURATION);
         setMaxParallelUploads(DEFAULT_MAX_PARALLEL_UPLOADS);
+        setMaxMetadataThreads(DEFAULT_MAX_METADATA_THREADS);
         setFitSmallPreview(DEFAULT_FIT_SMALL_PREVIEW);
         setSearchUsingAnd(DEFAULT_SEARCH_USING_AND);
         setScrollSpeedScale(DEFAULT_SCROLL_SPEED_SCALE);
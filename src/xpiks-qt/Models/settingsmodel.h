@@ -46,6 +46,7 @@ namespace Models {
         Q_PROPERTY(double keywordSizeScale READ getKeywordSizeScale WRITE setKeywordSizeScale NOTIFY keywordSizeScaleChanged)
         Q_PROPERTY(int dismissDuration READ getDismissDuration WRITE setDismissDuration NOTIFY dismissDurationChanged)
         Q_PROPERTY(int maxParallelUploads READ getMaxParallelUploads WRITE setMaxParallelUploads NOTIFY maxParallelUploadsChanged)
+        Q_PROPERTY(int maxMetadataThreads READ getMaxMetadataThreads WRITE setMaxMetadataThreads NOTIFY maxMetadataThreadsChanged)
         Q_PROPERTY(bool fitSmallPreview READ getFitSmallPreview WRITE setFitSmallPreview NOTIFY fitSmallPreviewChanged)
         Q_PROPERTY(bool searchUsingAnd READ getSearchUsingAnd WRITE setSearchUsingAnd NOTIFY searchUsingAndChanged)
         Q_PROPERTY(double scrollSpeedScale READ getScrollSpeedScale WRITE setScrollSpeedScale NOTIFY scrollSpeedScaleChanged)
@@ -99,6 +100,7 @@ namespace Models {
         double getKeywordSizeScale() const { return m_KeywordSizeScale; }
         int getDismissDuration() const { return m_DismissDuration; }
         int getMaxParallelUploads() const { return m_MaxParallelUploads; }
+        int getMaxMetadataThreads() const { return m_MaxMetadataThreads; }
         bool getFitSmallPreview() const { return m_FitSmallPreview; }
         bool getSearchUsingAnd() const { return m_SearchUsingAnd; }
         double getScrollSpeedScale() const { return m_ScrollSpeedScale; }
@@ -132,6 +134,7 @@ namespace Models {
         void keywordSizeScaleChanged(double value);
         void dismissDurationChanged(int value);
         void maxParallelUploadsChanged(int value);
+        void maxMetadataThreadsChanged(int value);
         void fitSmallPreviewChanged(bool value);
         void searchUsingAndChanged(bool value);
         void scrollSpeedScaleChanged(double value);
@@ -219,6 +222,14 @@ namespace Models {
             emit maxParallelUploadsChanged(m_MaxParallelUploads);
         }
 
+        void setMaxMetadataThreads(int value) {
+            if (m_MaxMetadataThreads == value)
+                return;
+
+            m_MaxMetadataThreads = ensureInBounds(value, 1, 16);
+            emit maxMetadataThreadsChanged(m_MaxMetadataThreads);
+        }
+
         void setFitSmallPreview(bool value) {
             if (m_FitSmallPreview == value)
                 return;
@@ -366,6 +377,7 @@ namespace Models {
         int m_UploadTimeout; // in seconds
         int m_DismissDuration;
         int m_MaxParallelUploads;
+        int m_MaxMetadataThreads;
         int m_SelectedThemeIndex;
         int m_SelectedDictIndex;
         bool m_MustUseMasterPassword;
@@ -0,0 +1,80 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spellcheckbatch.h"
+#include "spellcheckitem.h"
+
+namespace SpellCheck {
+    SpellCheckBatch::SpellCheckBatch(const std::vector<std::shared_ptr<ISpellCheckItem> > &batch):
+        m_TotalWordsCount(0)
+    {
+        m_Items.reserve(batch.size());
+
+        for (auto &batchItem: batch) {
+            std::shared_ptr<SpellCheckItem> item = std::dynamic_pointer_cast<SpellCheckItem>(batchItem);
+            Q_ASSERT(item);
+            if (!item) { continue; }
+
+            auto &queryItems = item->getQueries();
+            m_Items.push_back(item);
+
+            for (auto &queryItem: queryItems) {
+                const QString &word = queryItem->m_Word;
+                if (!m_WordsIndices.contains(word)) {
+                    m_WordsIndices.insert(word, m_WordsToCheck.size());
+                    m_WordsToCheck.append(word);
+                }
+            }
+
+            m_TotalWordsCount += (int)queryItems.size();
+        }
+
+        // detached once here so concurrent writes do not copy
+        m_Verdicts.fill(1, m_WordsToCheck.size());
+    }
+
+    void SpellCheckBatch::fanOutVerdicts() {
+        for (auto &item: m_Items) {
+            auto &queryItems = item->getQueries();
+
+            size_t size = queryItems.size();
+            for (size_t i = 0; i < size; ++i) {
+                auto &queryItem = queryItems.at(i);
+                const bool isOk = m_Verdicts.at(m_WordsIndices.value(queryItem->m_Word)) != 0;
+                queryItem->m_IsCorrect = isOk;
+                item->accountResultAt((int)i);
+            }
+        }
+    }
+
+    QStringList SpellCheckBatch::getWrongWords() const {
+        QStringList wrongWords;
+
+        const int wordsCount = m_WordsToCheck.size();
+        for (int i = 0; i < wordsCount; ++i) {
+            if (m_Verdicts.at(i) == 0) {
+                wrongWords.append(m_WordsToCheck.at(i));
+            }
+        }
+
+        return wrongWords;
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPELLCHECKBATCH_H
+#define SPELLCHECKBATCH_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QVector>
+#include <vector>
+#include <memory>
+
+namespace SpellCheck {
+    class ISpellCheckItem;
+    class SpellCheckItem;
+
+    // same keywords are repeated in many artworks so every word of the batch
+    // is checked only once and the verdict is fanned out to all query items
+    class SpellCheckBatch
+    {
+    public:
+        SpellCheckBatch(const std::vector<std::shared_ptr<ISpellCheckItem> > &batch);
+
+    public:
+        const QVector<QString> &getWordsToCheck() const { return m_WordsToCheck; }
+        const std::vector<std::shared_ptr<SpellCheckItem> > &getItems() const { return m_Items; }
+        int getTotalWordsCount() const { return m_TotalWordsCount; }
+
+    public:
+        // can be called concurrently for different words
+        void setVerdict(int wordIndex, bool isCorrect) { m_Verdicts[wordIndex] = isCorrect ? 1 : 0; }
+        void fanOutVerdicts();
+        QStringList getWrongWords() const;
+
+    private:
+        std::vector<std::shared_ptr<SpellCheckItem> > m_Items;
+        QHash<QString, int> m_WordsIndices;
+        QVector<QString> m_WordsToCheck;
+        QVector<char> m_Verdicts;
+        int m_TotalWordsCount;
+    };
+}
+
+#endif // SPELLCHECKBATCH_H
@@ -21,7 +21,9 @@
 
 #include "spellcheckerservice.h"
 #include "../Models/artworkmetadata.h"
+#include <QThread>
 #include "spellcheckworker.h"
+#include "suggestionsworker.h"
 #include "spellcheckitem.h"
 #include "../Common/defines.h"
 #include "../Common/flags.h"
@@ -29,6 +31,8 @@
 namespace SpellCheck {
     SpellCheckerService::SpellCheckerService():
         m_SpellCheckWorker(NULL),
+        m_SuggestionsWorker(NULL),
+        m_SuggestionsThread(NULL),
         m_RestartRequired(false)
     {}
 
@@ -72,12 +76,52 @@ namespace SpellCheck {
         QObject::connect(m_SpellCheckWorker, SIGNAL(userDictCleared()),
                          this, SIGNAL(userDictCleared()));
 
+        startSuggestionsWorker();
+
         LOG_DEBUG << "starting thread...";
         thread->start();
 
         emit serviceAvailable(m_RestartRequired);
     }
 
+    void SpellCheckerService::startSuggestionsWorker() {
+        Q_ASSERT(m_SuggestionsWorker == NULL);
+
+        m_SuggestionsWorker = new SuggestionsWorker();
+        m_SuggestionsThread = new QThread();
+        m_SuggestionsWorker->moveToThread(m_SuggestionsThread);
+
+        QObject::connect(m_SuggestionsThread, SIGNAL(started()), m_SuggestionsWorker, SLOT(process()));
+        // quit() should not wait for an event loop of a thread that may be blocked
+        QObject::connect(m_SuggestionsWorker, SIGNAL(stopped()),
+                         m_SuggestionsThread, SLOT(quit()), Qt::DirectConnection);
+        // spellcheck worker submits words until its own loop exits
+        QObject::connect(m_SpellCheckWorker, SIGNAL(stopped()),
+                         m_SuggestionsWorker, SLOT(cancel()), Qt::DirectConnection);
+
+        m_SpellCheckWorker->setSuggestionsWorker(m_SuggestionsWorker);
+
+        LOG_DEBUG << "starting suggestions thread...";
+        m_SuggestionsThread->start(QThread::LowPriority);
+    }
+
+    void SpellCheckerService::stopSuggestionsWorker() {
+        if (m_SuggestionsWorker == NULL) { return; }
+
+        LOG_DEBUG << "#";
+
+        m_SuggestionsWorker->stopWorking();
+        m_SuggestionsThread->quit();
+        // at most one suggestion and cache write are left
+        m_SuggestionsThread->wait();
+
+        delete m_SuggestionsThread;
+        delete m_SuggestionsWorker;
+
+        m_SuggestionsThread = NULL;
+        m_SuggestionsWorker = NULL;
+    }
+
     void SpellCheckerService::stopService() {
         LOG_DEBUG << "#";
         if (m_SpellCheckWorker != NULL) {
@@ -178,7 +222,11 @@ namespace SpellCheck {
             return QStringList();
         }
 
-        return m_SpellCheckWorker->retrieveCorrections(word);
+        if (m_SuggestionsWorker == NULL) {
+            return QStringList();
+        }
+
+        return m_SuggestionsWorker->retrieveSuggestions(word);
     }
 
     void SpellCheckerService::restartWorker() {
@@ -205,7 +253,7 @@ namespace SpellCheck {
 
 #ifdef INTEGRATION_TESTS
     int SpellCheckerService::getSuggestionsCount() {
-        return m_SpellCheckWorker->getSuggestionsCount();
+        return (m_SuggestionsWorker != NULL) ? m_SuggestionsWorker->getSuggestionsCount() : 0;
     }
 #endif
 
@@ -254,6 +302,9 @@ namespace SpellCheck {
         LOG_DEBUG << "#";
         m_SpellCheckWorker = NULL;
 
+        // spellcheck worker is gone so nobody uses suggestions worker anymore
+        stopSuggestionsWorker();
+
         if (m_RestartRequired) {
             LOG_INFO << "Restarting worker...";
             startService();
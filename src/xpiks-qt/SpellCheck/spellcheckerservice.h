@@ -33,8 +33,11 @@ namespace Models {
     class ArtworkMetadata;
 }
 
+class QThread;
+
 namespace SpellCheck {
     class SpellCheckWorker;
+    class SuggestionsWorker;
 
     class SpellCheckerService:
         public QObject,
@@ -92,8 +95,14 @@ namespace SpellCheck {
         void workerDestroyed(QObject *object);
         void wordsNumberChangedHandler(int number);
 
+    private:
+        void startSuggestionsWorker();
+        void stopSuggestionsWorker();
+
     private:
         SpellCheckWorker *m_SpellCheckWorker;
+        SuggestionsWorker *m_SuggestionsWorker;
+        QThread *m_SuggestionsThread;
         volatile bool m_RestartRequired;
         QString m_DictionariesPath;
     };
@@ -73,16 +73,13 @@ namespace SpellCheck {
 
     protected:
         SpellCheckItemBase():
-            QObject(),
-            m_NeedsSuggestions(false) {}
+            QObject() {}
 
     public:
         const std::vector<std::shared_ptr<SpellCheckQueryItem> > &getQueries() const { return m_QueryItems; }
         const QHash<QString, bool> &getHash() const { return m_SpellCheckResults; }
         virtual void submitSpellCheckResult() = 0;
 
-        bool needsSuggestions() const { return m_NeedsSuggestions; }
-        void requestSuggestions() { m_NeedsSuggestions = true; }
         void accountResultAt(int index);
         bool getIsCorrect(const QString &word) const;
 
@@ -93,7 +90,6 @@ namespace SpellCheck {
     private:
         std::vector<std::shared_ptr<SpellCheckQueryItem> > m_QueryItems;
         QHash<QString, bool> m_SpellCheckResults;
-        volatile bool m_NeedsSuggestions;
     };
 
     class SpellCheckSeparatorItem:
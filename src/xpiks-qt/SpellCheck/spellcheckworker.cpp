@@ -25,40 +25,52 @@
 #include <QTextStream>
 #include <QTextCodec>
 #include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
 #include <QUrl>
 #include <QCoreApplication>
 #include <QStandardPaths>
 #include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
 #include "../Helpers/appsettings.h"
 #include "spellcheckitem.h"
+#include "spellcheckbatch.h"
+#include "suggestionsworker.h"
 #include "../Common/defines.h"
 #include <hunspell/hunspell.hxx>
 
 #define EN_HUNSPELL_DIC "en_US.dic"
 #define EN_HUNSPELL_AFF "en_US.aff"
 
+// every instance holds its own copy of the dictionary
+#define MAX_HUNSPELL_INSTANCES 4
+#define SPELLCHECK_BATCH_SIZE 256
+
 namespace SpellCheck {
     SpellCheckWorker::SpellCheckWorker(QObject *parent):
         QObject(parent),
-        m_Hunspell(NULL),
+        m_CheckersPool(NULL),
+        m_SuggestionsWorker(NULL),
         m_Codec(NULL),
         m_UserDictionaryPath("")
     {}
 
     SpellCheckWorker::~SpellCheckWorker() {
-        if (m_Hunspell != NULL) {
-            delete m_Hunspell;
+        if (m_CheckersPool != NULL) {
+            m_CheckersPool->waitForDone();
+            delete m_CheckersPool;
+        }
+
+        for (Hunspell *hunspell: m_Hunspells) {
+            delete hunspell;
         }
 
         LOG_INFO << "destroyed";
     }
 
-    bool SpellCheckWorker::initWorker() {
-        LOG_INFO << "#";
-
+    bool SpellCheckWorker::locateDictionaries(QString &affPath, QString &dicPath, QString &dictionarySignature) {
         QString resourcesPath;
-        QString affPath;
-        QString dicPath;
 
 #if !defined(Q_OS_LINUX)
         resourcesPath = QCoreApplication::applicationDirPath();
@@ -91,28 +103,65 @@ namespace SpellCheck {
 
 #endif
 
-        bool initResult = false;
+        if (!QFileInfo(affPath).exists() || !QFileInfo(dicPath).exists()) {
+            LOG_WARNING << "DIC or AFF file not found." << dicPath << "||" << affPath;
+            return false;
+        }
+
+        // cached suggestions are valid only for the same dictionary
+        QFileInfo dicInfo(dicPath);
+        dictionarySignature = QString("%1:%2:%3")
+                .arg(dicInfo.fileName())
+                .arg(dicInfo.size())
+                .arg(dicInfo.lastModified().toMSecsSinceEpoch());
 
-        if (QFileInfo(affPath).exists() && QFileInfo(dicPath).exists()) {
 #ifdef Q_OS_WIN
-            // specific Hunspell handling of UTF-8 encoded pathes
-            affPath = "\\\\?\\" + QDir::toNativeSeparators(affPath);
-            dicPath = "\\\\?\\" + QDir::toNativeSeparators(dicPath);
+        // specific Hunspell handling of UTF-8 encoded pathes
+        affPath = "\\\\?\\" + QDir::toNativeSeparators(affPath);
+        dicPath = "\\\\?\\" + QDir::toNativeSeparators(dicPath);
 #endif
 
+        return true;
+    }
+
+    bool SpellCheckWorker::initWorker() {
+        LOG_INFO << "#";
+
+        QString affPath;
+        QString dicPath;
+        QString dictionarySignature;
+
+        bool initResult = false;
+
+        if (locateDictionaries(affPath, dicPath, dictionarySignature)) {
+            const int instancesCount = qMin(qMax(QThread::idealThreadCount(), 1), MAX_HUNSPELL_INSTANCES);
+
             try {
-                m_Hunspell = new Hunspell(affPath.toUtf8().constData(),
-                                          dicPath.toUtf8().constData());
+                for (int i = 0; i < instancesCount; ++i) {
+                    Hunspell *hunspell = new Hunspell(affPath.toUtf8().constData(),
+                                                      dicPath.toUtf8().constData());
+                    m_Hunspells.push_back(hunspell);
+                }
+
                 LOG_DEBUG << "Hunspell initialized with AFF" << affPath << "and DIC" << dicPath;
+                LOG_INFO << "Using" << m_Hunspells.size() << "Hunspell instance(s)";
                 initResult = true;
-                m_Encoding = QString::fromLatin1(m_Hunspell->get_dic_encoding());
+                m_Encoding = QString::fromLatin1(m_Hunspells.front()->get_dic_encoding());
                 m_Codec = QTextCodec::codecForName(m_Encoding.toLatin1().constData());
             } catch (...) {
                 LOG_DEBUG << "Error in Hunspell with AFF" << affPath << "and DIC" << dicPath;
-                m_Hunspell = NULL;
+                // keep already created instances if any
+                initResult = !m_Hunspells.empty();
+                if (initResult) {
+                    m_Encoding = QString::fromLatin1(m_Hunspells.front()->get_dic_encoding());
+                    m_Codec = QTextCodec::codecForName(m_Encoding.toLatin1().constData());
+                }
+            }
+
+            if (m_Hunspells.size() > 1) {
+                m_CheckersPool = new QThreadPool();
+                m_CheckersPool->setMaxThreadCount((int)m_Hunspells.size() - 1);
             }
-        } else {
-            LOG_WARNING << "DIC or AFF file not found." << dicPath << "||" << affPath;
         }
 
         initUserDictionary();
@@ -120,13 +169,25 @@ namespace SpellCheck {
         return initResult;
     }
 
+    void SpellCheckWorker::prefetchSuggestions(const QStringList &wrongWords) {
+        if ((m_SuggestionsWorker != NULL) && !wrongWords.isEmpty()) {
+            m_SuggestionsWorker->prefetchSuggestions(wrongWords);
+        }
+    }
+
+    void SpellCheckWorker::workerStopped() {
+        m_UserDictionary.close();
+
+        emit stopped();
+    }
+
     void SpellCheckWorker::processOneItem(std::shared_ptr<ISpellCheckItem> &item) {
         auto separatorItem = std::dynamic_pointer_cast<SpellCheckSeparatorItem>(item);
         auto queryItem = std::dynamic_pointer_cast<SpellCheckItem>(item);
         auto addWordItem = std::dynamic_pointer_cast<ModifyUserDictItem>(item);
 
         if (queryItem) {
-            processQueryItem(queryItem);
+            processQueryItems(queryItem);
         } else if (separatorItem) {
             processSeparatorItem(separatorItem);
         } else if (addWordItem) {
@@ -136,36 +197,110 @@ namespace SpellCheck {
 
     void SpellCheckWorker::processSeparatorItem(std::shared_ptr<SpellCheckSeparatorItem> &item) {
         Q_UNUSED(item);
+        LOG_DEBUG << "Verdict cache hit rate:" << m_VerdictCache.getHitRate() << "size:" << m_VerdictCache.size();
         emit queueIsEmpty();
     }
 
-    void SpellCheckWorker::processQueryItem(std::shared_ptr<SpellCheckItem> &item) {
-        bool neededSuggestions = item->needsSuggestions();
-        auto &queryItems = item->getQueries();
-        bool anyWrong = false;
-
-        if (!neededSuggestions) {
-            size_t size = queryItems.size();
-            for (size_t i = 0; i < size; ++i) {
-                auto &queryItem = queryItems.at(i);
-                bool isOk = checkWordSpelling(queryItem);
-                item->accountResultAt((int)i);
-                anyWrong = anyWrong || !isOk;
-            }
+    void SpellCheckWorker::processQueryItems(std::shared_ptr<SpellCheckItem> &firstItem) {
+        std::vector<std::shared_ptr<ISpellCheckItem> > batch;
+        batch.push_back(firstItem);
 
-            item->submitSpellCheckResult();
+        // separators and user dictionary changes are processed in order after the batch
+        // worker loop notifies about empty queue once the whole batch is done
+        takeQueuedItems(batch, SPELLCHECK_BATCH_SIZE,
+                        [](const std::shared_ptr<ISpellCheckItem> &item) {
+            return std::dynamic_pointer_cast<SpellCheckItem>(item).get() != nullptr;
+        });
+
+        if (batch.size() == 1) {
+            processQueryItem(firstItem, m_Hunspells.front());
         } else {
-            for (auto &queryItem: queryItems) {
-                if (!queryItem->m_IsCorrect) {
-                    findSuggestions(queryItem->m_Word);
-                }
+            processQueryItemsBatch(batch);
+        }
+    }
+
+    void SpellCheckWorker::processQueryItemsBatch(const std::vector<std::shared_ptr<ISpellCheckItem> > &batch) {
+        SpellCheckBatch checkBatch(batch);
+        const QVector<QString> &wordsToCheck = checkBatch.getWordsToCheck();
+
+        processWords(wordsToCheck, [this, &checkBatch](const QString &word, int index, Hunspell *hunspell) {
+            checkBatch.setVerdict(index, getWordVerdict(word, hunspell));
+        });
+
+        LOG_DEBUG << "Checked" << wordsToCheck.size() << "unique of" << checkBatch.getTotalWordsCount() << "word(s) in" << checkBatch.getItems().size() << "item(s)";
+
+        if (isCancelled()) { return; }
+
+        checkBatch.fanOutVerdicts();
+
+        // helpers only fill verdicts so results are submitted from the worker thread
+        for (auto &item: checkBatch.getItems()) {
+            item->submitSpellCheckResult();
+        }
+
+        prefetchSuggestions(checkBatch.getWrongWords());
+    }
+
+    void SpellCheckWorker::processWords(const QVector<QString> &words,
+                                        const std::function<void (const QString &, int, Hunspell *)> &action) {
+        if (words.isEmpty()) { return; }
+
+        WordsQueue queue(words);
+        const int helpersCount = (m_CheckersPool == NULL) ? 0 : (qMin((int)m_Hunspells.size(), words.size()) - 1);
+        QVector<QFuture<void> > helpers;
+        helpers.reserve(helpersCount);
+
+        for (int i = 1; i <= helpersCount; ++i) {
+            Hunspell *hunspell = m_Hunspells.at(i);
+            helpers.append(QtConcurrent::run(m_CheckersPool, [this, &queue, hunspell, &action]() {
+                processWordsFromQueue(queue, hunspell, action);
+            }));
+        }
+
+        processWordsFromQueue(queue, m_Hunspells.front(), action);
+
+        for (auto &helper: helpers) {
+            helper.waitForFinished();
+        }
+    }
+
+    void SpellCheckWorker::processWordsFromQueue(WordsQueue &queue, Hunspell *hunspell,
+                                                 const std::function<void (const QString &, int, Hunspell *)> &action) {
+        QString word;
+        int index;
+
+        while (queue.tryGetNext(word, index)) {
+            if (isCancelled()) { break; }
+
+            try {
+                action(word, index, hunspell);
+            } catch (...) {
+                LOG_WARNING << "Exception while processing word!";
             }
+
+            queue.markProcessed();
         }
+    }
 
-        if (anyWrong) {
-            item->requestSuggestions();
-            this->submitItem(item);
+    void SpellCheckWorker::processQueryItem(std::shared_ptr<SpellCheckItem> &item, Hunspell *hunspell) {
+        auto &queryItems = item->getQueries();
+        QStringList wrongWords;
+
+        size_t size = queryItems.size();
+        for (size_t i = 0; i < size; ++i) {
+            auto &queryItem = queryItems.at(i);
+            bool isOk = checkWordSpelling(queryItem, hunspell);
+            item->accountResultAt((int)i);
+
+            if (!isOk) {
+                wrongWords.append(queryItem->m_Word);
+            }
         }
+
+        item->submitSpellCheckResult();
+
+        // suggestions are generated without blocking next items
+        prefetchSuggestions(wrongWords);
     }
 
     void SpellCheckWorker::processChangeUserDict(std::shared_ptr<ModifyUserDictItem> &item) {
@@ -189,145 +324,86 @@ namespace SpellCheck {
         signalUserDictWordsCount();
     }
 
-    QStringList SpellCheckWorker::retrieveCorrections(const QString &word) {
-        QReadLocker locker(&m_SuggestionsLock);
-        QStringList result;
-
-        auto it = m_Suggestions.find(word);
-        if (it != m_Suggestions.end()) {
-            result = it.value();
-        }
-
-        return result;
-    }
-
-    QStringList SpellCheckWorker::suggestCorrections(const QString &word) {
-        QStringList suggestions;
-        char **suggestWordList = NULL;
-
-        try {
-            // Encode from Unicode to the encoding used by current dictionary
-            int count = m_Hunspell->suggest(&suggestWordList, m_Codec->fromUnicode(word).constData());
-            LOG_INTEGRATION_TESTS << "Found" << count << "suggestions for" << word;
-            QString lowerWord = word.toLower();
-
-            for (int i = 0; i < count; ++i) {
-                QString suggestion = m_Codec->toUnicode(suggestWordList[i]);
-
-                if (suggestion.toLower() != lowerWord) {
-                    suggestions << suggestion;
-                }
-
-                free(suggestWordList[i]);
-            }
-        } catch (...) {
-            LOG_WARNING << "Error for keyword:" << word;
-        }
-        return suggestions;
-    }
-
-    bool SpellCheckWorker::checkWordSpelling(const std::shared_ptr<SpellCheckQueryItem> &queryItem) {
+    bool SpellCheckWorker::checkWordSpelling(const std::shared_ptr<SpellCheckQueryItem> &queryItem, Hunspell *hunspell) {
         bool isOk = false;
 
-        const QString &word = queryItem->m_Word;
-        const bool isInUserDict = m_UserDictionary.contains(word);
-
-        isOk = isInUserDict || checkWordSpelling(word);
+        isOk = getWordVerdict(queryItem->m_Word, hunspell);
         queryItem->m_IsCorrect = isOk;
 
         return isOk;
     }
 
-    bool SpellCheckWorker::checkWordSpelling(const QString &word) {
+    bool SpellCheckWorker::getWordVerdict(const QString &word, Hunspell *hunspell) {
         bool isOk = false;
 
-        const bool isCached = m_WrongWords.contains(word);
+        if (!m_VerdictCache.tryGetVerdict(word, isOk)) {
+            // user dictionary is modified only between batches
+            const bool isInUserDict = m_UserDictionary.contains(word);
 
-        if (!isCached) {
-            isOk = isHunspellSpellingCorrect(word);
+            isOk = isInUserDict || checkWordSpelling(word, hunspell);
+            m_VerdictCache.storeVerdict(word, isOk);
+        }
 
-            if (!isOk) {
-                QString capitalized = word;
-                capitalized[0] = capitalized[0].toUpper();
+        return isOk;
+    }
 
-                if (isHunspellSpellingCorrect(capitalized)) {
-                    isOk = true;
-                }
-            }
-        }
+    bool SpellCheckWorker::checkWordSpelling(const QString &word, Hunspell *hunspell) {
+        bool isOk = isHunspellSpellingCorrect(word, hunspell);
 
         if (!isOk) {
-            m_WrongWords.insert(word);
+            QString capitalized = word;
+            capitalized[0] = capitalized[0].toUpper();
+
+            if (isHunspellSpellingCorrect(capitalized, hunspell)) {
+                isOk = true;
+            }
         }
 
         return isOk;
     }
 
-    bool SpellCheckWorker::isHunspellSpellingCorrect(const QString &word) const {
+    bool SpellCheckWorker::isHunspellSpellingCorrect(const QString &word, Hunspell *hunspell) const {
         bool isOk = false;
 
         try {
-            isOk = m_Hunspell->spell(m_Codec->fromUnicode(word).constData()) != 0;
+            isOk = hunspell->spell(m_Codec->fromUnicode(word).constData()) != 0;
         } catch (...) {
             isOk = false;
         }
         return isOk;
     }
 
-    void SpellCheckWorker::findSuggestions(const QString &word) {
-        LOG_INTEGRATION_TESTS << word;
-        bool needsCorrections = false;
-
-        m_SuggestionsLock.lockForRead();
-        needsCorrections = !m_Suggestions.contains(word);
-        m_SuggestionsLock.unlock();
-
-        if (needsCorrections) {
-            QStringList suggestions = suggestCorrections(word);
-            m_SuggestionsLock.lockForWrite();
-            m_Suggestions.insert(word, suggestions);
-            m_SuggestionsLock.unlock();
-        }
-    }
-
     void SpellCheckWorker::initUserDictionary() {
         LOG_DEBUG << "#";
         QString appDataPath = XPIKS_USERDATA_PATH;
         QDir dir(appDataPath);
 
-        m_UserDictionaryPath = dir.filePath(QLatin1String(Constants::USER_DICT_FILENAME));
-        QFile userDictonaryFile(m_UserDictionaryPath);
+        m_UserDictionaryPath = dir.filePath(QLatin1String(Constants::USER_DICT_JOURNAL_FILENAME));
+        m_UserDictionary.setPaths(dir.filePath(QLatin1String(Constants::USER_DICT_COMPILED_FILENAME)),
+                                  m_UserDictionaryPath);
 
-        if (userDictonaryFile.open(QIODevice::ReadOnly)) {
-            QTextStream stream(&userDictonaryFile);
-            for (QString word = stream.readLine(); !word.isEmpty(); word = stream.readLine()) {
-                m_UserDictionary.addWord(word);
+        if (!m_UserDictionary.load()) {
+            // dictionary from previous versions is a plain list of words
+            QString textDictionaryPath = dir.filePath(QLatin1String(Constants::USER_DICT_FILENAME));
+            if (QFileInfo(textDictionaryPath).exists()) {
+                m_UserDictionary.importWords(textDictionaryPath);
             }
+        }
 
-            signalUserDictWordsCount();
-            if (!m_UserDictionary.empty()) {
-                emit userDictUpdate(m_UserDictionary.getWords(), false);
-            }
-        } else {
-            LOG_WARNING << "Cannot open" << m_UserDictionaryPath;
+        signalUserDictWordsCount();
+        if (!m_UserDictionary.empty()) {
+            emit userDictUpdate(m_UserDictionary.getWords(), false);
         }
 
         LOG_INFO << "User Dictionary contains:" << m_UserDictionary.size() << "item(s)";
     }
 
-
     void SpellCheckWorker::cleanUserDict() {
         LOG_DEBUG << "#";
 
+        m_VerdictCache.invalidate(m_UserDictionary.getWords());
         m_UserDictionary.clear();
         emit userDictCleared();
-
-        QFile userDictonaryFile(m_UserDictionaryPath);
-        if (userDictonaryFile.open(QIODevice::ReadWrite)) {
-            userDictonaryFile.resize(0);
-        } else {
-            LOG_INFO << "Unable to trunkate user dictionary file:" << m_UserDictionaryPath;
-        }
     }
 
     void SpellCheckWorker::changeUserDict(const QStringList &words, bool overwrite) {
@@ -336,7 +412,7 @@ namespace SpellCheck {
         QStringList wordsToAdd;
 
         for (auto &word: words) {
-            const bool isOk = checkWordSpelling(word);
+            const bool isOk = checkWordSpelling(word, m_Hunspells.front());
             if (overwrite || !isOk) {
                 wordsToAdd.append(word);
             }
@@ -345,24 +421,16 @@ namespace SpellCheck {
         LOG_INTEGRATION_TESTS << "Real words to add:" << wordsToAdd;
 
         if (overwrite) {
-            m_UserDictionary.clear();
+            m_VerdictCache.invalidate(m_UserDictionary.getWords());
+            // only changed words are written to the journal
+            m_UserDictionary.reset(wordsToAdd);
+        } else {
+            m_UserDictionary.addWords(wordsToAdd);
         }
 
-        m_UserDictionary.addWords(wordsToAdd);
+        m_VerdictCache.invalidate(wordsToAdd);
 
         emit userDictUpdate(wordsToAdd, overwrite);
-
-        QFile userDictonaryFile(m_UserDictionaryPath);
-        auto mode = overwrite? QIODevice::WriteOnly : QIODevice::Append;
-        if (userDictonaryFile.open(mode)) {
-            QTextStream stream(&userDictonaryFile);
-
-            for (const QString &word: wordsToAdd) {
-                stream << word << endl;
-            }
-        } else {
-            LOG_WARNING << "Unable to open user dictionary";
-        }
     }
 
     void SpellCheckWorker::signalUserDictWordsCount() {
@@ -27,46 +27,19 @@
 #include <QReadWriteLock>
 #include <QHash>
 #include <QSet>
+#include <vector>
 #include "../Common/itemprocessingworker.h"
+#include "../Common/sharedworkqueue.h"
 #include "spellcheckitem.h"
+#include "wordsverdictcache.h"
+#include "userdictionary.h"
 
 class Hunspell;
 class QTextCodec;
+class QThreadPool;
 
 namespace SpellCheck {
-    class UserDictionary {
-    public:
-        const QStringList &getWords() const { return m_WordsList; }
-
-        bool contains(const QString &word) const { return m_WordsSet.contains(word.toLower()); }
-
-        void addWord(const QString &word) {
-            QString wordToAdd = word.toLower();
-            if (!m_WordsSet.contains(wordToAdd)) {
-                m_WordsSet.insert(wordToAdd);
-                m_WordsList.append(word);
-            }
-        }
-
-        void addWords(const QStringList &words) {
-            foreach (const QString &word, words) {
-                addWord(word);
-            }
-        }
-
-        void reset(const QStringList &words) {
-            clear();
-            addWords(words);
-        }
-
-        void clear() { m_WordsList.clear(); m_WordsSet.clear(); }
-        bool empty() const { return m_WordsSet.isEmpty(); }
-        int size() const { return m_WordsList.size(); }
-
-    private:
-        QSet<QString> m_WordsSet;
-        QStringList m_WordsList;
-    };
+    class SuggestionsWorker;
 
     class SpellCheckWorker : public QObject, public Common::ItemProcessingWorker<ISpellCheckItem>
     {
@@ -78,21 +51,33 @@ namespace SpellCheck {
 
     public:
         const QStringList &getUserDictionary() const { return m_UserDictionary.getWords(); }
-        QStringList retrieveCorrections(const QString &word);
         int getUserDictionarySize() const { return m_UserDictionary.size(); }
+        // suggestions worker should outlive this worker
+        void setSuggestionsWorker(SuggestionsWorker *suggestionsWorker) { m_SuggestionsWorker = suggestionsWorker; }
+
+    public:
+        static bool locateDictionaries(QString &affPath, QString &dicPath, QString &dictionarySignature);
 
     protected:
         virtual bool initWorker() override;
         virtual void processOneItem(std::shared_ptr<ISpellCheckItem> &item) override;
 
     private:
+        typedef Common::SharedWorkQueue<QString> WordsQueue;
+
         void processSeparatorItem(std::shared_ptr<SpellCheckSeparatorItem> &item);
-        void processQueryItem(std::shared_ptr<SpellCheckItem> &item);
+        void processQueryItems(std::shared_ptr<SpellCheckItem> &firstItem);
+        void processQueryItemsBatch(const std::vector<std::shared_ptr<ISpellCheckItem> > &batch);
+        void processQueryItem(std::shared_ptr<SpellCheckItem> &item, Hunspell *hunspell);
+        void processWords(const QVector<QString> &words, const std::function<void (const QString &, int, Hunspell *)> &action);
+        void processWordsFromQueue(WordsQueue &queue, Hunspell *hunspell,
+                                   const std::function<void (const QString &, int, Hunspell *)> &action);
         void processChangeUserDict(std::shared_ptr<ModifyUserDictItem> &item);
+        void prefetchSuggestions(const QStringList &wrongWords);
 
     protected:
         virtual void notifyQueueIsEmpty() override { emit queueIsEmpty(); }
-        virtual void workerStopped() override { emit stopped(); }
+        virtual void workerStopped() override;
 
     public slots:
         void process() { doWork(); }
@@ -105,30 +90,28 @@ namespace SpellCheck {
         void userDictUpdate(const QStringList &keywords, bool overwritten);
         void userDictCleared();
 
-#ifdef INTEGRATION_TESTS
-    public:
-        int getSuggestionsCount() const { return m_Suggestions.count(); }
-#endif
-
     private:
         void detectAffEncoding();
-        QStringList suggestCorrections(const QString &word);
-        bool checkWordSpelling(const std::shared_ptr<SpellCheckQueryItem> &queryItem);
-        bool checkWordSpelling(const QString &word);
-        bool isHunspellSpellingCorrect(const QString &word) const;
-        void findSuggestions(const QString &word);
+        bool checkWordSpelling(const std::shared_ptr<SpellCheckQueryItem> &queryItem, Hunspell *hunspell);
+        bool getWordVerdict(const QString &word, Hunspell *hunspell);
+        bool checkWordSpelling(const QString &word, Hunspell *hunspell);
+        bool isHunspellSpellingCorrect(const QString &word, Hunspell *hunspell) const;
         void initUserDictionary();
         void cleanUserDict();
         void changeUserDict(const QStringList &words, bool overwrite);
         void signalUserDictWordsCount();
 
     private:
-        QHash<QString, QStringList> m_Suggestions;
-        QSet<QString> m_WrongWords;
+        // verdicts include user dictionary so it should be invalidated on every change
+        WordsVerdictCache m_VerdictCache;
         UserDictionary m_UserDictionary;
-        QReadWriteLock m_SuggestionsLock;
         QString m_Encoding;
-        Hunspell *m_Hunspell;
+        // Hunspell is not thread-safe so every checking thread uses its own instance
+        std::vector<Hunspell *> m_Hunspells;
+        // threads for all instances except the first one used by worker itself
+        QThreadPool *m_CheckersPool;
+        // suggestions are generated in a separate low priority thread
+        SuggestionsWorker *m_SuggestionsWorker;
         // Coded does not need destruction
         QTextCodec *m_Codec;
         QString m_UserDictionaryPath;
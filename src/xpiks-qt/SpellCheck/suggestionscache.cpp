@@ -0,0 +1,213 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "suggestionscache.h"
+#include <QDataStream>
+#include <QMutexLocker>
+#include "../Common/defines.h"
+
+#define SUGGESTIONS_JOURNAL_MAGIC 0x58504B53
+#define SUGGESTIONS_JOURNAL_VERSION 1
+#define MAX_SUGGESTIONS_RECORD_SIZE (1024*1024)
+#define COMPACTION_MIN_RECORDS 1000
+
+namespace SpellCheck {
+    static QByteArray serializeSuggestionsRecord(const QString &word, const QStringList &suggestions) {
+        QByteArray payload;
+        {
+            QDataStream out(&payload, QIODevice::WriteOnly);
+            out.setVersion(QDataStream::Qt_5_0);
+            out << word << suggestions;
+        }
+
+        return Helpers::RecordJournal::serializeRecord(payload);
+    }
+
+    // journal is bound to the dictionary via data after magic and version
+    static QByteArray serializeSuggestionsHeader(const QString &dictionarySignature) {
+        QByteArray headerData;
+        QDataStream out(&headerData, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_5_0);
+        out << dictionarySignature;
+        return headerData;
+    }
+
+    SuggestionsCache::SuggestionsCache(int maxSize):
+        // suggestions are cheap to regenerate so journal is only flushed
+        m_Journal(SUGGESTIONS_JOURNAL_MAGIC, SUGGESTIONS_JOURNAL_VERSION, MAX_SUGGESTIONS_RECORD_SIZE, false),
+        // two generations of entries
+        m_MaxGenerationSize(qMax(maxSize / 2, 1))
+    {
+    }
+
+    SuggestionsCache::~SuggestionsCache() {
+        close();
+    }
+
+    void SuggestionsCache::load(const QString &dictionarySignature) {
+        QMutexLocker journalLocker(&m_JournalLock);
+
+        m_DictionarySignature = dictionarySignature;
+        m_Journal.setHeaderData(serializeSuggestionsHeader(dictionarySignature));
+
+        if (m_Journal.getPath().isEmpty()) {
+            LOG_WARNING << "Suggestions journal path is empty. Suggestions are kept in memory";
+            return;
+        }
+
+        readJournal();
+
+        if (!m_Journal.openForAppend()) {
+            LOG_WARNING << "Failed to open suggestions journal" << m_Journal.getPath();
+        }
+
+        compactIfNeeded();
+    }
+
+    bool SuggestionsCache::tryGetSuggestions(const QString &word, QStringList &suggestions) {
+        QMutexLocker locker(&m_Lock);
+
+        auto it = m_Recent.constFind(word);
+        if (it != m_Recent.constEnd()) {
+            suggestions = it.value();
+            return true;
+        }
+
+        auto oldIt = m_Old.find(word);
+        if (oldIt == m_Old.end()) { return false; }
+
+        suggestions = oldIt.value();
+        m_Old.erase(oldIt);
+        // used again so it is moved to recent generation
+        insertUnsafe(word, suggestions);
+
+        return true;
+    }
+
+    bool SuggestionsCache::contains(const QString &word) {
+        QMutexLocker locker(&m_Lock);
+        return m_Recent.contains(word) || m_Old.contains(word);
+    }
+
+    void SuggestionsCache::insert(const QString &word, const QStringList &suggestions) {
+        m_Lock.lock();
+        {
+            insertUnsafe(word, suggestions);
+        }
+        m_Lock.unlock();
+
+        QMutexLocker journalLocker(&m_JournalLock);
+        appendRecord(word, suggestions);
+        compactIfNeeded();
+    }
+
+    int SuggestionsCache::size() {
+        QMutexLocker locker(&m_Lock);
+        return m_Recent.size() + m_Old.size();
+    }
+
+    void SuggestionsCache::close() {
+        QMutexLocker journalLocker(&m_JournalLock);
+
+        if (m_Journal.isOpen()) {
+            compactIfNeeded();
+            m_Journal.close();
+            LOG_INFO << "Suggestions journal closed with" << m_Journal.getRecordsCount() << "records";
+        }
+    }
+
+    void SuggestionsCache::insertUnsafe(const QString &word, const QStringList &suggestions) {
+        if ((m_Recent.size() >= m_MaxGenerationSize) && !m_Recent.contains(word)) {
+            LOG_DEBUG << "Evicting" << m_Old.size() << "suggestions";
+            m_Old.swap(m_Recent);
+            m_Recent.clear();
+        }
+
+        m_Recent.insert(word, suggestions);
+        m_Old.remove(word);
+    }
+
+    void SuggestionsCache::readJournal() {
+        QMutexLocker locker(&m_Lock);
+
+        Helpers::RecordJournal::ReadResult result = m_Journal.read([this](QDataStream &record) {
+            QString word;
+            QStringList suggestions;
+            record >> word >> suggestions;
+
+            insertUnsafe(word, suggestions);
+        });
+
+        if (result == Helpers::RecordJournal::JournalUnknown) {
+            LOG_INFO << "Suggestions journal is outdated. Starting from scratch";
+            m_Journal.remove();
+        } else if (result == Helpers::RecordJournal::JournalRead) {
+            LOG_INFO << "Suggestions journal read:" << (m_Recent.size() + m_Old.size()) << "entries from" << m_Journal.getRecordsCount() << "records";
+        }
+    }
+
+    bool SuggestionsCache::appendRecord(const QString &word, const QStringList &suggestions) {
+        bool success = m_Journal.appendRecords(serializeSuggestionsRecord(word, suggestions), 1);
+
+        if (!success) {
+            LOG_WARNING << "Failed to append suggestions for" << word;
+        }
+
+        return success;
+    }
+
+    void SuggestionsCache::compactIfNeeded() {
+        if (!m_Journal.isOpen()) { return; }
+
+        const int recordsCount = m_Journal.getRecordsCount();
+        const int entriesCount = size();
+        if ((recordsCount > COMPACTION_MIN_RECORDS) && (recordsCount > 2 * entriesCount)) {
+            compact();
+        }
+    }
+
+    bool SuggestionsCache::compact() {
+        QHash<QString, QStringList> oldEntries, recentEntries;
+
+        m_Lock.lock();
+        {
+            oldEntries = m_Old;
+            recentEntries = m_Recent;
+        }
+        m_Lock.unlock();
+
+        const int entriesCount = oldEntries.size() + recentEntries.size();
+        LOG_INFO << "Compacting" << m_Journal.getRecordsCount() << "records into" << entriesCount;
+
+        QByteArray records;
+        // old generation first so replay keeps recent entries in the recent one
+        QHash<QString, QStringList> *generations[] = { &oldEntries, &recentEntries };
+        for (QHash<QString, QStringList> *generation: generations) {
+            QHashIterator<QString, QStringList> it(*generation);
+            while (it.hasNext()) {
+                it.next();
+                records.append(serializeSuggestionsRecord(it.key(), it.value()));
+            }
+        }
+
+        return m_Journal.replaceRecords(records, entriesCount);
+    }
+}
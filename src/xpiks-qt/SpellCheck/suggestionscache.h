@@ -0,0 +1,71 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SUGGESTIONSCACHE_H
+#define SUGGESTIONSCACHE_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QMutex>
+#include "../Helpers/recordjournal.h"
+
+#define DEFAULT_SUGGESTIONS_CACHE_SIZE 50000
+
+namespace SpellCheck {
+    // suggestions for wrong words persisted in an append-only journal
+    // journal is bound to the dictionary it was generated with
+    // when memory limit is reached the least recently used half is evicted
+    class SuggestionsCache
+    {
+    public:
+        SuggestionsCache(int maxSize=DEFAULT_SUGGESTIONS_CACHE_SIZE);
+        virtual ~SuggestionsCache();
+
+    public:
+        void setJournalPath(const QString &filepath) { m_Journal.setPath(filepath); }
+        void load(const QString &dictionarySignature);
+        bool tryGetSuggestions(const QString &word, QStringList &suggestions);
+        bool contains(const QString &word);
+        void insert(const QString &word, const QStringList &suggestions);
+        int size();
+        void close();
+
+    private:
+        void insertUnsafe(const QString &word, const QStringList &suggestions);
+        void readJournal();
+        bool appendRecord(const QString &word, const QStringList &suggestions);
+        void compactIfNeeded();
+        bool compact();
+
+    private:
+        QMutex m_Lock;
+        // file operations are never done under the lock used for lookups
+        QMutex m_JournalLock;
+        QHash<QString, QStringList> m_Recent;
+        QHash<QString, QStringList> m_Old;
+        Helpers::RecordJournal m_Journal;
+        QString m_DictionarySignature;
+        int m_MaxGenerationSize;
+    };
+}
+
+#endif // SUGGESTIONSCACHE_H
@@ -0,0 +1,198 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "suggestionsworker.h"
+#include "spellcheckworker.h"
+#include <QDir>
+#include <QSet>
+#include <QMutexLocker>
+#include <QTextCodec>
+#include <QStandardPaths>
+#include "../Common/defines.h"
+#include "../Helpers/constants.h"
+#include <hunspell/hunspell.hxx>
+
+namespace SpellCheck {
+    SuggestionsWorker::SuggestionsWorker(QObject *parent):
+        QObject(parent),
+        m_Hunspell(NULL),
+        m_Codec(NULL)
+    {
+    }
+
+    SuggestionsWorker::~SuggestionsWorker() {
+        if (m_Hunspell != NULL) {
+            delete m_Hunspell;
+        }
+    }
+
+    bool SuggestionsWorker::tryGetSuggestions(const QString &word, QStringList &suggestions) {
+        return m_Cache.tryGetSuggestions(word, suggestions);
+    }
+
+    bool SuggestionsWorker::hasSuggestions(const QString &word) {
+        return m_Cache.contains(word);
+    }
+
+    QStringList SuggestionsWorker::retrieveSuggestions(const QString &word) {
+        QStringList suggestions;
+
+        if (!tryGetSuggestions(word, suggestions)) {
+            LOG_DEBUG << "Suggestions were not prefetched for" << word;
+            suggestions = findSuggestions(word);
+        }
+
+        return suggestions;
+    }
+
+    int SuggestionsWorker::prefetchSuggestions(const QStringList &words) {
+        std::vector<std::shared_ptr<SuggestionQueryItem> > items;
+        items.reserve(words.size());
+        QSet<QString> queuedWords;
+
+        for (auto &word: words) {
+            if (queuedWords.contains(word)) { continue; }
+
+            if (!hasSuggestions(word)) {
+                items.emplace_back(new SuggestionQueryItem(word));
+                queuedWords.insert(word);
+            }
+        }
+
+        if (!items.empty()) {
+            LOG_DEBUG << "Prefetching suggestions for" << items.size() << "word(s)";
+            submitItems(items);
+        }
+
+        return (int)items.size();
+    }
+
+    int SuggestionsWorker::getSuggestionsCount() {
+        return m_Cache.size();
+    }
+
+    bool SuggestionsWorker::initWorker() {
+        LOG_DEBUG << "#";
+
+        QString affPath, dicPath;
+        if (!SpellCheckWorker::locateDictionaries(affPath, dicPath, m_DictionarySignature)) {
+            return false;
+        }
+
+        QString appDataPath = XPIKS_USERDATA_PATH;
+        if (!appDataPath.isEmpty()) {
+            QDir appDataDir(appDataPath);
+            m_Cache.setJournalPath(appDataDir.filePath(Constants::SPELL_SUGGESTIONS_CACHE));
+        } else {
+            m_Cache.setJournalPath(Constants::SPELL_SUGGESTIONS_CACHE);
+        }
+
+        m_Cache.load(m_DictionarySignature);
+
+        bool initResult = false;
+        QMutexLocker locker(&m_HunspellLock);
+
+        try {
+            m_Hunspell = new Hunspell(affPath.toUtf8().constData(),
+                                      dicPath.toUtf8().constData());
+            QString encoding = QString::fromLatin1(m_Hunspell->get_dic_encoding());
+            m_Codec = QTextCodec::codecForName(encoding.toLatin1().constData());
+            initResult = true;
+        } catch (...) {
+            LOG_WARNING << "Error in Hunspell with AFF" << affPath << "and DIC" << dicPath;
+            if (m_Hunspell != NULL) {
+                delete m_Hunspell;
+                m_Hunspell = NULL;
+            }
+        }
+
+        return initResult;
+    }
+
+    void SuggestionsWorker::processOneItem(std::shared_ptr<SuggestionQueryItem> &item) {
+        const QString &word = item->getWord();
+
+        if (!hasSuggestions(word)) {
+            findSuggestions(word);
+        }
+    }
+
+    void SuggestionsWorker::notifyQueueIsEmpty() {
+        // every suggestion is appended to the journal when found
+    }
+
+    void SuggestionsWorker::workerStopped() {
+        m_Cache.close();
+        emit stopped();
+    }
+
+    QStringList SuggestionsWorker::findSuggestions(const QString &word) {
+        LOG_INTEGRATION_TESTS << word;
+        QStringList suggestions;
+
+        // dialog can ask for a word while worker is busy with another one
+        m_HunspellLock.lock();
+        {
+            if (!tryGetSuggestions(word, suggestions)) {
+                // empty list of not initialized dictionary must not be remembered
+                if (suggestCorrections(word, suggestions)) {
+                    m_Cache.insert(word, suggestions);
+                }
+            }
+        }
+        m_HunspellLock.unlock();
+
+        return suggestions;
+    }
+
+    bool SuggestionsWorker::suggestCorrections(const QString &word, QStringList &suggestions) {
+        if (m_Hunspell == NULL) {
+            LOG_DEBUG << "Hunspell is not available";
+            return false;
+        }
+
+        bool success = false;
+        char **suggestWordList = NULL;
+
+        try {
+            // Encode from Unicode to the encoding used by current dictionary
+            int count = m_Hunspell->suggest(&suggestWordList, m_Codec->fromUnicode(word).constData());
+            LOG_INTEGRATION_TESTS << "Found" << count << "suggestions for" << word;
+            QString lowerWord = word.toLower();
+
+            for (int i = 0; i < count; ++i) {
+                QString suggestion = m_Codec->toUnicode(suggestWordList[i]);
+
+                if (suggestion.toLower() != lowerWord) {
+                    suggestions << suggestion;
+                }
+
+                free(suggestWordList[i]);
+            }
+
+            success = true;
+        } catch (...) {
+            LOG_WARNING << "Error for keyword:" << word;
+        }
+
+        return success;
+    }
+}
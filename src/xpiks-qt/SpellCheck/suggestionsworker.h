@@ -0,0 +1,100 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SUGGESTIONSWORKER_H
+#define SUGGESTIONSWORKER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QMutex>
+#include "../Common/itemprocessingworker.h"
+#include "suggestionscache.h"
+
+class Hunspell;
+class QTextCodec;
+
+namespace SpellCheck {
+    class SuggestionQueryItem {
+    public:
+        SuggestionQueryItem(const QString &word):
+            m_Word(word)
+        {}
+
+        const QString &getWord() const { return m_Word; }
+
+    private:
+        QString m_Word;
+    };
+
+    // generates suggestions for wrong words in background
+    // so spell checking never waits for slow Hunspell::suggest()
+    class SuggestionsWorker : public QObject, public Common::ItemProcessingWorker<SuggestionQueryItem>
+    {
+        Q_OBJECT
+    public:
+        SuggestionsWorker(QObject *parent=0);
+        virtual ~SuggestionsWorker();
+
+    public:
+        bool tryGetSuggestions(const QString &word, QStringList &suggestions);
+        bool hasSuggestions(const QString &word);
+        // blocks if suggestions were not prefetched yet
+        QStringList retrieveSuggestions(const QString &word);
+        // returns number of words queued for suggestions
+        int prefetchSuggestions(const QStringList &words);
+        int getSuggestionsCount();
+
+#ifdef CORE_TESTS
+    public:
+        SuggestionsCache &getCache() { return m_Cache; }
+#endif
+
+    protected:
+        virtual bool initWorker() override;
+        virtual void processOneItem(std::shared_ptr<SuggestionQueryItem> &item) override;
+        virtual void notifyQueueIsEmpty() override;
+        virtual void workerStopped() override;
+
+    public slots:
+        void process() { doWork(); }
+        void cancel() { stopWorking(); }
+
+    signals:
+        void stopped();
+
+    private:
+        QStringList findSuggestions(const QString &word);
+        // returns false if Hunspell is not available or failed
+        bool suggestCorrections(const QString &word, QStringList &suggestions);
+
+    private:
+        // guards Hunspell instance which is used from GUI thread too
+        QMutex m_HunspellLock;
+        SuggestionsCache m_Cache;
+        QString m_DictionarySignature;
+        Hunspell *m_Hunspell;
+        // Coded does not need destruction
+        QTextCodec *m_Codec;
+    };
+}
+
+#endif // SUGGESTIONSWORKER_H
@@ -0,0 +1,318 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "userdictionary.h"
+#include <QDataStream>
+#include <QTextStream>
+#include <QSaveFile>
+#include "../Common/defines.h"
+
+#define COMPILED_DICT_MAGIC 0x58504B44
+#define COMPILED_DICT_VERSION 1
+#define DICT_JOURNAL_MAGIC 0x58504B55
+#define DICT_JOURNAL_VERSION 1
+#define MAX_WORD_RECORD_SIZE (64*1024)
+#define COMPACTION_MIN_RECORDS 200
+#define UNREADABLE_DICT_SUFFIX ".unreadable"
+
+namespace SpellCheck {
+    enum DictRecordType {
+        AddWordRecord = 1,
+        RemoveWordRecord = 2,
+        ClearRecord = 3
+    };
+
+    static QByteArray serializeWordRecord(quint8 type, const QString &word) {
+        QByteArray payload;
+        {
+            QDataStream out(&payload, QIODevice::WriteOnly);
+            out.setVersion(QDataStream::Qt_5_0);
+            out << type << word;
+        }
+
+        return Helpers::RecordJournal::serializeRecord(payload);
+    }
+
+    UserDictionary::UserDictionary():
+        m_Journal(DICT_JOURNAL_MAGIC, DICT_JOURNAL_VERSION, MAX_WORD_RECORD_SIZE, true)
+    {
+    }
+
+    UserDictionary::~UserDictionary() {
+        close();
+    }
+
+    void UserDictionary::setPaths(const QString &compiledPath, const QString &journalPath) {
+        m_CompiledPath = compiledPath;
+        m_Journal.setPath(journalPath);
+    }
+
+    bool UserDictionary::load() {
+        m_WordsSet.clear();
+        m_WordsList.clear();
+
+        if (m_CompiledPath.isEmpty() || m_Journal.getPath().isEmpty()) {
+            LOG_WARNING << "User dictionary paths are empty. Words are kept in memory";
+            return false;
+        }
+
+        const bool compiledFound = QFile::exists(m_CompiledPath);
+        bool anyFound = compiledFound || QFile::exists(m_Journal.getPath());
+
+        if (compiledFound && !readCompiled()) {
+            // snapshot would be overwritten by the next compaction
+            // so it is kept aside and words are imported again by the caller
+            const QString backupPath = m_CompiledPath + UNREADABLE_DICT_SUFFIX;
+            LOG_WARNING << "Keeping unreadable user dictionary as" << backupPath;
+            QFile::remove(backupPath);
+            QFile::rename(m_CompiledPath, backupPath);
+            anyFound = false;
+        }
+
+        readJournal();
+
+        if (!m_Journal.openForAppend()) {
+            LOG_WARNING << "Failed to open user dictionary journal" << m_Journal.getPath();
+        }
+
+        compactIfNeeded();
+
+        return anyFound;
+    }
+
+    bool UserDictionary::importWords(const QString &textFilepath) {
+        QFile file(textFilepath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            LOG_WARNING << "Cannot open" << textFilepath;
+            return false;
+        }
+
+        QStringList words;
+        QTextStream stream(&file);
+        for (QString word = stream.readLine(); !word.isEmpty(); word = stream.readLine()) {
+            words.append(word);
+        }
+
+        file.close();
+
+        LOG_INFO << "Importing" << words.size() << "word(s) from" << textFilepath;
+
+        for (auto &word: words) {
+            addWordUnsafe(word);
+        }
+
+        if (m_Journal.isOpen()) {
+            compact();
+        }
+
+        return true;
+    }
+
+    void UserDictionary::addWord(const QString &word) {
+        if (addWordUnsafe(word)) {
+            appendRecord(AddWordRecord, word);
+            compactIfNeeded();
+        }
+    }
+
+    void UserDictionary::addWords(const QStringList &words) {
+        for (auto &word: words) {
+            if (addWordUnsafe(word)) {
+                appendRecord(AddWordRecord, word);
+            }
+        }
+
+        compactIfNeeded();
+    }
+
+    void UserDictionary::reset(const QStringList &words) {
+        QSet<QString> newWordsSet;
+        newWordsSet.reserve(words.size());
+        for (auto &word: words) {
+            newWordsSet.insert(word.toLower());
+        }
+
+        // only the difference is written to the journal
+        QStringList wordsLeft;
+        wordsLeft.reserve(m_WordsList.size());
+
+        for (auto &word: m_WordsList) {
+            QString invariant = word.toLower();
+            if (newWordsSet.contains(invariant)) {
+                wordsLeft.append(word);
+            } else {
+                m_WordsSet.remove(invariant);
+                appendRecord(RemoveWordRecord, word);
+            }
+        }
+
+        m_WordsList.swap(wordsLeft);
+
+        addWords(words);
+    }
+
+    void UserDictionary::clear() {
+        m_WordsList.clear();
+        m_WordsSet.clear();
+
+        if (appendRecord(ClearRecord, QString())) {
+            compact();
+        }
+    }
+
+    void UserDictionary::close() {
+        if (m_Journal.isOpen()) {
+            // next start will read only compiled dictionary
+            if (m_Journal.getRecordsCount() > 0) {
+                compact();
+            }
+
+            m_Journal.close();
+            LOG_INFO << "User dictionary closed with" << m_WordsList.size() << "words";
+        }
+    }
+
+    bool UserDictionary::addWordUnsafe(const QString &word) {
+        QString wordToAdd = word.toLower();
+        if (m_WordsSet.contains(wordToAdd)) { return false; }
+
+        m_WordsSet.insert(wordToAdd);
+        m_WordsList.append(word);
+        return true;
+    }
+
+    bool UserDictionary::readCompiled() {
+        QFile file(m_CompiledPath);
+        if (!file.exists()) { return false; }
+
+        if (!file.open(QIODevice::ReadOnly)) {
+            LOG_WARNING << "Failed to read compiled user dictionary" << m_CompiledPath;
+            return false;
+        }
+
+        QDataStream in(&file);
+        in.setVersion(QDataStream::Qt_5_0);
+
+        quint32 magic = 0, version = 0;
+        in >> magic >> version;
+
+        if ((in.status() != QDataStream::Ok) || (magic != COMPILED_DICT_MAGIC) || (version != COMPILED_DICT_VERSION)) {
+            LOG_WARNING << "Unknown compiled user dictionary format";
+            return false;
+        }
+
+        QStringList words;
+        QSet<QString> wordsSet;
+        in >> words >> wordsSet;
+
+        if ((in.status() != QDataStream::Ok) || (words.size() != wordsSet.size())) {
+            LOG_WARNING << "Compiled user dictionary is corrupted";
+            return false;
+        }
+
+        m_WordsList.swap(words);
+        m_WordsSet.swap(wordsSet);
+
+        LOG_INFO << "Compiled user dictionary read:" << m_WordsList.size() << "words";
+        return true;
+    }
+
+    void UserDictionary::readJournal() {
+        Helpers::RecordJournal::ReadResult result = m_Journal.read([this](QDataStream &record) {
+            quint8 type = 0;
+            QString word;
+            record >> type >> word;
+
+            // records are idempotent so journal can be replayed over a newer snapshot
+            if (type == AddWordRecord) {
+                addWordUnsafe(word);
+            } else if (type == RemoveWordRecord) {
+                QString invariant = word.toLower();
+                if (m_WordsSet.remove(invariant)) {
+                    int size = m_WordsList.size();
+                    for (int i = 0; i < size; ++i) {
+                        if (m_WordsList.at(i).toLower() == invariant) {
+                            m_WordsList.removeAt(i);
+                            break;
+                        }
+                    }
+                }
+            } else if (type == ClearRecord) {
+                m_WordsList.clear();
+                m_WordsSet.clear();
+            }
+        });
+
+        if (result == Helpers::RecordJournal::JournalUnknown) {
+            LOG_WARNING << "Unknown user dictionary journal format";
+            m_Journal.keepAside(UNREADABLE_DICT_SUFFIX);
+        } else if (result == Helpers::RecordJournal::JournalRead) {
+            LOG_INFO << "User dictionary journal read:" << m_Journal.getRecordsCount() << "records";
+        }
+    }
+
+    bool UserDictionary::appendRecord(quint8 type, const QString &word) {
+        bool success = m_Journal.appendRecords(serializeWordRecord(type, word), 1);
+
+        if (!success) {
+            LOG_WARNING << "Failed to append user dictionary record for" << word;
+        }
+
+        return success;
+    }
+
+    void UserDictionary::compactIfNeeded() {
+        if (!m_Journal.isOpen()) { return; }
+
+        if (m_Journal.getRecordsCount() > COMPACTION_MIN_RECORDS) {
+            compact();
+        }
+    }
+
+    bool UserDictionary::compact() {
+        LOG_INFO << "Compiling" << m_WordsList.size() << "words and" << m_Journal.getRecordsCount() << "journal records";
+
+        // compiled dictionary replaces old one only when it is completely written
+        QSaveFile compiled(m_CompiledPath);
+        if (!compiled.open(QIODevice::WriteOnly)) {
+            LOG_WARNING << "Failed to create compiled user dictionary";
+            return false;
+        }
+
+        {
+            QDataStream out(&compiled);
+            out.setVersion(QDataStream::Qt_5_0);
+            out << (quint32)COMPILED_DICT_MAGIC << (quint32)COMPILED_DICT_VERSION;
+            out << m_WordsList << m_WordsSet;
+        }
+
+        bool success = compiled.commit();
+        if (!success) {
+            LOG_WARNING << "Failed to save compiled user dictionary:" << compiled.errorString();
+            return false;
+        }
+
+        // journal is truncated only after compiled dictionary is saved
+        m_Journal.truncate();
+
+        return success;
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef USERDICTIONARY_H
+#define USERDICTIONARY_H
+
+#include <QString>
+#include <QStringList>
+#include <QSet>
+#include "../Helpers/recordjournal.h"
+
+namespace SpellCheck {
+    // words are kept in a compiled snapshot loaded at once on startup
+    // and every change is appended to a small journal replayed on top of it
+    // journal is merged into the snapshot when it grows or on close
+    class UserDictionary
+    {
+    public:
+        UserDictionary();
+        virtual ~UserDictionary();
+
+    public:
+        const QStringList &getWords() const { return m_WordsList; }
+        bool contains(const QString &word) const { return m_WordsSet.contains(word.toLower()); }
+        bool empty() const { return m_WordsSet.isEmpty(); }
+        int size() const { return m_WordsList.size(); }
+
+    public:
+        void setPaths(const QString &compiledPath, const QString &journalPath);
+        // returns false if nothing was found or the snapshot could not be read
+        bool load();
+        bool importWords(const QString &textFilepath);
+        void addWord(const QString &word);
+        void addWords(const QStringList &words);
+        void reset(const QStringList &words);
+        void clear();
+        void close();
+
+    private:
+        bool addWordUnsafe(const QString &word);
+        bool readCompiled();
+        void readJournal();
+        bool appendRecord(quint8 type, const QString &word);
+        void compactIfNeeded();
+        bool compact();
+
+    private:
+        QSet<QString> m_WordsSet;
+        QStringList m_WordsList;
+        Helpers::RecordJournal m_Journal;
+        QString m_CompiledPath;
+    };
+}
+
+#endif // USERDICTIONARY_H
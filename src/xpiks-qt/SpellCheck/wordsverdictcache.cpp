@@ -0,0 +1,201 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "wordsverdictcache.h"
+#include <QSet>
+#include "../Common/defines.h"
+
+namespace SpellCheck {
+    static bool hasUpperCase(const QString &word) {
+        for (const QChar &c: word) {
+            if (c != c.toLower()) { return true; }
+        }
+
+        return false;
+    }
+
+    static uint caseInsensitiveHash(const QString &word) {
+        uint hash = 0;
+        for (const QChar &c: word) {
+            hash = 31 * hash + c.toLower().unicode();
+        }
+
+        return hash;
+    }
+
+    WordsVerdictCache::WordsVerdictCache(int maxSize):
+        m_HitsCount(0),
+        m_MissesCount(0),
+        // two generations per every shard
+        m_MaxGenerationSize(qMax(maxSize / (2 * VERDICT_CACHE_SHARDS), 1))
+    {
+    }
+
+    bool WordsVerdictCache::tryGetVerdict(const QString &word, bool &isCorrect) {
+        CacheShard &shard = getShard(word);
+        bool found = false;
+
+        shard.m_Lock.lock();
+        {
+            auto it = shard.m_Recent.constFind(word);
+            if (it != shard.m_Recent.constEnd()) {
+                isCorrect = it.value();
+                found = true;
+            } else {
+                auto oldIt = shard.m_Old.find(word);
+                if (oldIt != shard.m_Old.end()) {
+                    isCorrect = oldIt.value();
+                    found = true;
+
+                    // promote to recent generation
+                    shard.m_Old.erase(oldIt);
+                    if (shard.m_Recent.size() >= m_MaxGenerationSize) {
+                        dropOldGenerationUnsafe(shard);
+                    }
+
+                    shard.m_Recent.insert(word, isCorrect);
+                }
+            }
+        }
+        shard.m_Lock.unlock();
+
+        if (found) {
+            m_HitsCount.ref();
+        } else {
+            m_MissesCount.ref();
+        }
+
+        return found;
+    }
+
+    void WordsVerdictCache::storeVerdict(const QString &word, bool isCorrect) {
+        CacheShard &shard = getShard(word);
+        QMutexLocker locker(&shard.m_Lock);
+
+        if ((shard.m_Recent.size() >= m_MaxGenerationSize) && !shard.m_Recent.contains(word)) {
+            dropOldGenerationUnsafe(shard);
+        }
+
+        const bool wasCached = (shard.m_Old.remove(word) > 0) || shard.m_Recent.contains(word);
+        shard.m_Recent.insert(word, isCorrect);
+
+        if (!wasCached) {
+            addCaseVariantUnsafe(shard, word);
+        }
+    }
+
+    int WordsVerdictCache::invalidate(const QStringList &words) {
+        if (words.isEmpty()) { return 0; }
+
+        QSet<QString> wordsToRemove;
+        wordsToRemove.reserve(words.size());
+        for (auto &word: words) {
+            wordsToRemove.insert(word.toLower());
+        }
+
+        int removedCount = 0;
+
+        for (auto &lowerWord: wordsToRemove) {
+            CacheShard &shard = getShard(lowerWord);
+            QMutexLocker locker(&shard.m_Lock);
+
+            QStringList variants = shard.m_CaseVariants.take(lowerWord);
+            variants.append(lowerWord);
+
+            for (auto &variant: variants) {
+                removedCount += shard.m_Recent.remove(variant);
+                removedCount += shard.m_Old.remove(variant);
+            }
+        }
+
+        LOG_DEBUG << "Invalidated" << removedCount << "verdict(s) for" << words.size() << "word(s)";
+        return removedCount;
+    }
+
+    void WordsVerdictCache::clear() {
+        for (int i = 0; i < VERDICT_CACHE_SHARDS; ++i) {
+            CacheShard &shard = m_Shards[i];
+            QMutexLocker locker(&shard.m_Lock);
+            shard.m_Recent.clear();
+            shard.m_Old.clear();
+            shard.m_CaseVariants.clear();
+        }
+
+        m_HitsCount.store(0);
+        m_MissesCount.store(0);
+    }
+
+    int WordsVerdictCache::size() {
+        int result = 0;
+
+        for (int i = 0; i < VERDICT_CACHE_SHARDS; ++i) {
+            CacheShard &shard = m_Shards[i];
+            QMutexLocker locker(&shard.m_Lock);
+            result += shard.m_Recent.size() + shard.m_Old.size();
+        }
+
+        return result;
+    }
+
+    WordsVerdictCache::CacheShard &WordsVerdictCache::getShard(const QString &word) {
+        return m_Shards[caseInsensitiveHash(word) % VERDICT_CACHE_SHARDS];
+    }
+
+    void WordsVerdictCache::dropOldGenerationUnsafe(CacheShard &shard) {
+        if (!shard.m_CaseVariants.isEmpty()) {
+            for (auto it = shard.m_Old.constBegin(), end = shard.m_Old.constEnd(); it != end; ++it) {
+                removeCaseVariantUnsafe(shard, it.key());
+            }
+        }
+
+        shard.m_Old.swap(shard.m_Recent);
+        shard.m_Recent.clear();
+    }
+
+    void WordsVerdictCache::addCaseVariantUnsafe(CacheShard &shard, const QString &word) {
+        // lower-cased words are found without the index
+        if (!hasUpperCase(word)) { return; }
+
+        QStringList &variants = shard.m_CaseVariants[word.toLower()];
+        if (!variants.contains(word)) {
+            variants.append(word);
+        }
+    }
+
+    void WordsVerdictCache::removeCaseVariantUnsafe(CacheShard &shard, const QString &word) {
+        if (!hasUpperCase(word)) { return; }
+
+        auto it = shard.m_CaseVariants.find(word.toLower());
+        if (it != shard.m_CaseVariants.end()) {
+            it.value().removeOne(word);
+            if (it.value().isEmpty()) {
+                shard.m_CaseVariants.erase(it);
+            }
+        }
+    }
+
+    double WordsVerdictCache::getHitRate() const {
+        const int hits = m_HitsCount.load();
+        const int total = hits + m_MissesCount.load();
+        double rate = (total > 0) ? ((double)hits / total) : 0.0;
+        return rate;
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * This file is a part of Xpiks - cross platform application for
+ * keywording and uploading images for microstocks
+ * Copyright (C) 2014-2017 Taras Kushnir <kushnirTV@gmail.com>
+ *
+ * Xpiks is distributed under the GNU General Public License, version 3.0
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WORDSVERDICTCACHE_H
+#define WORDSVERDICTCACHE_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInt>
+
+#define VERDICT_CACHE_SHARDS 16
+#define DEFAULT_VERDICT_CACHE_SIZE 100000
+
+namespace SpellCheck {
+    // bounded thread-safe cache of spelling verdicts (correct or not) per word
+    // every shard keeps two generations: when the recent one is full
+    // the old one is dropped, so words used often are kept in cache
+    class WordsVerdictCache
+    {
+    public:
+        WordsVerdictCache(int maxSize=DEFAULT_VERDICT_CACHE_SIZE);
+
+    public:
+        bool tryGetVerdict(const QString &word, bool &isCorrect);
+        void storeVerdict(const QString &word, bool isCorrect);
+        // removes all case variants of given words
+        // without walking through the whole cache
+        int invalidate(const QStringList &words);
+        void clear();
+        int size();
+
+    public:
+        int getHitsCount() const { return m_HitsCount.load(); }
+        int getMissesCount() const { return m_MissesCount.load(); }
+        double getHitRate() const;
+
+    private:
+        struct CacheShard {
+            QMutex m_Lock;
+            QHash<QString, bool> m_Recent;
+            QHash<QString, bool> m_Old;
+            // lower-cased word to its cached variants with upper case letters
+            QHash<QString, QStringList> m_CaseVariants;
+        };
+
+        // all case variants of the word are in the same shard
+        CacheShard &getShard(const QString &word);
+        void dropOldGenerationUnsafe(CacheShard &shard);
+        void addCaseVariantUnsafe(CacheShard &shard, const QString &word);
+        void removeCaseVariantUnsafe(CacheShard &shard, const QString &word);
+
+    private:
+        CacheShard m_Shards[VERDICT_CACHE_SHARDS];
+        QAtomicInt m_HitsCount;
+        QAtomicInt m_MissesCount;
+        int m_MaxGenerationSize;
+    };
+}
+
+#endif // WORDSVERDICTCACHE_H
@@ -275,6 +275,10 @@ ColumnLayout {
                             filteredArtItemsModel.searchTerm = text
                         }
 
+                        onTextChanged: {
+                            filteredArtItemsModel.prefetchSearchTerm(text)
+                        }
+
                         Connections {
                             target: filteredArtItemsModel
                             onSearchTermChanged: filterText.text = filteredArtItemsModel.searchTerm
@@ -23,12 +23,21 @@
 #include "../Models/artworkmetadata.h"
 #include "../Models/imageartwork.h"
 #include "../Common/defines.h"
+#include "../Common/flags.h"
 
-UndoRedo::ArtworkMetadataBackup::ArtworkMetadataBackup(Models::ArtworkMetadata *metadata) {
+UndoRedo::ArtworkMetadataBackup::ArtworkMetadataBackup(Models::ArtworkMetadata *metadata):
+    m_Flags(0)
+{
+    // strings and ids are implicitly shared with the artwork until it is modified
     m_Description = metadata->getDescription();
     m_Title = metadata->getTitle();
-    m_KeywordsList = metadata->getKeywords();
+    m_KeywordIDs = metadata->getKeywordIDs();
     m_IsModified = metadata->isModified();
+    Common::KeywordsPool::getInstance().acquire(m_KeywordIDs);
+
+    Common::SetFlag(m_Flags, FlagDescriptionChanged);
+    Common::SetFlag(m_Flags, FlagTitleChanged);
+    Common::SetFlag(m_Flags, FlagKeywordsChanged);
 
     Models::ImageArtwork *image = dynamic_cast<Models::ImageArtwork *>(metadata);
     if (image != NULL && image->hasVectorAttached()) {
@@ -40,15 +49,67 @@ UndoRedo::ArtworkMetadataBackup::ArtworkMetadataBackup(const UndoRedo::ArtworkMe
     m_Description(copy.m_Description),
     m_Title(copy.m_Title),
     m_AttachedVector(copy.m_AttachedVector),
-    m_KeywordsList(copy.m_KeywordsList),
+    m_KeywordIDs(copy.m_KeywordIDs),
+    m_Flags(copy.m_Flags),
     m_IsModified(copy.m_IsModified)
 {
+    Common::KeywordsPool::getInstance().acquire(m_KeywordIDs);
+}
+
+UndoRedo::ArtworkMetadataBackup::~ArtworkMetadataBackup() {
+    Common::KeywordsPool::getInstance().release(m_KeywordIDs);
+}
+
+UndoRedo::ArtworkMetadataBackup &UndoRedo::ArtworkMetadataBackup::operator=(const UndoRedo::ArtworkMetadataBackup &other) {
+    if (this != &other) {
+        Common::KeywordsPool &pool = Common::KeywordsPool::getInstance();
+        const QVector<Common::KeywordID> previouslyHeld = m_KeywordIDs;
+
+        m_Description = other.m_Description;
+        m_Title = other.m_Title;
+        m_AttachedVector = other.m_AttachedVector;
+        m_KeywordIDs = other.m_KeywordIDs;
+        m_Flags = other.m_Flags;
+        m_IsModified = other.m_IsModified;
+
+        pool.acquire(m_KeywordIDs);
+        pool.release(previouslyHeld);
+    }
+
+    return *this;
+}
+
+void UndoRedo::ArtworkMetadataBackup::diffWith(Models::ArtworkMetadata *metadata) {
+    if (m_Description == metadata->getDescription()) {
+        m_Description.clear();
+        Common::UnsetFlag(m_Flags, FlagDescriptionChanged);
+    }
+
+    if (m_Title == metadata->getTitle()) {
+        m_Title.clear();
+        Common::UnsetFlag(m_Flags, FlagTitleChanged);
+    }
+
+    if (m_KeywordIDs == metadata->getKeywordIDs()) {
+        Common::KeywordsPool::getInstance().release(m_KeywordIDs);
+        m_KeywordIDs = QVector<Common::KeywordID>();
+        Common::UnsetFlag(m_Flags, FlagKeywordsChanged);
+    }
 }
 
 void UndoRedo::ArtworkMetadataBackup::restore(Models::ArtworkMetadata *metadata) const {
-    metadata->setDescription(m_Description);
-    metadata->setTitle(m_Title);
-    metadata->setKeywords(m_KeywordsList);
+    if (Common::HasFlag(m_Flags, FlagDescriptionChanged)) {
+        metadata->setDescription(m_Description);
+    }
+
+    if (Common::HasFlag(m_Flags, FlagTitleChanged)) {
+        metadata->setTitle(m_Title);
+    }
+
+    if (Common::HasFlag(m_Flags, FlagKeywordsChanged)) {
+        metadata->setKeywords(Common::KeywordsPool::getInstance().getKeywords(m_KeywordIDs));
+    }
+
     if (m_IsModified) { metadata->setModified(); }
     else { metadata->resetModified(); }
 
@@ -24,6 +24,8 @@
 
 #include <QStringList>
 #include <QString>
+#include <QVector>
+#include "../Common/keywordspool.h"
 
 namespace Models { class ArtworkMetadata; }
 
@@ -33,16 +35,29 @@ namespace UndoRedo {
     public:
         ArtworkMetadataBackup(Models::ArtworkMetadata *metadata);
         ArtworkMetadataBackup(const ArtworkMetadataBackup &copy);
-        ~ArtworkMetadataBackup() {}
+        ~ArtworkMetadataBackup();
+        ArtworkMetadataBackup &operator=(const ArtworkMetadataBackup &other);
 
     public:
+        // keeps only what differs from the modified artwork
+        void diffWith(Models::ArtworkMetadata *metadata);
         void restore(Models::ArtworkMetadata *metadata) const;
 
+    private:
+        enum BackupFlags {
+            FlagDescriptionChanged = 1 << 0,
+            FlagTitleChanged = 1 << 1,
+            FlagKeywordsChanged = 1 << 2
+        };
+
     private:
         QString m_Description;
         QString m_Title;
         QString m_AttachedVector;
-        QStringList m_KeywordsList;
+        // full list of pooled ids is cheap and does not depend on later edits
+        // every keyword kept by the backup holds a reference in the pool
+        QVector<Common::KeywordID> m_KeywordIDs;
+        int m_Flags;
         bool m_IsModified;
     };
 }
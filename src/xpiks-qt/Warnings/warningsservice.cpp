@@ -21,6 +21,7 @@
 
 #include "warningsservice.h"
 #include <QVector>
+#include <QTimer>
 #include "../Common/defines.h"
 #include "warningscheckingworker.h"
 #include "../Commands/commandmanager.h"
@@ -422,6 +422,8 @@ int main(int argc, char *argv[]) {
     qmlRegisterType<Helpers::ClipboardHelper>("xpiks", 1, 0, "ClipboardHelper");
     qmlRegisterType<QMLExtensions::TriangleElement>("xpiks", 1, 0, "TriangleElement");
     qmlRegisterType<QMLExtensions::FolderElement>("xpiks", 1, 0, "FolderElement");
+    qmlRegisterUncreatableType<Models::FilteredArtItemsProxyModel>("xpiks", 1, 0, "FilteredArtItemsProxyModel",
+                                                                   "Only sorting modes are accessible");
 
     QQmlApplicationEngine engine;
     Helpers::GlobalImageProvider *globalProvider = new Helpers::GlobalImageProvider(QQmlImageProviderBase::Image);
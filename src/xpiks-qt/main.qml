@@ -380,10 +380,8 @@ ApplicationWindow {
                     delegate: MenuItem {
                         text: display
                         onTriggered: {
-                            var filesAdded = artItemsModel.addRecentDirectory(display)
-                            if (filesAdded === 0) {
-                                noNewFilesDialog.open()
-                            }
+                            // directory is scanned in background and reported via artworksAdded
+                            artItemsModel.addRecentDirectory(display)
                         }
                     }
                 }
@@ -430,14 +428,58 @@ ApplicationWindow {
                 }
             }
 
-            MenuItem {
-                text: i18.n + qsTr("&Sort by filename")
-                checkable: true
-                onToggled: {
-                    console.info("Sort by filename")
-                    if (filteredArtItemsModel.getItemsCount() > 0) {
-                        filteredArtItemsModel.toggleSorted();
-                    }
+            Menu {
+                id: sortingMenu
+                title: i18.n + qsTr("&Sort")
+
+                ExclusiveGroup { id: sortingGroup }
+
+                MenuItem {
+                    text: i18.n + qsTr("&Unsorted")
+                    checkable: true
+                    exclusiveGroup: sortingGroup
+                    checked: filteredArtItemsModel.sortingMode === FilteredArtItemsProxyModel.NoSorting
+                    onTriggered: filteredArtItemsModel.setSortingMode(FilteredArtItemsProxyModel.NoSorting)
+                }
+
+                MenuItem {
+                    text: i18.n + qsTr("By &filename")
+                    checkable: true
+                    exclusiveGroup: sortingGroup
+                    checked: filteredArtItemsModel.sortingMode === FilteredArtItemsProxyModel.SortByFilename
+                    onTriggered: filteredArtItemsModel.setSortingMode(FilteredArtItemsProxyModel.SortByFilename)
+                }
+
+                MenuItem {
+                    text: i18.n + qsTr("By &date taken")
+                    checkable: true
+                    exclusiveGroup: sortingGroup
+                    checked: filteredArtItemsModel.sortingMode === FilteredArtItemsProxyModel.SortByDateTaken
+                    onTriggered: filteredArtItemsModel.setSortingMode(FilteredArtItemsProxyModel.SortByDateTaken)
+                }
+
+                MenuItem {
+                    text: i18.n + qsTr("By file &size")
+                    checkable: true
+                    exclusiveGroup: sortingGroup
+                    checked: filteredArtItemsModel.sortingMode === FilteredArtItemsProxyModel.SortByFileSize
+                    onTriggered: filteredArtItemsModel.setSortingMode(FilteredArtItemsProxyModel.SortByFileSize)
+                }
+
+                MenuItem {
+                    text: i18.n + qsTr("By &keywords count")
+                    checkable: true
+                    exclusiveGroup: sortingGroup
+                    checked: filteredArtItemsModel.sortingMode === FilteredArtItemsProxyModel.SortByKeywordsCount
+                    onTriggered: filteredArtItemsModel.setSortingMode(FilteredArtItemsProxyModel.SortByKeywordsCount)
+                }
+
+                MenuItem {
+                    text: i18.n + qsTr("&Modified first")
+                    checkable: true
+                    exclusiveGroup: sortingGroup
+                    checked: filteredArtItemsModel.sortingMode === FilteredArtItemsProxyModel.SortByModified
+                    onTriggered: filteredArtItemsModel.setSortingMode(FilteredArtItemsProxyModel.SortByModified)
                 }
             }
 
@@ -855,13 +897,8 @@ ApplicationWindow {
 
         onAccepted: {
             console.debug("You chose: " + chooseDirectoryDialog.fileUrls)
-            var filesAdded = artItemsModel.addLocalDirectories(chooseDirectoryDialog.fileUrls)
-            if (filesAdded > 0) {
-                saveRecentDirectories()
-                console.debug("" + filesAdded + ' files via Open Directory')
-            } else {
-                noNewFilesDialog.open()
-            }
+            // directories are scanned in background and reported via artworksAdded
+            artItemsModel.addLocalDirectories(chooseDirectoryDialog.fileUrls)
         }
 
         onRejected: {
@@ -947,6 +984,8 @@ ApplicationWindow {
                 return;
             }
 
+            saveRecentDirectories()
+
             var latestDir = recentDirectories.getLatestDirectory()
             chooseArtworksDialog.folder = latestDir
             chooseDirectoryDialog.folder = latestDir
@@ -1007,11 +1046,8 @@ ApplicationWindow {
             anchors.fill: parent
             onDropped: {
                 if (drop.hasUrls) {
-                    var filesCount = artItemsModel.dropFiles(drop.urls)
-                    if (filesCount > 0) {
-                        saveRecentDirectories()
-                        console.debug(filesCount + ' files added via drag&drop')
-                    }
+                    console.debug(drop.urls.length + ' item(s) dropped')
+                    artItemsModel.dropFiles(drop.urls)
                 }
             }
         }
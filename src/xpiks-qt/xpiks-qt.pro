@@ -44,7 +44,11 @@ SOURCES += main.cpp \
     Helpers/logger.cpp \
     Models/logsmodel.cpp \
     Models/filteredartitemsproxymodel.cpp \
+    Models/searchindex.cpp \
+    Models/filterengine.cpp \
     Helpers/filenameshelpers.cpp \
+    Helpers/filehelpers.cpp \
+    Helpers/recordjournal.cpp \
     Helpers/helpersqmlwrapper.cpp \
     Models/recentdirectoriesmodel.cpp \
     Suggestion/locallibrary.cpp \
@@ -56,10 +60,17 @@ SOURCES += main.cpp \
     SpellCheck/spellcheckworker.cpp \
     SpellCheck/spellchecksuggestionmodel.cpp \
     Common/basickeywordsmodel.cpp \
+    Common/keywordspool.cpp \
+    SpellCheck/wordsverdictcache.cpp \
+    SpellCheck/spellcheckbatch.cpp \
+    SpellCheck/suggestionsworker.cpp \
+    SpellCheck/suggestionscache.cpp \
+    SpellCheck/userdictionary.cpp \
     SpellCheck/spellcheckerrorshighlighter.cpp \
     SpellCheck/spellcheckiteminfo.cpp \
     MetadataIO/backupsaverworker.cpp \
     MetadataIO/backupsaverservice.cpp \
+    MetadataIO/backupjournal.cpp \
     SpellCheck/spellsuggestionsitem.cpp \
     Conectivity/telemetryservice.cpp \
     Conectivity/updatescheckerworker.cpp \
@@ -68,6 +79,9 @@ SOURCES += main.cpp \
     MetadataIO/metadataiocoordinator.cpp \
     MetadataIO/saverworkerjobitem.cpp \
     MetadataIO/metadatawritingworker.cpp \
+    MetadataIO/exiftoolprocess.cpp \
+    MetadataIO/exiftooljsonparser.cpp \
+    MetadataIO/metadatareadcache.cpp \
     Conectivity/curlftpuploader.cpp \
     Conectivity/ftpuploaderworker.cpp \
     Conectivity/ftpcoordinator.cpp \
@@ -101,6 +115,7 @@ SOURCES += main.cpp \
     Models/imageartwork.cpp \
     MetadataIO/exiv2readingworker.cpp \
     MetadataIO/readingorchestrator.cpp \
+    MetadataIO/exiv2metadatacache.cpp \
     MetadataIO/exiv2writingworker.cpp \
     MetadataIO/writingorchestrator.cpp \
     Common/flags.cpp \
@@ -124,6 +139,8 @@ SOURCES += main.cpp \
     MetadataIO/exiv2inithelper.cpp \
     Conectivity/simplecurldownloader.cpp \
     Helpers/updatehelpers.cpp \
+    Helpers/directoryscanner.cpp \
+    Helpers/fileswatcher.cpp \
     Common/basicmetadatamodel.cpp \
     KeywordsPresets/presetkeywordsmodel.cpp \
     KeywordsPresets/presetkeywordsmodelconfig.cpp \
@@ -199,13 +216,23 @@ HEADERS += \
     Models/ziparchiver.h \
     Helpers/ziphelper.h \
     Common/basickeywordsmodel.h \
+    Common/keywordspool.h \
+    SpellCheck/wordsverdictcache.h \
+    SpellCheck/spellcheckbatch.h \
+    SpellCheck/suggestionsworker.h \
+    SpellCheck/suggestionscache.h \
+    SpellCheck/userdictionary.h \
     Suggestion/keywordssuggestor.h \
     Suggestion/suggestionartwork.h \
     Models/settingsmodel.h \
     Helpers/loggingworker.h \
     Common/defines.h \
     Models/filteredartitemsproxymodel.h \
+    Models/searchindex.h \
+    Models/filterengine.h \
     Helpers/filenameshelpers.h \
+    Helpers/filehelpers.h \
+    Helpers/recordjournal.h \
     Common/flags.h \
     Helpers/helpersqmlwrapper.h \
     Models/recentdirectoriesmodel.h \
@@ -223,6 +250,7 @@ HEADERS += \
     MetadataIO/backupsaverworker.h \
     Common/itemprocessingworker.h \
     MetadataIO/backupsaverservice.h \
+    MetadataIO/backupjournal.h \
     SpellCheck/spellsuggestionsitem.h \
     Conectivity/analyticsuserevent.h \
     Conectivity/telemetryservice.h \
@@ -233,6 +261,9 @@ HEADERS += \
     MetadataIO/metadatareadingworker.h \
     MetadataIO/metadataiocoordinator.h \
     MetadataIO/metadatawritingworker.h \
+    MetadataIO/exiftoolprocess.h \
+    MetadataIO/exiftooljsonparser.h \
+    MetadataIO/metadatareadcache.h \
     Conectivity/curlftpuploader.h \
     Conectivity/ftpuploaderworker.h \
     Conectivity/ftpcoordinator.h \
@@ -282,9 +313,12 @@ HEADERS += \
     AutoComplete/stringfilterproxymodel.h \
     Models/imageartwork.h \
     Common/hold.h \
+    Common/sharedworkqueue.h \
     MetadataIO/exiv2readingworker.h \
     MetadataIO/importdataresult.h \
     MetadataIO/readingorchestrator.h \
+    MetadataIO/importresultscollector.h \
+    MetadataIO/exiv2metadatacache.h \
     MetadataIO/imetadatareader.h \
     MetadataIO/exiv2writingworker.h \
     MetadataIO/writingorchestrator.h \
@@ -315,6 +349,8 @@ HEADERS += \
     Conectivity/simplecurldownloader.h \
     Conectivity/apimanager.h \
     Helpers/updatehelpers.h \
+    Helpers/directoryscanner.h \
+    Helpers/fileswatcher.h \
     Common/basicmetadatamodel.h \
     KeywordsPresets/presetkeywordsmodel.h \
     KeywordsPresets/presetkeywordsmodelconfig.h \
@@ -42,8 +42,10 @@ namespace Mocks {
                 QString filename = QString(ARTWORK_PATH).arg(i%2).arg(i);
                 QString vectorname = QString(VECTOR_PATH).arg(i%2).arg(i);
 
-                if (artworksRepository->accountFile(filename)) {
-                    Models::ArtworkMetadata *metadata = artItemsModel->createMetadata(filename);
+                qint64 directoryID = 0;
+
+                if (artworksRepository->accountFile(filename, directoryID)) {
+                    Models::ArtworkMetadata *metadata = artItemsModel->createMetadata(filename, directoryID);
                     Models::ImageArtwork *image = dynamic_cast<Models::ImageArtwork*>(metadata);
 
                     this->connectArtworkSignals(metadata);
@@ -1,4 +1,5 @@
 #include "artitemsmodel_tests.h"
+#include <QSignalSpy>
 #include "Mocks/artitemsmodelmock.h"
 #include "Mocks/commandmanagermock.h"
 #include "../../xpiks-qt/Models/filteredartitemsproxymodel.h"
@@ -162,3 +163,65 @@ void ArtItemsModelTests::plainTextEditToMixedTest() {
     artItemsModelMock.plainTextEdit(0, keywords);
     QCOMPARE(artItemsModelMock.getMockArtwork(0)->getKeywords(), result);
 }
+
+void ArtItemsModelTests::selectAllEmitsSingleUpdateTest() {
+    const int count = 50;
+    DECLARE_MODELS_AND_GENERATE(count, false);
+
+    QSignalSpy dataChangedSpy(&artItemsModelMock, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)));
+
+    artItemsModelMock.setAllItemsSelected(true);
+    artItemsModelMock.updateItems(QVector<int>() << 3 << 4, QVector<int>() << Models::ArtItemsModel::IsSelectedRole);
+    QCOMPARE(dataChangedSpy.count(), 0);
+    QCOMPARE(filteredItemsModel.getSelectedArtworksCount(), count);
+
+    QCoreApplication::processEvents();
+
+    QCOMPARE(dataChangedSpy.count(), 1);
+    QList<QVariant> arguments = dataChangedSpy.takeFirst();
+    QCOMPARE(arguments.at(0).value<QModelIndex>().row(), 0);
+    QCOMPARE(arguments.at(1).value<QModelIndex>().row(), count - 1);
+}
+
+void ArtItemsModelTests::scheduledUpdatesAreMergedTest() {
+    const int count = 10;
+    DECLARE_MODELS_AND_GENERATE(count, false);
+
+    QSignalSpy dataChangedSpy(&artItemsModelMock, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)));
+
+    artItemsModelMock.updateItems(QVector<int>() << 2 << 1, QVector<int>() << Models::ArtItemsModel::IsSelectedRole);
+    artItemsModelMock.updateItems(QVector<int>() << 3, QVector<int>() << Models::ArtItemsModel::IsModifiedRole);
+    artItemsModelMock.updateItems(QVector<int>() << 7, QVector<int>() << Models::ArtItemsModel::IsSelectedRole);
+
+    QCoreApplication::processEvents();
+
+    QCOMPARE(dataChangedSpy.count(), 2);
+
+    QList<QVariant> first = dataChangedSpy.takeFirst();
+    QCOMPARE(first.at(0).value<QModelIndex>().row(), 1);
+    QCOMPARE(first.at(1).value<QModelIndex>().row(), 3);
+    QVector<int> roles = first.at(2).value<QVector<int> >();
+    QVERIFY(roles.contains(Models::ArtItemsModel::IsSelectedRole));
+    QVERIFY(roles.contains(Models::ArtItemsModel::IsModifiedRole));
+
+    QList<QVariant> second = dataChangedSpy.takeFirst();
+    QCOMPARE(second.at(0).value<QModelIndex>().row(), 7);
+    QCOMPARE(second.at(1).value<QModelIndex>().row(), 7);
+}
+
+void ArtItemsModelTests::pendingUpdatesFlushedBeforeRemovalTest() {
+    const int count = 10;
+    DECLARE_MODELS_AND_GENERATE(count, false);
+
+    QSignalSpy dataChangedSpy(&artItemsModelMock, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)));
+
+    artItemsModelMock.updateItems(QVector<int>() << 5, QVector<int>() << Models::ArtItemsModel::IsSelectedRole);
+    artItemsModelMock.removeArtworks(QVector<QPair<int, int> >() << qMakePair(0, 0));
+
+    QCOMPARE(dataChangedSpy.count(), 1);
+    QList<QVariant> arguments = dataChangedSpy.takeFirst();
+    QCOMPARE(arguments.at(0).value<QModelIndex>().row(), 5);
+
+    QCoreApplication::processEvents();
+    QCOMPARE(dataChangedSpy.count(), 0);
+}
@@ -19,6 +19,9 @@ private slots:
     void plainTextEditToSeveralKeywordsTest();
     void plainTextEditToAlmostEmptyTest();
     void plainTextEditToMixedTest();
+    void selectAllEmitsSingleUpdateTest();
+    void scheduledUpdatesAreMergedTest();
+    void pendingUpdatesFlushedBeforeRemovalTest();
 };
 
 #endif // ARTITEMSMODELTESTS_H
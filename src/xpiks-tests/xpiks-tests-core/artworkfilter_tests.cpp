@@ -130,3 +130,40 @@ void ArtworkFilterTests::cantFindWithFilterSpecialTest() {
     QVERIFY(!Helpers::hasSearchMatch("x:modified", &metadata, flags));
     QVERIFY(Helpers::hasSearchMatch("x:modified", &metadata, flags | Common::SearchFlags::ReservedTerms));
 }
+
+void ArtworkFilterTests::searchQueryReuseTest() {
+    Mocks::ArtworkMetadataMock first("/path/to/first.jpg");
+    first.setTitle("Sunset over sea");
+    first.setKeywords(QStringList() << "sunset" << "Beach");
+
+    Mocks::ArtworkMetadataMock second("/path/to/second.jpg");
+    second.setDescription("Mountains in fog");
+    second.setKeywords(QStringList() << "rock");
+
+    const Helpers::SearchQuery anyQuery("BEACH !rock", Common::SearchFlags::AnyTermsEverything);
+    QVERIFY(anyQuery.matches(&first));
+    QVERIFY(anyQuery.matches(&second));
+
+    const Helpers::SearchQuery allQuery("sun !beach", Common::SearchFlags::AllTermsEverything);
+    QVERIFY(allQuery.matches(&first));
+    QVERIFY(!allQuery.matches(&second));
+
+    const Helpers::SearchQuery strictQuery("!roc", Common::SearchFlags::AnyTermsEverything);
+    QVERIFY(!strictQuery.matches(&first));
+    QVERIFY(!strictQuery.matches(&second));
+
+    const Helpers::SearchQuery caseSensitiveQuery("beach", Common::SearchFlags::Keywords | Common::SearchFlags::CaseSensitive);
+    QVERIFY(!caseSensitiveQuery.matches(&first));
+}
+
+void ArtworkFilterTests::emptySearchQueryTest() {
+    Mocks::ArtworkMetadataMock metadata("/path/to/file.jpg");
+    metadata.setKeywords(QStringList() << "keyword");
+
+    const Helpers::SearchQuery anyQuery("   ", Common::SearchFlags::AnyTermsEverything);
+    QVERIFY(anyQuery.isEmpty());
+    QVERIFY(!anyQuery.matches(&metadata));
+
+    const Helpers::SearchQuery allQuery("   ", Common::SearchFlags::AllTermsEverything);
+    QVERIFY(allQuery.matches(&metadata));
+}
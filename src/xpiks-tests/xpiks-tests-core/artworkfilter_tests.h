@@ -19,6 +19,8 @@ private slots:
     void cantFindWithFilterTitleTest();
     void cantFindWithFilterKeywordsTest();
     void cantFindWithFilterSpecialTest();
+    void searchQueryReuseTest();
+    void emptySearchQueryTest();
 };
 
 #endif // ARTWORKFILTERTESTS_H
@@ -478,3 +478,52 @@ void ArtworkMetadataTests::removeKeywordsMarksModifiedTest() {
     QVERIFY(result);
     QVERIFY(metadata.isModified());
 }
+
+void ArtworkMetadataTests::appendKeywordIgnoresCaseDuplicatesTest() {
+    Mocks::ArtworkMetadataMock metadata("file.jpg");
+    int added = metadata.appendKeywords(QStringList() << "Keyword" << "KEYWORD" << "another");
+    QCOMPARE(added, 2);
+
+    bool result = metadata.appendKeyword("kEyWoRd");
+    QVERIFY(!result);
+    QCOMPARE(metadata.rowCount(), 2);
+
+    QSet<QString> keywordsSet = metadata.getKeywordsSet();
+    QCOMPARE(keywordsSet.size(), 2);
+    QVERIFY(keywordsSet.contains("keyword"));
+    QVERIFY(keywordsSet.contains("another"));
+}
+
+void ArtworkMetadataTests::editKeywordChangesCaseTest() {
+    Mocks::ArtworkMetadataMock metadata("file.jpg");
+    metadata.appendKeywords(QStringList() << "keyword" << "another");
+
+    bool result = metadata.editKeyword(0, "KEYWORD");
+    QVERIFY(result);
+    QCOMPARE(metadata.getKeywords()[0], QString("KEYWORD"));
+
+    result = metadata.editKeyword(0, "Another");
+    QVERIFY(!result);
+
+    result = metadata.appendKeyword("keyword");
+    QVERIFY(!result);
+}
+
+void ArtworkMetadataTests::lockedForEditingDoesNotChangeFlagsTest() {
+    Mocks::ArtworkMetadataMock metadata("file.jpg");
+    metadata.appendKeyword("keyword");
+    metadata.setIsSelected(true);
+
+    QVERIFY(metadata.isModified());
+    QVERIFY(!metadata.isLockedForEditing());
+
+    metadata.setIsLockedForEditing(true);
+    QVERIFY(metadata.isLockedForEditing());
+    QVERIFY(metadata.isModified());
+    QVERIFY(metadata.isSelected());
+
+    metadata.setIsLockedForEditing(false);
+    QVERIFY(!metadata.isLockedForEditing());
+    QVERIFY(metadata.isModified());
+    QVERIFY(metadata.isSelected());
+}
@@ -36,6 +36,9 @@ private slots:
     void clearKeywordsMarksAsModifiedTest();
     void clearEmptyKeywordsDoesNotMarkModifiedTest();
     void removeKeywordsMarksModifiedTest();
+    void appendKeywordIgnoresCaseDuplicatesTest();
+    void editKeywordChangesCaseTest();
+    void lockedForEditingDoesNotChangeFlagsTest();
 };
 
 #endif // ARTWORKMETADATA_TESTS_H
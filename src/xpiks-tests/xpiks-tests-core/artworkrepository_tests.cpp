@@ -77,10 +77,11 @@ void ArtworkRepositoryTests::addAndRemoveSameFileTest() {
     QString directory = "/path/to/some";
 #endif
 
-    bool status = repository.accountFile(filename);
+    qint64 directoryID = 0;
+    bool status = repository.accountFile(filename, directoryID);
     QCOMPARE(status, true);
 
-    bool removeResult = repository.removeFile(filename, directory);
+    bool removeResult = repository.removeFile(filename, directoryID);
     repository.cleanupEmptyDirectories();
 
     QCOMPARE(repository.getArtworksSourcesCount(), 0);
@@ -100,11 +101,12 @@ void ArtworkRepositoryTests::removeNotExistingFileTest() {
     QString directory = "/path/to/some";
 #endif
 
-    bool status = repository.accountFile(filename1);
+    qint64 directoryID = 0;
+    bool status = repository.accountFile(filename1, directoryID);
     QCOMPARE(status, true);
     QCOMPARE(repository.getArtworksSourcesCount(), 1);
 
-    bool removeResult = repository.removeFile(filename2, directory);
+    bool removeResult = repository.removeFile(filename2, directoryID);
     repository.cleanupEmptyDirectories();
 
     QCOMPARE(removeResult, false);
@@ -246,3 +248,40 @@ void ArtworkRepositoryTests::startAccountingNewFilesEmitsTest() {
     QCOMPARE(addArguments.at(1).toInt(), 0);
     QCOMPARE(addArguments.at(2).toInt(), files.length() - 1);
 }
+
+void ArtworkRepositoryTests::directoryIDsTest() {
+    Models::ArtworksRepository repository;
+
+#ifdef Q_OS_WIN
+    QString filename1 = "C:/path/to/some/file1";
+    QString filename2 = "C:/path/to/some/file2";
+    QString filename3 = "C:/path/to/other/file3";
+#else
+    QString filename1 = "/path/to/some/file1";
+    QString filename2 = "/path/to/some/file2";
+    QString filename3 = "/path/to/other/file3";
+#endif
+
+    qint64 directoryID1 = -1, directoryID2 = -1, directoryID3 = -1;
+    QVERIFY(repository.accountFile(filename1, directoryID1));
+    QVERIFY(repository.accountFile(filename2, directoryID2));
+    QVERIFY(repository.accountFile(filename3, directoryID3));
+
+    QCOMPARE(directoryID1, directoryID2);
+    QVERIFY(directoryID1 != directoryID3);
+    QCOMPARE(repository.getDirectoryID(0), directoryID1);
+    QCOMPARE(repository.getDirectoryID(1), directoryID3);
+
+    QVERIFY(repository.removeFile(filename1, directoryID1));
+    QVERIFY(repository.removeFile(filename2, directoryID2));
+    repository.cleanupEmptyDirectories();
+
+    QCOMPARE(repository.getArtworksSourcesCount(), 1);
+    QCOMPARE(repository.getDirectoryID(0), directoryID3);
+    QCOMPARE(repository.getFilesCountForDirectory(0), 1);
+
+    qint64 newDirectoryID = -1;
+    QVERIFY(repository.accountFile(filename1, newDirectoryID));
+    QVERIFY(newDirectoryID != directoryID1);
+    QCOMPARE(repository.getDirectoryID(1), newDirectoryID);
+}
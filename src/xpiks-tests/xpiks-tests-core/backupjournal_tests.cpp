@@ -0,0 +1,210 @@
+#include "backupjournal_tests.h"
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDataStream>
+#include "../../xpiks-qt/MetadataIO/backupjournal.h"
+#include "../../xpiks-qt/MetadataIO/saverworkerjobitem.h"
+
+QHash<QString, QString> createBackup(const QString &title) {
+    QHash<QString, QString> dict;
+    dict["title"] = title;
+    dict["description"] = "description of " + title;
+    dict["keywords"] = "one,two,three";
+    return dict;
+}
+
+void BackupJournalTests::putAndGetInMemoryTest() {
+    MetadataIO::BackupJournal journal;
+    journal.putBackup("/images/1.jpg", createBackup("first"));
+
+    QHash<QString, QString> dict;
+    QVERIFY(journal.tryGetBackup("/images/1.jpg", dict));
+    QCOMPARE(dict, createBackup("first"));
+    QVERIFY(!journal.tryGetBackup("/images/2.jpg", dict));
+}
+
+void BackupJournalTests::restoreAfterReopenTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journalPath = dir.path() + "/backups.journal";
+
+    {
+        MetadataIO::BackupJournal journal;
+        journal.setJournalPath(journalPath);
+        journal.putBackup("/images/1.jpg", createBackup("first"));
+        journal.putBackup("/images/2.jpg", createBackup("second"));
+        journal.putBackup("/images/1.jpg", createBackup("first edited"));
+    }
+
+    MetadataIO::BackupJournal journal;
+    journal.setJournalPath(journalPath);
+
+    QHash<QString, QString> dict;
+    QVERIFY(journal.tryGetBackup("/images/1.jpg", dict));
+    QCOMPARE(dict, createBackup("first edited"));
+    QVERIFY(journal.tryGetBackup("/images/2.jpg", dict));
+    QCOMPARE(dict, createBackup("second"));
+}
+
+void BackupJournalTests::removeIsPersistedTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journalPath = dir.path() + "/backups.journal";
+
+    {
+        MetadataIO::BackupJournal journal;
+        journal.setJournalPath(journalPath);
+        journal.putBackup("/images/1.jpg", createBackup("first"));
+        journal.removeBackup("/images/1.jpg");
+    }
+
+    MetadataIO::BackupJournal journal;
+    journal.setJournalPath(journalPath);
+
+    QHash<QString, QString> dict;
+    QVERIFY(!journal.tryGetBackup("/images/1.jpg", dict));
+}
+
+void BackupJournalTests::incompleteRecordIsDroppedTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journalPath = dir.path() + "/backups.journal";
+
+    qint64 sizeBeforeLastRecord = 0;
+
+    {
+        MetadataIO::BackupJournal journal;
+        journal.setJournalPath(journalPath);
+        journal.putBackup("/images/1.jpg", createBackup("first"));
+        journal.close();
+
+        sizeBeforeLastRecord = QFileInfo(journalPath).size();
+    }
+
+    {
+        MetadataIO::BackupJournal journal;
+        journal.setJournalPath(journalPath);
+        journal.putBackup("/images/2.jpg", createBackup("second"));
+        journal.close();
+    }
+
+    // simulate crash in the middle of the last write
+    const qint64 fullSize = QFileInfo(journalPath).size();
+    QVERIFY(fullSize > sizeBeforeLastRecord + 1);
+    QVERIFY(QFile::resize(journalPath, fullSize - 1));
+
+    MetadataIO::BackupJournal journal;
+    journal.setJournalPath(journalPath);
+
+    QHash<QString, QString> dict;
+    QVERIFY(journal.tryGetBackup("/images/1.jpg", dict));
+    QCOMPARE(dict, createBackup("first"));
+    QVERIFY(!journal.tryGetBackup("/images/2.jpg", dict));
+
+    journal.close();
+    QCOMPARE(QFileInfo(journalPath).size(), sizeBeforeLastRecord);
+}
+
+void BackupJournalTests::removeManyIsPersistedTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journalPath = dir.path() + "/backups.journal";
+
+    {
+        MetadataIO::BackupJournal journal;
+        journal.setJournalPath(journalPath);
+        QVERIFY(journal.putBackup("/images/1.jpg", createBackup("first")));
+        QVERIFY(journal.putBackup("/images/2.jpg", createBackup("second")));
+        QVERIFY(journal.putBackup("/images/3.jpg", createBackup("third")));
+        journal.removeBackups(QStringList() << "/images/1.jpg" << "/images/3.jpg" << "/images/4.jpg");
+    }
+
+    MetadataIO::BackupJournal journal;
+    journal.setJournalPath(journalPath);
+
+    QHash<QString, QString> dict;
+    QVERIFY(!journal.tryGetBackup("/images/1.jpg", dict));
+    QVERIFY(journal.tryGetBackup("/images/2.jpg", dict));
+    QVERIFY(!journal.tryGetBackup("/images/3.jpg", dict));
+}
+
+void BackupJournalTests::legacyBackupIsMigratedOnceTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journalPath = dir.path() + "/backups.journal";
+    const QString imagePath = dir.path() + "/1.jpg";
+    const QString legacyPath = imagePath + ".xpks";
+
+    {
+        QFile legacyFile(legacyPath);
+        QVERIFY(legacyFile.open(QIODevice::WriteOnly));
+        QDataStream out(&legacyFile);
+        out << createBackup("legacy");
+    }
+
+    {
+        MetadataIO::BackupJournal journal;
+        journal.setJournalPath(journalPath);
+
+        MetadataIO::MetadataSavingCopy copy;
+        QVERIFY(copy.readFromJournal(&journal, imagePath));
+        QCOMPARE(copy.getInfo(), createBackup("legacy"));
+    }
+
+    QVERIFY(!QFile::exists(legacyPath));
+
+    MetadataIO::BackupJournal journal;
+    journal.setJournalPath(journalPath);
+
+    MetadataIO::MetadataSavingCopy copy;
+    QVERIFY(copy.readFromJournal(&journal, imagePath));
+    QCOMPARE(copy.getInfo(), createBackup("legacy"));
+}
+
+void BackupJournalTests::legacyDirectoryIsMigratedAtOnceTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journalPath = dir.path() + "/backups.journal";
+    const QString firstPath = dir.path() + "/1.jpg";
+    const QString secondPath = dir.path() + "/2.jpg";
+
+    {
+        QFile legacyFile(secondPath + ".xpks");
+        QVERIFY(legacyFile.open(QIODevice::WriteOnly));
+        QDataStream out(&legacyFile);
+        out << createBackup("second");
+    }
+
+    MetadataIO::BackupJournal journal;
+    journal.setJournalPath(journalPath);
+
+    MetadataIO::MetadataSavingCopy copy;
+    QVERIFY(!copy.readFromJournal(&journal, firstPath));
+    QVERIFY(!QFile::exists(secondPath + ".xpks"));
+
+    QHash<QString, QString> dict;
+    QVERIFY(journal.tryGetBackup(secondPath, dict));
+    QCOMPARE(dict, createBackup("second"));
+}
+
+void BackupJournalTests::unknownJournalIsKeptAsideTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journalPath = dir.path() + "/backups.journal";
+
+    {
+        QFile journalFile(journalPath);
+        QVERIFY(journalFile.open(QIODevice::WriteOnly));
+        QDataStream out(&journalFile);
+        out << (quint32)0x12345678 << (quint32)42;
+    }
+
+    MetadataIO::BackupJournal journal;
+    journal.setJournalPath(journalPath);
+    journal.putBackup("/images/1.jpg", createBackup("first"));
+
+    QVERIFY(QFile::exists(journalPath + ".unreadable"));
+
+    QHash<QString, QString> dict;
+    QVERIFY(journal.tryGetBackup("/images/1.jpg", dict));
+}
@@ -0,0 +1,21 @@
+#ifndef BACKUPJOURNALTESTS_H
+#define BACKUPJOURNALTESTS_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class BackupJournalTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void putAndGetInMemoryTest();
+    void restoreAfterReopenTest();
+    void removeIsPersistedTest();
+    void incompleteRecordIsDroppedTest();
+    void removeManyIsPersistedTest();
+    void legacyBackupIsMigratedOnceTest();
+    void legacyDirectoryIsMigratedAtOnceTest();
+    void unknownJournalIsKeptAsideTest();
+};
+
+#endif // BACKUPJOURNALTESTS_H
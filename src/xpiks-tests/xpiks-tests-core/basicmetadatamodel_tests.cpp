@@ -583,3 +583,27 @@ void BasicKeywordsModelTests::removeKeywordsCaseSensitiveTest() {
     QCOMPARE(basicModel.getKeywordsCount(), originalKeywords.length() - 1);
 }
 
+
+void BasicKeywordsModelTests::duplicatesCheckFollowsEditsTest() {
+    Common::BasicMetadataModel basicModel(m_FakeHold);
+
+    QVERIFY(basicModel.appendKeyword("Keyword"));
+    QVERIFY(!basicModel.appendKeyword("keyword"));
+
+    // changing case keeps keyword counted
+    QVERIFY(basicModel.editKeyword(0, "KEYWORD"));
+    QVERIFY(!basicModel.appendKeyword("keyword"));
+
+    QVERIFY(basicModel.editKeyword(0, "other"));
+    QVERIFY(basicModel.appendKeyword("keyword"));
+    QVERIFY(!basicModel.appendKeyword("Other"));
+
+    QString removedKeyword;
+    QVERIFY(basicModel.removeKeywordAt(0, removedKeyword));
+    QVERIFY(basicModel.appendKeyword("other"));
+
+    QVERIFY(basicModel.clearKeywords());
+    QVERIFY(basicModel.appendKeyword("Keyword"));
+    QVERIFY(basicModel.appendKeyword("Other"));
+    QCOMPARE(basicModel.getKeywordsCount(), 2);
+}
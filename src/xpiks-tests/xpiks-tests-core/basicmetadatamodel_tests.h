@@ -42,6 +42,7 @@ private slots:
     void removeKeywordsFromSetTest();
     void noneKeywordsRemovedFromSetTest();
     void removeKeywordsCaseSensitiveTest();
+    void duplicatesCheckFollowsEditsTest();
 
 private:
     Common::Hold m_FakeHold;
@@ -0,0 +1,82 @@
+#include "directoryscanner_tests.h"
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDir>
+#include "../../xpiks-qt/Helpers/directoryscanner.h"
+#include "../../xpiks-qt/Helpers/filenameshelpers.h"
+
+void createEmptyFile(const QString &filepath) {
+    QFile file(filepath);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.close();
+    }
+}
+
+void DirectoryScannerTests::scanNestedDirectoriesTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QDir root(dir.path());
+
+    QVERIFY(root.mkpath("shoot1/day1"));
+    QVERIFY(root.mkpath("shoot2"));
+
+    QStringList expected;
+    expected << root.filePath("shoot1/day1/a.jpg")
+             << root.filePath("shoot1/day1/a.eps")
+             << root.filePath("shoot1/b.JPEG")
+             << root.filePath("shoot2/c.tiff")
+             << root.filePath("d.ai");
+
+    foreach (const QString &filepath, expected) {
+        createEmptyFile(filepath);
+    }
+
+    Helpers::DirectoryScanner scanner(QStringList() << dir.path(), QStringList(), 3);
+    scanner.process();
+
+    QStringList found = scanner.getFoundFiles();
+    found.sort();
+    expected.sort();
+
+    QCOMPARE(found, expected);
+}
+
+void DirectoryScannerTests::skipUnsupportedFilesTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QDir root(dir.path());
+
+    createEmptyFile(root.filePath("image.png"));
+    createEmptyFile(root.filePath("image.jpg.xpks"));
+    createEmptyFile(root.filePath("readme"));
+    createEmptyFile(root.filePath(".hidden.jpg"));
+    createEmptyFile(root.filePath("image.jpg"));
+
+    Helpers::DirectoryScanner scanner(QStringList() << dir.path(), QStringList(), 1);
+    scanner.process();
+
+    QCOMPARE(scanner.getFoundFiles(), QStringList() << root.filePath("image.jpg"));
+}
+
+void DirectoryScannerTests::keepInitialFilesTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QDir root(dir.path());
+
+    createEmptyFile(root.filePath("image.jpg"));
+
+    Helpers::DirectoryScanner scanner(QStringList() << dir.path(), QStringList() << "/dropped/file.jpg", 2);
+    scanner.process();
+
+    QStringList expected;
+    expected << "/dropped/file.jpg" << root.filePath("image.jpg");
+    QCOMPARE(scanner.getFoundFiles(), expected);
+}
+
+void DirectoryScannerTests::fileSuffixTest() {
+    QCOMPARE(Helpers::getFileSuffix("/path/to/image.JPG"), QString("jpg"));
+    QCOMPARE(Helpers::getFileSuffix("/path/to/archive.tar.gz"), QString("gz"));
+    QCOMPARE(Helpers::getFileSuffix("/path.with.dots/file"), QString());
+    QCOMPARE(Helpers::getFileSuffix("C:\\dir.d\\file"), QString());
+    QCOMPARE(Helpers::getFileSuffix("file."), QString());
+}
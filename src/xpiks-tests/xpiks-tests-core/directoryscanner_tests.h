@@ -0,0 +1,17 @@
+#ifndef DIRECTORYSCANNERTESTS_H
+#define DIRECTORYSCANNERTESTS_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class DirectoryScannerTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void scanNestedDirectoriesTest();
+    void skipUnsupportedFilesTest();
+    void keepInitialFilesTest();
+    void fileSuffixTest();
+};
+
+#endif // DIRECTORYSCANNERTESTS_H
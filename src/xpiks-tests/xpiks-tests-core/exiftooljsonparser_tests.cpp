@@ -0,0 +1,69 @@
+#include "exiftooljsonparser_tests.h"
+#include <QVector>
+#include <QJsonObject>
+#include <QJsonArray>
+#include "../../xpiks-qt/MetadataIO/exiftooljsonparser.h"
+
+#define DECLARE_PARSER \
+    QVector<QJsonObject> objects;\
+    MetadataIO::ExiftoolJsonParser parser([&objects](const QJsonObject &object) { objects.append(object); });
+
+void ExiftoolJsonParserTests::parseWholeOutputTest() {
+    DECLARE_PARSER;
+
+    parser.feed("[{\n  \"SourceFile\": \"a.jpg\",\n  \"Title\": \"first\"\n},\n{\n  \"SourceFile\": \"b.jpg\",\n  \"Keywords\": [\"one\", \"two\"]\n}]\n");
+
+    QCOMPARE(objects.size(), 2);
+    QCOMPARE(parser.getParsedCount(), 2);
+    QCOMPARE(parser.getErrorsCount(), 0);
+    QCOMPARE(objects[0]["SourceFile"].toString(), QString("a.jpg"));
+    QCOMPARE(objects[0]["Title"].toString(), QString("first"));
+    QCOMPARE(objects[1]["SourceFile"].toString(), QString("b.jpg"));
+    QCOMPARE(objects[1]["Keywords"].toArray().size(), 2);
+}
+
+void ExiftoolJsonParserTests::parseByteByByteTest() {
+    DECLARE_PARSER;
+
+    const QByteArray output = "[{\"SourceFile\": \"a.jpg\", \"Nested\": {\"Inner\": 1}},{\"SourceFile\": \"b.jpg\"}]";
+    for (int i = 0; i < output.size(); ++i) {
+        parser.feed(output.mid(i, 1));
+    }
+
+    QCOMPARE(objects.size(), 2);
+    QCOMPARE(objects[0]["SourceFile"].toString(), QString("a.jpg"));
+    QCOMPARE(objects[0]["Nested"].toObject()["Inner"].toInt(), 1);
+    QCOMPARE(objects[1]["SourceFile"].toString(), QString("b.jpg"));
+}
+
+void ExiftoolJsonParserTests::parseBracesInsideStringsTest() {
+    DECLARE_PARSER;
+
+    parser.feed("[{\"SourceFile\": \"a.jpg\", \"Title\": \"}{ ]\"");
+    QCOMPARE(objects.size(), 0);
+    parser.feed("}]");
+
+    QCOMPARE(objects.size(), 1);
+    QCOMPARE(objects[0]["Title"].toString(), QString("}{ ]"));
+}
+
+void ExiftoolJsonParserTests::parseEscapedQuotesTest() {
+    DECLARE_PARSER;
+
+    parser.feed("[{\"SourceFile\": \"a.jpg\", \"Title\": \"say \\\"}\\\\\"}");
+    parser.feed(",{\"SourceFile\": \"b.jpg\"}]");
+
+    QCOMPARE(objects.size(), 2);
+    QCOMPARE(objects[0]["Title"].toString(), QString("say \"}\\"));
+    QCOMPARE(objects[1]["SourceFile"].toString(), QString("b.jpg"));
+}
+
+void ExiftoolJsonParserTests::skipBrokenObjectTest() {
+    DECLARE_PARSER;
+
+    parser.feed("[{\"SourceFile\": \"a.jpg\", \"Title\" \"missing colon\"},{\"SourceFile\": \"b.jpg\"}]");
+
+    QCOMPARE(objects.size(), 1);
+    QCOMPARE(parser.getErrorsCount(), 1);
+    QCOMPARE(objects[0]["SourceFile"].toString(), QString("b.jpg"));
+}
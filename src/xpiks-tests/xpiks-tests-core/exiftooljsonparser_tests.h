@@ -0,0 +1,18 @@
+#ifndef EXIFTOOLJSONPARSERTESTS_H
+#define EXIFTOOLJSONPARSERTESTS_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class ExiftoolJsonParserTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void parseWholeOutputTest();
+    void parseByteByByteTest();
+    void parseBracesInsideStringsTest();
+    void parseEscapedQuotesTest();
+    void skipBrokenObjectTest();
+};
+
+#endif // EXIFTOOLJSONPARSERTESTS_H
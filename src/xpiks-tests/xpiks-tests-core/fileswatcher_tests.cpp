@@ -0,0 +1,82 @@
+#include "fileswatcher_tests.h"
+#include <QTemporaryDir>
+#include <QSignalSpy>
+#include <QFile>
+#include <QDir>
+#include "../../xpiks-qt/Helpers/fileswatcher.h"
+
+// watcher reports changes after 500 ms delay
+#define WAIT_FOR_CHANGES_MS 1500
+#define WAIT_FOR_NO_CHANGES_MS 1000
+
+static QString createWatchedFile(const QDir &dir, const QString &filename) {
+    const QString filepath = dir.filePath(filename);
+    QFile file(filepath);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.close();
+    }
+
+    return filepath;
+}
+
+void FilesWatcherTests::removedFileIsReportedTest() {
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    QDir dir(tempDir.path());
+
+    const QString first = createWatchedFile(dir, "first.jpg");
+    const QString second = createWatchedFile(dir, "second.jpg");
+
+    Helpers::FilesWatcher watcher;
+    watcher.watchFiles(QStringList() << first << second);
+
+    QSignalSpy unavailableSpy(&watcher, SIGNAL(filesUnavailable(QStringList)));
+    QVERIFY(QFile::remove(second));
+
+    QVERIFY(unavailableSpy.wait(WAIT_FOR_CHANGES_MS));
+    QCOMPARE(unavailableSpy.count(), 1);
+
+    QStringList unavailableFiles = unavailableSpy.takeFirst().at(0).toStringList();
+    QCOMPARE(unavailableFiles, QStringList() << second);
+}
+
+void FilesWatcherTests::unwatchedFileIsNotReportedTest() {
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    QDir dir(tempDir.path());
+
+    const QString first = createWatchedFile(dir, "first.jpg");
+    const QString second = createWatchedFile(dir, "second.jpg");
+
+    Helpers::FilesWatcher watcher;
+    watcher.watchFiles(QStringList() << first << second);
+    watcher.unwatchFiles(QStringList() << second);
+
+    QSignalSpy unavailableSpy(&watcher, SIGNAL(filesUnavailable(QStringList)));
+    QVERIFY(QFile::remove(second));
+
+    QVERIFY(!unavailableSpy.wait(WAIT_FOR_NO_CHANGES_MS));
+}
+
+void FilesWatcherTests::oneWatchPerDirectoryTest() {
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    QDir dir(tempDir.path());
+    QVERIFY(dir.mkpath("subdir"));
+
+    QStringList files;
+    for (int i = 0; i < 10; ++i) {
+        files << createWatchedFile(dir, QString("image%1.jpg").arg(i));
+        files << createWatchedFile(dir, QString("subdir/image%1.jpg").arg(i));
+    }
+
+    Helpers::FilesWatcher watcher;
+    watcher.watchFiles(files);
+    QCOMPARE(watcher.getWatchedDirectoriesCount(), 2);
+
+    watcher.unwatchFiles(files.filter("subdir"));
+    QCOMPARE(watcher.getWatchedDirectoriesCount(), 1);
+
+    watcher.unwatchAll();
+    QCOMPARE(watcher.getWatchedDirectoriesCount(), 0);
+}
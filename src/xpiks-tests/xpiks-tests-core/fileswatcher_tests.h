@@ -0,0 +1,16 @@
+#ifndef FILESWATCHERTESTS_H
+#define FILESWATCHERTESTS_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class FilesWatcherTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void removedFileIsReportedTest();
+    void unwatchedFileIsNotReportedTest();
+    void oneWatchPerDirectoryTest();
+};
+
+#endif // FILESWATCHERTESTS_H
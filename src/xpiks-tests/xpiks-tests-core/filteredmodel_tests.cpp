@@ -441,3 +441,82 @@ void FilteredModelTests::clearEmptyKeywordsTest() {
     filteredItemsModel.clearKeywords(0);
     QVERIFY(!commandManagerMock.anyCommandProcessed());
 }
+
+void FilteredModelTests::sortByKeywordsCountTest() {
+    DECLARE_MODELS_AND_GENERATE(10);
+
+    for (int i = 0; i < 10; ++i) {
+        QStringList keywords;
+        for (int j = 0; j < 10 - i; ++j) { keywords << QString("keyword%1").arg(j); }
+        artItemsModelMock.getArtwork(i)->initialize("title", "description", keywords, true);
+    }
+
+    filteredItemsModel.setSortingMode(Models::FilteredArtItemsProxyModel::SortByKeywordsCount);
+    QCOMPARE(filteredItemsModel.getSortingMode(), (int)Models::FilteredArtItemsProxyModel::SortByKeywordsCount);
+
+    for (int i = 0; i < 10; ++i) {
+        QCOMPARE(filteredItemsModel.mapToSource(filteredItemsModel.index(i, 0)).row(), 9 - i);
+    }
+}
+
+void FilteredModelTests::sortModifiedFirstTest() {
+    DECLARE_MODELS_AND_GENERATE(10);
+
+    for (int i = 1; i < 10; i += 2) {
+        artItemsModelMock.getArtwork(i)->setModified();
+    }
+
+    filteredItemsModel.setSortingMode(Models::FilteredArtItemsProxyModel::SortByModified);
+
+    for (int i = 0; i < 5; ++i) {
+        QCOMPARE(filteredItemsModel.mapToSource(filteredItemsModel.index(i, 0)).row(), 2*i + 1);
+        QCOMPARE(filteredItemsModel.mapToSource(filteredItemsModel.index(i + 5, 0)).row(), 2*i);
+    }
+}
+
+void FilteredModelTests::toggleSortedTest() {
+    DECLARE_MODELS_AND_GENERATE(10);
+
+    for (int i = 0; i < 10; ++i) {
+        artItemsModelMock.getArtwork(i)->setFileSize(100 - i);
+    }
+
+    filteredItemsModel.setSortingMode(Models::FilteredArtItemsProxyModel::SortByFileSize);
+    QCOMPARE(filteredItemsModel.mapToSource(filteredItemsModel.index(0, 0)).row(), 9);
+
+    filteredItemsModel.toggleSorted();
+    QCOMPARE(filteredItemsModel.getSortingMode(), (int)Models::FilteredArtItemsProxyModel::NoSorting);
+    QCOMPARE(filteredItemsModel.mapToSource(filteredItemsModel.index(0, 0)).row(), 0);
+
+    filteredItemsModel.toggleSorted();
+    QCOMPARE(filteredItemsModel.getSortingMode(), (int)Models::FilteredArtItemsProxyModel::SortByFilename);
+    QCOMPARE(filteredItemsModel.mapToSource(filteredItemsModel.index(0, 0)).row(), 0);
+}
+
+void FilteredModelTests::sortByFilenameNumericTest() {
+    DECLARE_MODELS_AND_GENERATE(12);
+
+    filteredItemsModel.setSortingMode(Models::FilteredArtItemsProxyModel::SortByFilename);
+
+    // artwork2.jpg goes before artwork10.jpg
+    for (int i = 0; i < 12; ++i) {
+        QCOMPARE(filteredItemsModel.mapToSource(filteredItemsModel.index(i, 0)).row(), i);
+    }
+}
+
+void FilteredModelTests::sortKeysRemovedWithArtworksTest() {
+    DECLARE_MODELS_AND_GENERATE(10);
+
+    filteredItemsModel.setSortingMode(Models::FilteredArtItemsProxyModel::SortByFilename);
+    QCOMPARE(filteredItemsModel.getSortKeysCount(), 10);
+
+    QVector<QPair<int, int> > ranges;
+    ranges << qMakePair(2, 4);
+    artItemsModelMock.removeArtworks(ranges);
+
+    QCOMPARE(filteredItemsModel.getSortKeysCount(), artItemsModelMock.getArtworksCount());
+    QVERIFY(artItemsModelMock.getArtworksCount() < 10);
+
+    artItemsModelMock.deleteAllItems();
+    QCOMPARE(filteredItemsModel.getSortKeysCount(), 0);
+}
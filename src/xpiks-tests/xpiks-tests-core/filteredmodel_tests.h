@@ -30,6 +30,11 @@ private slots:
     void filterDescriptionAndKeywordsTest();
     void filterTitleAndKeywordsTest();
     void clearEmptyKeywordsTest();
+    void sortByKeywordsCountTest();
+    void sortModifiedFirstTest();
+    void toggleSortedTest();
+    void sortByFilenameNumericTest();
+    void sortKeysRemovedWithArtworksTest();
 };
 
 #endif // FILTEREDMODELTESTS_H
@@ -0,0 +1,113 @@
+#include "filterengine_tests.h"
+#include <QSignalSpy>
+#include "Mocks/artitemsmodelmock.h"
+#include "Mocks/commandmanagermock.h"
+#include "../../xpiks-qt/Models/filterengine.h"
+#include "../../xpiks-qt/Models/searchindex.h"
+#include "../../xpiks-qt/Models/artworksrepository.h"
+
+#define DECLARE_MODELS_AND_GENERATE(count) \
+    Mocks::CommandManagerMock commandManagerMock;\
+    Mocks::ArtItemsModelMock artItemsModelMock;\
+    Models::ArtworksRepository artworksRepository;\
+    commandManagerMock.InjectDependency(&artworksRepository);\
+    commandManagerMock.InjectDependency(&artItemsModelMock);\
+    commandManagerMock.generateAndAddArtworks(count);\
+    for (int i = 0; i < count; ++i) {\
+        Models::ArtworkMetadata *metadata = artItemsModelMock.getArtwork(i);\
+        if (i % 2 == 0) {\
+            metadata->initialize("Sunset title", "Beach at evening", QStringList() << "sunset" << "sea", true);\
+        } else {\
+            metadata->initialize("Mountain title", "Peaks in fog", QStringList() << "mountain" << "rock", true);\
+        }\
+    }\
+    Models::SearchIndex searchIndex;\
+    Models::FilterEngine filterEngine;
+
+static int countAccepted(Models::FilterEngine &filterEngine, Mocks::ArtItemsModelMock &artItemsModelMock) {
+    int count = 0;
+    const int size = artItemsModelMock.getArtworksCount();
+    for (int i = 0; i < size; ++i) {
+        bool accepted = false;
+        if (filterEngine.tryGetResult(i, artItemsModelMock.getArtwork(i), accepted) && accepted) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+void FilterEngineTests::parallelEvaluationTest() {
+    DECLARE_MODELS_AND_GENERATE(3000);
+
+    filterEngine.evaluate(&artItemsModelMock, searchIndex, "sunset", false);
+    QVERIFY(filterEngine.hasResultsFor("sunset", false));
+    QVERIFY(!filterEngine.hasResultsFor("sunset", true));
+    QCOMPARE(countAccepted(filterEngine, artItemsModelMock), 1500);
+
+    searchIndex.update(&artItemsModelMock);
+    searchIndex.findCandidates("sunset fog", true);
+    filterEngine.evaluate(&artItemsModelMock, searchIndex, "sunset fog", true);
+    QCOMPARE(countAccepted(filterEngine, artItemsModelMock), 0);
+}
+
+void FilterEngineTests::editedArtworkResultIsStaleTest() {
+    DECLARE_MODELS_AND_GENERATE(10);
+
+    filterEngine.evaluate(&artItemsModelMock, searchIndex, "mountain", false);
+
+    Models::ArtworkMetadata *metadata = artItemsModelMock.getArtwork(0);
+    bool accepted = true;
+    QVERIFY(filterEngine.tryGetResult(0, metadata, accepted));
+    QVERIFY(!accepted);
+
+    metadata->appendKeyword("mountain");
+    QVERIFY(!filterEngine.tryGetResult(0, metadata, accepted));
+    // result of another row is never used
+    QVERIFY(!filterEngine.tryGetResult(1, metadata, accepted));
+}
+
+void FilterEngineTests::asyncEvaluationTest() {
+    DECLARE_MODELS_AND_GENERATE(3000);
+    QSignalSpy finishedSpy(&filterEngine, SIGNAL(evaluationFinished()));
+
+    filterEngine.startEvaluation(&artItemsModelMock, searchIndex, "fog", false);
+    QVERIFY(finishedSpy.wait(10000));
+
+    QVERIFY(filterEngine.hasResultsFor("fog", false));
+    QVERIFY(filterEngine.canReuseResults("fog", false));
+    QCOMPARE(countAccepted(filterEngine, artItemsModelMock), 1500);
+}
+
+void FilterEngineTests::staleEvaluationIsCancelledTest() {
+    DECLARE_MODELS_AND_GENERATE(3000);
+    QSignalSpy finishedSpy(&filterEngine, SIGNAL(evaluationFinished()));
+
+    filterEngine.startEvaluation(&artItemsModelMock, searchIndex, "sun", false);
+    filterEngine.startEvaluation(&artItemsModelMock, searchIndex, "sunset", false);
+    QVERIFY(finishedSpy.wait(10000));
+    QCoreApplication::processEvents();
+
+    QCOMPARE(finishedSpy.count(), 1);
+    QVERIFY(!filterEngine.hasResultsFor("sun", false));
+    QVERIFY(filterEngine.hasResultsFor("sunset", false));
+    QCOMPARE(countAccepted(filterEngine, artItemsModelMock), 1500);
+
+    filterEngine.startEvaluation(&artItemsModelMock, searchIndex, "rock", false);
+    filterEngine.cancelEvaluation();
+    QVERIFY(!filterEngine.isEvaluating());
+    QVERIFY(!filterEngine.hasResultsFor("rock", false));
+}
+
+void FilterEngineTests::reservedTermsResultsAreNotReusedTest() {
+    DECLARE_MODELS_AND_GENERATE(10);
+
+    for (int i = 0; i < 10; i += 3) {
+        artItemsModelMock.getArtwork(i)->setModified();
+    }
+
+    filterEngine.evaluate(&artItemsModelMock, searchIndex, "x:modified", false);
+    QVERIFY(filterEngine.hasResultsFor("x:modified", false));
+    QVERIFY(!filterEngine.canReuseResults("x:modified", false));
+    QCOMPARE(countAccepted(filterEngine, artItemsModelMock), 4);
+}
@@ -0,0 +1,18 @@
+#ifndef FILTERENGINETESTS_H
+#define FILTERENGINETESTS_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class FilterEngineTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void parallelEvaluationTest();
+    void editedArtworkResultIsStaleTest();
+    void asyncEvaluationTest();
+    void staleEvaluationIsCancelledTest();
+    void reservedTermsResultsAreNotReusedTest();
+};
+
+#endif // FILTERENGINETESTS_H
@@ -305,3 +305,32 @@ void IndicesToRangesTests::allSameNumbersTest() {
     Pairs expectedPairs = MAKE_PAIRS(1, 0, 0);
     COMPARE_PAIRS(actualPairs, expectedPairs);
 }
+
+void IndicesToRangesTests::unionAdjacentRangesTest() {
+    Helpers::RangesVector ranges;
+    ranges.emplace_back(5, 7);
+    ranges.emplace_back(0, 2);
+    ranges.emplace_back(3, 4);
+    ranges.emplace_back(6, 6);
+
+    Helpers::RangesVector result = Helpers::unionAdjacentRanges(ranges);
+
+    QCOMPARE((int)result.size(), 1);
+    QCOMPARE(result[0].first, 0);
+    QCOMPARE(result[0].second, 7);
+}
+
+void IndicesToRangesTests::unionAdjacentRangesKeepsGapsTest() {
+    Helpers::RangesVector ranges;
+    ranges.emplace_back(0, 1);
+    ranges.emplace_back(3, 3);
+    ranges.emplace_back(4, 9);
+
+    Helpers::RangesVector result = Helpers::unionAdjacentRanges(ranges);
+
+    QCOMPARE((int)result.size(), 2);
+    QCOMPARE(result[0].first, 0);
+    QCOMPARE(result[0].second, 1);
+    QCOMPARE(result[1].first, 3);
+    QCOMPARE(result[1].second, 9);
+}
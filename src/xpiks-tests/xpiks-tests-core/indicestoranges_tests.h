@@ -31,6 +31,8 @@ private slots:
     void splitIntoMoreThanAHalfTest();
     void sameNumbersTest();
     void allSameNumbersTest();
+    void unionAdjacentRangesTest();
+    void unionAdjacentRangesKeepsGapsTest();
 };
 
 #endif // INDICESTORANGES_TESTS_H
@@ -0,0 +1,206 @@
+#include "itemprocessingworker_tests.h"
+#include <QtConcurrent>
+#include <QAtomicInt>
+#include <QMutex>
+#include "../../xpiks-qt/Common/itemprocessingworker.h"
+#include "../../xpiks-qt/Common/sharedworkqueue.h"
+
+namespace {
+    // negative items are barriers and are never taken into a batch
+    class BatchingWorker: public Common::ItemProcessingWorker<int>
+    {
+    public:
+        BatchingWorker(size_t maxBatchSize = 100):
+            m_MaxBatchSize(maxBatchSize)
+        { }
+
+    public:
+        bool takeItems(std::vector<std::shared_ptr<int> > &items, size_t maxCount) {
+            return takeQueuedItems(items, maxCount, &BatchingWorker::isBatchItem);
+        }
+
+        int getEmptyNotificationsCount() const { return m_EmptyNotificationsCount.loadAcquire(); }
+        int getProcessedCount() const { return m_ProcessedCount.loadAcquire(); }
+        std::vector<size_t> getBatchSizes() { QMutexLocker locker(&m_Mutex); return m_BatchSizes; }
+
+    protected:
+        virtual bool initWorker() override { return true; }
+
+        virtual void processOneItem(std::shared_ptr<int> &item) override {
+            std::vector<std::shared_ptr<int> > batch;
+            batch.push_back(item);
+
+            if (isBatchItem(item)) {
+                takeItems(batch, m_MaxBatchSize);
+            }
+
+            {
+                QMutexLocker locker(&m_Mutex);
+                m_BatchSizes.push_back(batch.size());
+            }
+
+            m_ProcessedCount.fetchAndAddOrdered((int)batch.size());
+        }
+
+        virtual void notifyQueueIsEmpty() override { m_EmptyNotificationsCount.fetchAndAddOrdered(1); }
+        virtual void workerStopped() override { }
+
+    private:
+        static bool isBatchItem(const std::shared_ptr<int> &item) { return *item >= 0; }
+
+    private:
+        QMutex m_Mutex;
+        std::vector<size_t> m_BatchSizes;
+        QAtomicInt m_EmptyNotificationsCount;
+        QAtomicInt m_ProcessedCount;
+        size_t m_MaxBatchSize;
+    };
+
+    std::vector<std::shared_ptr<int> > createItems(const QVector<int> &values) {
+        std::vector<std::shared_ptr<int> > items;
+        for (int value: values) {
+            items.emplace_back(new int(value));
+        }
+
+        return items;
+    }
+}
+
+void ItemProcessingWorkerTests::takeQueuedItemsStopsAtBarrierTest() {
+    BatchingWorker worker;
+    worker.submitItems(createItems(QVector<int>() << 1 << 2 << -1 << 3));
+
+    std::vector<std::shared_ptr<int> > batch;
+    bool isEmpty = worker.takeItems(batch, 10);
+
+    QVERIFY(!isEmpty);
+    QCOMPARE(batch.size(), (size_t)2);
+    QCOMPARE(*batch[0], 1);
+    QCOMPARE(*batch[1], 2);
+
+    // barrier stays at the front
+    batch.clear();
+    isEmpty = worker.takeItems(batch, 10);
+    QVERIFY(!isEmpty);
+    QVERIFY(batch.empty());
+}
+
+void ItemProcessingWorkerTests::takeQueuedItemsRespectsMaxCountTest() {
+    BatchingWorker worker;
+    worker.submitItems(createItems(QVector<int>() << 1 << 2 << 3 << 4 << 5));
+
+    std::vector<std::shared_ptr<int> > batch;
+    bool isEmpty = worker.takeItems(batch, 3);
+
+    QVERIFY(!isEmpty);
+    QCOMPARE(batch.size(), (size_t)3);
+
+    isEmpty = worker.takeItems(batch, 10);
+    QVERIFY(isEmpty);
+    QCOMPARE(batch.size(), (size_t)5);
+    QCOMPARE(*batch.back(), 5);
+    QVERIFY(!worker.hasPendingJobs());
+}
+
+void ItemProcessingWorkerTests::queueEmptySignalledOncePerBatchTest() {
+    BatchingWorker worker;
+    QFuture<void> future = QtConcurrent::run([&worker]() { worker.doWork(); });
+
+    worker.submitItems(createItems(QVector<int>() << 1 << 2 << 3 << 4 << 5 << 6 << 7 << 8 << 9 << 10));
+    QTRY_COMPARE(worker.getProcessedCount(), 10);
+    QTRY_COMPARE(worker.getEmptyNotificationsCount(), 1);
+
+    worker.submitItems(createItems(QVector<int>() << 11 << 12 << 13));
+    QTRY_COMPARE(worker.getProcessedCount(), 13);
+    QTRY_COMPARE(worker.getEmptyNotificationsCount(), 2);
+
+    worker.stopWorking();
+    future.waitForFinished();
+
+    QCOMPARE(worker.getEmptyNotificationsCount(), 2);
+}
+
+void ItemProcessingWorkerTests::queueEmptySignalledAfterBarrierTest() {
+    BatchingWorker worker(2);
+    // submitted before the worker starts so the queue is processed in one go
+    worker.submitItems(createItems(QVector<int>() << 1 << 2 << 3 << -1 << 4 << 5));
+
+    QFuture<void> future = QtConcurrent::run([&worker]() { worker.doWork(); });
+
+    QTRY_COMPARE(worker.getProcessedCount(), 6);
+    QTRY_COMPARE(worker.getEmptyNotificationsCount(), 1);
+
+    worker.stopWorking();
+    future.waitForFinished();
+
+    std::vector<size_t> batchSizes = worker.getBatchSizes();
+    QCOMPARE(batchSizes.size(), (size_t)4);
+    QCOMPARE(batchSizes[0], (size_t)2);
+    QCOMPARE(batchSizes[1], (size_t)1);
+    QCOMPARE(batchSizes[2], (size_t)1);
+    QCOMPARE(batchSizes[3], (size_t)2);
+    QCOMPARE(worker.getEmptyNotificationsCount(), 1);
+}
+
+void ItemProcessingWorkerTests::sharedQueueMultipleConsumersTest() {
+    const int itemsCount = 10000;
+    const int consumersCount = 4;
+
+    QVector<int> items;
+    items.reserve(itemsCount);
+    for (int i = 0; i < itemsCount; ++i) {
+        items.append(i * 2);
+    }
+
+    Common::SharedWorkQueue<int> queue(items);
+    QVector<QAtomicInt> hits(itemsCount);
+    // no detaching from consumer threads
+    QAtomicInt *hitsData = hits.data();
+    QAtomicInt lastItemsCount;
+    QAtomicInt mismatchesCount;
+
+    auto consume = [&]() {
+        int item = 0, index = 0;
+        while (queue.tryGetNext(item, index)) {
+            if (item != index * 2) {
+                mismatchesCount.fetchAndAddOrdered(1);
+            }
+
+            hitsData[index].fetchAndAddOrdered(1);
+
+            if (queue.markProcessed()) {
+                lastItemsCount.fetchAndAddOrdered(1);
+            }
+        }
+    };
+
+    QVector<QFuture<void> > consumers;
+    for (int i = 0; i < consumersCount; ++i) {
+        consumers.append(QtConcurrent::run(consume));
+    }
+
+    for (auto &consumer: consumers) {
+        consumer.waitForFinished();
+    }
+
+    QCOMPARE(mismatchesCount.loadAcquire(), 0);
+    QCOMPARE(lastItemsCount.loadAcquire(), 1);
+    QCOMPARE(queue.getProcessedCount(), itemsCount);
+
+    for (int i = 0; i < itemsCount; ++i) {
+        QCOMPARE(hits[i].loadAcquire(), 1);
+    }
+}
+
+void ItemProcessingWorkerTests::sharedQueueCancelTest() {
+    Common::SharedWorkQueue<int> queue(QVector<int>() << 1 << 2 << 3);
+    int item = 0, index = 0;
+
+    QVERIFY(queue.tryGetNext(item, index));
+    QCOMPARE(index, 0);
+
+    queue.cancel();
+
+    QVERIFY(queue.isCancelled());
+    QVERIFY(!queue.tryGetNext(item, index));
+}
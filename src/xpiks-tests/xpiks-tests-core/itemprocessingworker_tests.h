@@ -0,0 +1,19 @@
+#ifndef ITEMPROCESSINGWORKERTESTS_H
+#define ITEMPROCESSINGWORKERTESTS_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class ItemProcessingWorkerTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void takeQueuedItemsStopsAtBarrierTest();
+    void takeQueuedItemsRespectsMaxCountTest();
+    void queueEmptySignalledOncePerBatchTest();
+    void queueEmptySignalledAfterBarrierTest();
+    void sharedQueueMultipleConsumersTest();
+    void sharedQueueCancelTest();
+};
+
+#endif // ITEMPROCESSINGWORKERTESTS_H
@@ -0,0 +1,146 @@
+#include "keywordspool_tests.h"
+#include <QtConcurrent>
+#include "../../xpiks-qt/Common/keywordspool.h"
+#include "Mocks/artworkmetadatamock.h"
+
+void KeywordsPoolTests::sameKeywordHasSameIDTest() {
+    Common::KeywordsPool &pool = Common::KeywordsPool::getInstance();
+
+    QString first, second;
+    Common::KeywordID firstID = pool.intern(QString("pooled") + "keyword", first);
+    Common::KeywordID secondID = pool.intern(QString("pooledkey") + "word", second);
+
+    QCOMPARE(firstID, secondID);
+    QCOMPARE(first, QString("pooledkeyword"));
+    // pooled strings share same data
+    QVERIFY(first.constData() == second.constData());
+    QCOMPARE(pool.getKeyword(firstID), QString("pooledkeyword"));
+}
+
+void KeywordsPoolTests::differentCaseHasSameInvariantTest() {
+    Common::KeywordsPool &pool = Common::KeywordsPool::getInstance();
+
+    Common::KeywordID upperID = pool.intern("CaseKeyword");
+    Common::KeywordID lowerID = pool.intern("casekeyword");
+
+    QVERIFY(upperID != lowerID);
+    QCOMPARE(pool.getInvariantID(upperID), lowerID);
+    QCOMPARE(pool.getInvariantID(lowerID), lowerID);
+
+    Common::KeywordID invariantID;
+    QVERIFY(pool.tryGetInvariantID("CASEKEYWORD", invariantID));
+    QCOMPARE(invariantID, lowerID);
+
+    QVERIFY(pool.containsInvariant(QVector<Common::KeywordID>() << upperID, invariantID));
+}
+
+void KeywordsPoolTests::unknownKeywordHasNoInvariantTest() {
+    Common::KeywordsPool &pool = Common::KeywordsPool::getInstance();
+    const int countBefore = pool.getKeywordsCount();
+
+    Common::KeywordID invariantID;
+    QVERIFY(!pool.tryGetInvariantID("never added keyword", invariantID));
+    QCOMPARE(pool.getKeywordsCount(), countBefore);
+}
+
+void KeywordsPoolTests::artworksShareKeywordIDsTest() {
+    Mocks::ArtworkMetadataMock first("first.jpg");
+    Mocks::ArtworkMetadataMock second("second.jpg");
+
+    first.appendKeywords(QStringList() << "shared" << "first");
+    second.appendKeywords(QStringList() << "second" << "shared");
+
+    auto firstIDs = first.getKeywordIDs();
+    auto secondIDs = second.getKeywordIDs();
+
+    QCOMPARE(firstIDs.size(), 2);
+    QCOMPARE(secondIDs.size(), 2);
+    QCOMPARE(firstIDs[0], secondIDs[1]);
+    QVERIFY(firstIDs[1] != secondIDs[0]);
+
+    QString removed;
+    first.removeKeywordAt(0, removed);
+    QCOMPARE(first.getKeywordIDs().size(), 1);
+    QCOMPARE(first.getKeywordIDs()[0], firstIDs[1]);
+}
+
+void KeywordsPoolTests::releasedKeywordIsRemovedTest() {
+    Common::KeywordsPool &pool = Common::KeywordsPool::getInstance();
+    const int countBefore = pool.getKeywordsCount();
+
+    Common::KeywordID firstID = pool.intern("releasedkeyword");
+    Common::KeywordID secondID = pool.intern("releasedkeyword");
+    QCOMPARE(firstID, secondID);
+    QCOMPARE(pool.getKeywordsCount(), countBefore + 1);
+
+    pool.release(firstID);
+    QCOMPARE(pool.getKeywordsCount(), countBefore + 1);
+
+    pool.release(secondID);
+    QCOMPARE(pool.getKeywordsCount(), countBefore);
+
+    Common::KeywordID invariantID;
+    QVERIFY(!pool.tryGetInvariantID("releasedkeyword", invariantID));
+}
+
+void KeywordsPoolTests::variantHoldsInvariantTest() {
+    Common::KeywordsPool &pool = Common::KeywordsPool::getInstance();
+    const int countBefore = pool.getKeywordsCount();
+
+    Common::KeywordID upperID = pool.intern("HeldKeyword");
+    // variant and its lower-cased invariant
+    QCOMPARE(pool.getKeywordsCount(), countBefore + 2);
+
+    Common::KeywordID lowerID = pool.intern("heldkeyword");
+    QCOMPARE(pool.getInvariantID(upperID), lowerID);
+
+    pool.release(lowerID);
+    QCOMPARE(pool.getKeywordsCount(), countBefore + 2);
+    QCOMPARE(pool.getKeyword(pool.getInvariantID(upperID)), QString("heldkeyword"));
+
+    pool.release(upperID);
+    QCOMPARE(pool.getKeywordsCount(), countBefore);
+}
+
+void KeywordsPoolTests::removedArtworkKeywordsAreReleasedTest() {
+    Common::KeywordsPool &pool = Common::KeywordsPool::getInstance();
+    const int countBefore = pool.getKeywordsCount();
+
+    {
+        Mocks::ArtworkMetadataMock artwork("released.jpg");
+        artwork.appendKeywords(QStringList() << "uniquefirst" << "uniquesecond");
+        QCOMPARE(pool.getKeywordsCount(), countBefore + 2);
+
+        QString removed;
+        artwork.removeKeywordAt(0, removed);
+        QCOMPARE(pool.getKeywordsCount(), countBefore + 1);
+
+        artwork.editKeyword(0, "uniquethird");
+        QCOMPARE(pool.getKeywordsCount(), countBefore + 1);
+        QCOMPARE(pool.getKeywords(artwork.getKeywordIDs()), QStringList() << "uniquethird");
+    }
+
+    QCOMPARE(pool.getKeywordsCount(), countBefore);
+}
+
+void KeywordsPoolTests::concurrentInternTest() {
+    Common::KeywordsPool &pool = Common::KeywordsPool::getInstance();
+    const int countBefore = pool.getKeywordsCount();
+
+    QStringList keywords;
+    for (int i = 0; i < 200; ++i) {
+        keywords << QString("Concurrent%1").arg(i % 50);
+    }
+
+    QtConcurrent::blockingMap(keywords, [&pool](const QString &keyword) {
+        for (int i = 0; i < 100; ++i) {
+            Common::KeywordID id = pool.intern(keyword);
+            QString pooled = pool.getKeyword(id);
+            Q_ASSERT(pooled == keyword);
+            Q_UNUSED(pooled);
+            pool.release(id);
+        }
+    });
+
+    QCOMPARE(pool.getKeywordsCount(), countBefore);
+}
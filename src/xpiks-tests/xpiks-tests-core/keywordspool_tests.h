@@ -0,0 +1,21 @@
+#ifndef KEYWORDSPOOLTESTS_H
+#define KEYWORDSPOOLTESTS_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class KeywordsPoolTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void sameKeywordHasSameIDTest();
+    void differentCaseHasSameInvariantTest();
+    void unknownKeywordHasNoInvariantTest();
+    void artworksShareKeywordIDsTest();
+    void releasedKeywordIsRemovedTest();
+    void variantHoldsInvariantTest();
+    void removedArtworkKeywordsAreReleasedTest();
+    void concurrentInternTest();
+};
+
+#endif // KEYWORDSPOOLTESTS_H
@@ -27,6 +27,20 @@
 #include "deletekeywords_tests.h"
 #include "preset_tests.h"
 #include "quickbuffer_tests.h"
+#include "exiftooljsonparser_tests.h"
+#include "metadatareadcache_tests.h"
+#include "backupjournal_tests.h"
+#include "directoryscanner_tests.h"
+#include "fileswatcher_tests.h"
+#include "searchindex_tests.h"
+#include "filterengine_tests.h"
+#include "keywordspool_tests.h"
+#include "wordsverdictcache_tests.h"
+#include "userdictionary_tests.h"
+#include "suggestionscache_tests.h"
+#include "itemprocessingworker_tests.h"
+#include "spellcheckbatch_tests.h"
+#include "recordjournal_tests.h"
 
 #define QTEST_CLASS(TestObject, vName, result) \
     TestObject vName; \
@@ -63,6 +77,20 @@ int main(int argc, char *argv[]) {
     QTEST_CLASS(DeleteKeywordsTests, dkt, result);
     QTEST_CLASS(PresetTests, pst, result);
     QTEST_CLASS(QuickBufferTests, qbt, result);
+    QTEST_CLASS(ExiftoolJsonParserTests, ejpt, result);
+    QTEST_CLASS(MetadataReadCacheTests, mrct, result);
+    QTEST_CLASS(BackupJournalTests, bjt, result);
+    QTEST_CLASS(DirectoryScannerTests, dst, result);
+    QTEST_CLASS(FilesWatcherTests, fwt, result);
+    QTEST_CLASS(SearchIndexTests, sit, result);
+    QTEST_CLASS(FilterEngineTests, fet, result);
+    QTEST_CLASS(KeywordsPoolTests, kpt, result);
+    QTEST_CLASS(WordsVerdictCacheTests, wvct, result);
+    QTEST_CLASS(UserDictionaryTests, udt, result);
+    QTEST_CLASS(SuggestionsCacheTests, sct, result);
+    QTEST_CLASS(ItemProcessingWorkerTests, ipwt, result);
+    QTEST_CLASS(SpellCheckBatchTests, scbt, result);
+    QTEST_CLASS(RecordJournalTests, rjt, result);
 
     QThread::sleep(1);
 
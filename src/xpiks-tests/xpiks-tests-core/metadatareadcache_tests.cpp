@@ -0,0 +1,125 @@
+#include "metadatareadcache_tests.h"
+#include <QTemporaryDir>
+#include "../../xpiks-qt/MetadataIO/metadatareadcache.h"
+
+#define DECLARE_CACHE_WITH_ONE_RESULT \
+    MetadataIO::MetadataReadCache cache;\
+    const QString filepath = "/path/to/image.jpg";\
+    const QDateTime lastModified = QDateTime::fromMSecsSinceEpoch(1000000);\
+    MetadataIO::ImportDataResult original;\
+    original.FilePath = filepath;\
+    original.Title = "title";\
+    original.Description = "description";\
+    original.Keywords << "one" << "two";\
+    original.ImageSize = QSize(100, 200);\
+    original.FileSize = 12345;\
+    cache.put(filepath, lastModified, original);
+
+void MetadataReadCacheTests::cacheHitTest() {
+    DECLARE_CACHE_WITH_ONE_RESULT;
+
+    MetadataIO::ImportDataResult result;
+    QVERIFY(cache.tryGet(filepath, lastModified, original.FileSize, result));
+
+    QCOMPARE(result.FilePath, filepath);
+    QCOMPARE(result.Title, original.Title);
+    QCOMPARE(result.Description, original.Description);
+    QCOMPARE(result.Keywords, original.Keywords);
+    QCOMPARE(result.ImageSize, original.ImageSize);
+    QCOMPARE(result.FileSize, original.FileSize);
+}
+
+void MetadataReadCacheTests::cacheMissForUnknownFileTest() {
+    DECLARE_CACHE_WITH_ONE_RESULT;
+
+    MetadataIO::ImportDataResult result;
+    QVERIFY(!cache.tryGet("/path/to/other.jpg", lastModified, original.FileSize, result));
+}
+
+void MetadataReadCacheTests::cacheMissForModifiedFileTest() {
+    DECLARE_CACHE_WITH_ONE_RESULT;
+
+    MetadataIO::ImportDataResult result;
+    QVERIFY(!cache.tryGet(filepath, lastModified.addSecs(1), original.FileSize, result));
+}
+
+void MetadataReadCacheTests::cacheMissForResizedFileTest() {
+    DECLARE_CACHE_WITH_ONE_RESULT;
+
+    MetadataIO::ImportDataResult result;
+    QVERIFY(!cache.tryGet(filepath, lastModified, original.FileSize + 1, result));
+}
+
+void MetadataReadCacheTests::backupIsNotCachedTest() {
+    DECLARE_CACHE_WITH_ONE_RESULT;
+
+    MetadataIO::ImportDataResult withBackup = original;
+    withBackup.BackupDict.insert("title", "backup title");
+    cache.put(filepath, lastModified, withBackup);
+
+    MetadataIO::ImportDataResult result;
+    QVERIFY(cache.tryGet(filepath, lastModified, original.FileSize, result));
+    QVERIFY(result.BackupDict.isEmpty());
+}
+
+void MetadataReadCacheTests::restoreAfterSaveTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString cachePath = dir.path() + "/metadata.cache";
+
+    {
+        DECLARE_CACHE_WITH_ONE_RESULT;
+        cache.setCachePath(cachePath);
+        cache.saveToFile();
+    }
+
+    MetadataIO::MetadataReadCache cache;
+    cache.setCachePath(cachePath);
+    cache.ensureLoaded();
+    QCOMPARE(cache.size(), 1);
+
+    MetadataIO::ImportDataResult result;
+    QVERIFY(cache.tryGet("/path/to/image.jpg", QDateTime::fromMSecsSinceEpoch(1000000), 12345, result));
+    QCOMPARE(result.Title, QString("title"));
+}
+
+void MetadataReadCacheTests::unusedEntriesArePrunedOnSaveTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString cachePath = dir.path() + "/metadata.cache";
+    const QDateTime lastModified = QDateTime::fromMSecsSinceEpoch(1000000);
+
+    MetadataIO::ImportDataResult result;
+    result.FileSize = 100;
+
+    {
+        MetadataIO::MetadataReadCache cache;
+        cache.setCachePath(cachePath);
+        cache.ensureLoaded();
+        cache.put("/missing/1.jpg", lastModified, result);
+        cache.put("/missing/2.jpg", lastModified, result);
+        cache.put("/missing/3.jpg", lastModified, result);
+        cache.saveToFile();
+    }
+
+    {
+        MetadataIO::MetadataReadCache cache(2);
+        cache.setCachePath(cachePath);
+        cache.ensureLoaded();
+        QCOMPARE(cache.size(), 3);
+
+        QVERIFY(cache.tryGet("/missing/1.jpg", lastModified, result.FileSize, result));
+        cache.put("/missing/4.jpg", lastModified, result);
+        cache.saveToFile();
+
+        // entries used in this session are kept even if files are not found
+        QCOMPARE(cache.size(), 2);
+    }
+
+    MetadataIO::MetadataReadCache cache;
+    cache.setCachePath(cachePath);
+    cache.ensureLoaded();
+    QCOMPARE(cache.size(), 2);
+    QVERIFY(cache.tryGet("/missing/1.jpg", lastModified, result.FileSize, result));
+    QVERIFY(cache.tryGet("/missing/4.jpg", lastModified, result.FileSize, result));
+}
@@ -0,0 +1,20 @@
+#ifndef METADATAREADCACHETESTS_H
+#define METADATAREADCACHETESTS_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class MetadataReadCacheTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void cacheHitTest();
+    void cacheMissForUnknownFileTest();
+    void cacheMissForModifiedFileTest();
+    void cacheMissForResizedFileTest();
+    void backupIsNotCachedTest();
+    void restoreAfterSaveTest();
+    void unusedEntriesArePrunedOnSaveTest();
+};
+
+#endif // METADATAREADCACHETESTS_H
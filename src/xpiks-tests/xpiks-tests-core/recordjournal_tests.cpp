@@ -0,0 +1,137 @@
+#include "recordjournal_tests.h"
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDataStream>
+#include "../../xpiks-qt/Helpers/recordjournal.h"
+
+#define TEST_MAGIC 0x58505454
+#define TEST_VERSION 1
+#define TEST_MAX_RECORD_SIZE 1024
+
+QByteArray serializeString(const QString &value) {
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_0);
+    out << value;
+    return Helpers::RecordJournal::serializeRecord(payload);
+}
+
+QStringList readStrings(Helpers::RecordJournal &journal, Helpers::RecordJournal::ReadResult &result) {
+    QStringList values;
+    result = journal.read([&values](QDataStream &record) {
+        QString value;
+        record >> value;
+        values.append(value);
+    });
+    return values;
+}
+
+void RecordJournalTests::recordsAreReplayedTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journalPath = dir.path() + "/test.journal";
+
+    {
+        Helpers::RecordJournal journal(TEST_MAGIC, TEST_VERSION, TEST_MAX_RECORD_SIZE, false);
+        journal.setPath(journalPath);
+        QVERIFY(journal.openForAppend());
+        QVERIFY(journal.appendRecords(serializeString("first"), 1));
+        QVERIFY(journal.appendRecords(serializeString("second") + serializeString("third"), 2));
+        QCOMPARE(journal.getRecordsCount(), 3);
+    }
+
+    Helpers::RecordJournal journal(TEST_MAGIC, TEST_VERSION, TEST_MAX_RECORD_SIZE, false);
+    journal.setPath(journalPath);
+
+    Helpers::RecordJournal::ReadResult result;
+    QStringList values = readStrings(journal, result);
+
+    QCOMPARE((int)result, (int)Helpers::RecordJournal::JournalRead);
+    QCOMPARE(values, QStringList() << "first" << "second" << "third");
+    QCOMPARE(journal.getRecordsCount(), 3);
+}
+
+void RecordJournalTests::tornTailIsCutOffTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journalPath = dir.path() + "/test.journal";
+
+    qint64 sizeBeforeLastRecord = 0;
+
+    {
+        Helpers::RecordJournal journal(TEST_MAGIC, TEST_VERSION, TEST_MAX_RECORD_SIZE, false);
+        journal.setPath(journalPath);
+        QVERIFY(journal.openForAppend());
+        QVERIFY(journal.appendRecords(serializeString("first"), 1));
+        sizeBeforeLastRecord = QFileInfo(journalPath).size();
+        QVERIFY(journal.appendRecords(serializeString("second"), 1));
+    }
+
+    // simulate crash in the middle of the last write
+    QVERIFY(QFile::resize(journalPath, QFileInfo(journalPath).size() - 1));
+
+    Helpers::RecordJournal journal(TEST_MAGIC, TEST_VERSION, TEST_MAX_RECORD_SIZE, false);
+    journal.setPath(journalPath);
+
+    Helpers::RecordJournal::ReadResult result;
+    QStringList values = readStrings(journal, result);
+
+    QCOMPARE((int)result, (int)Helpers::RecordJournal::JournalRead);
+    QCOMPARE(values, QStringList() << "first");
+    QCOMPARE(QFileInfo(journalPath).size(), sizeBeforeLastRecord);
+}
+
+void RecordJournalTests::otherHeaderDataIsUnknownTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journalPath = dir.path() + "/test.journal";
+
+    {
+        Helpers::RecordJournal journal(TEST_MAGIC, TEST_VERSION, TEST_MAX_RECORD_SIZE, false);
+        journal.setPath(journalPath);
+        journal.setHeaderData(QByteArray("first"));
+        QVERIFY(journal.openForAppend());
+        QVERIFY(journal.appendRecords(serializeString("value"), 1));
+    }
+
+    Helpers::RecordJournal journal(TEST_MAGIC, TEST_VERSION, TEST_MAX_RECORD_SIZE, false);
+    journal.setPath(journalPath);
+    journal.setHeaderData(QByteArray("second"));
+
+    Helpers::RecordJournal::ReadResult result;
+    QStringList values = readStrings(journal, result);
+
+    QCOMPARE((int)result, (int)Helpers::RecordJournal::JournalUnknown);
+    QVERIFY(values.isEmpty());
+
+    journal.keepAside(".unreadable");
+    QVERIFY(!QFile::exists(journalPath));
+    QVERIFY(QFile::exists(journalPath + ".unreadable"));
+}
+
+void RecordJournalTests::replaceKeepsOnlyNewRecordsTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journalPath = dir.path() + "/test.journal";
+
+    {
+        Helpers::RecordJournal journal(TEST_MAGIC, TEST_VERSION, TEST_MAX_RECORD_SIZE, true);
+        journal.setPath(journalPath);
+        QVERIFY(journal.openForAppend());
+        QVERIFY(journal.appendRecords(serializeString("first"), 1));
+        QVERIFY(journal.appendRecords(serializeString("second"), 1));
+        QVERIFY(journal.replaceRecords(serializeString("snapshot"), 1));
+        QCOMPARE(journal.getRecordsCount(), 1);
+        QVERIFY(journal.appendRecords(serializeString("third"), 1));
+    }
+
+    Helpers::RecordJournal journal(TEST_MAGIC, TEST_VERSION, TEST_MAX_RECORD_SIZE, true);
+    journal.setPath(journalPath);
+
+    Helpers::RecordJournal::ReadResult result;
+    QStringList values = readStrings(journal, result);
+
+    QCOMPARE((int)result, (int)Helpers::RecordJournal::JournalRead);
+    QCOMPARE(values, QStringList() << "snapshot" << "third");
+}
@@ -0,0 +1,17 @@
+#ifndef RECORDJOURNALTESTS_H
+#define RECORDJOURNALTESTS_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class RecordJournalTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void recordsAreReplayedTest();
+    void tornTailIsCutOffTest();
+    void otherHeaderDataIsUnknownTest();
+    void replaceKeepsOnlyNewRecordsTest();
+};
+
+#endif // RECORDJOURNALTESTS_H
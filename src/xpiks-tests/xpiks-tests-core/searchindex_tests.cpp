@@ -0,0 +1,132 @@
+#include "searchindex_tests.h"
+#include "Mocks/artitemsmodelmock.h"
+#include "Mocks/commandmanagermock.h"
+#include "../../xpiks-qt/Models/searchindex.h"
+#include "../../xpiks-qt/Models/artworksrepository.h"
+
+#define DECLARE_MODELS_AND_GENERATE(count) \
+    Mocks::CommandManagerMock commandManagerMock;\
+    Mocks::ArtItemsModelMock artItemsModelMock;\
+    Models::ArtworksRepository artworksRepository;\
+    commandManagerMock.InjectDependency(&artworksRepository);\
+    commandManagerMock.InjectDependency(&artItemsModelMock);\
+    commandManagerMock.generateAndAddArtworks(count);\
+    for (int i = 0; i < count; ++i) {\
+        Models::ArtworkMetadata *metadata = artItemsModelMock.getArtwork(i);\
+        if (i % 2 == 0) {\
+            metadata->initialize("Sunset title", "Beach at evening", QStringList() << "sunset" << "sea shore", true);\
+        } else {\
+            metadata->initialize("Mountain title", "Peaks in fog", QStringList() << "mountain" << "rock", true);\
+        }\
+    }\
+    Models::SearchIndex searchIndex;\
+    searchIndex.update(&artItemsModelMock);
+
+static int countCandidates(Models::SearchIndex &searchIndex, Mocks::ArtItemsModelMock &artItemsModelMock,
+                           const QString &searchTerm, bool searchUsingAnd) {
+    int count = 0;
+    const int size = artItemsModelMock.getArtworksCount();
+    for (int i = 0; i < size; ++i) {
+        if (searchIndex.isCandidate(artItemsModelMock.getArtwork(i), searchTerm, searchUsingAnd)) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+void SearchIndexTests::substringCandidatesTest() {
+    DECLARE_MODELS_AND_GENERATE(10);
+
+    searchIndex.findCandidates("UNSE", false);
+    QVERIFY(searchIndex.hasCandidates());
+    QCOMPARE(countCandidates(searchIndex, artItemsModelMock, "UNSE", false), 5);
+
+    for (int i = 0; i < 10; ++i) {
+        QCOMPARE(searchIndex.isCandidate(artItemsModelMock.getArtwork(i), "UNSE", false), i % 2 == 0);
+    }
+
+    searchIndex.findCandidates("!shore", false);
+    QCOMPARE(countCandidates(searchIndex, artItemsModelMock, "!shore", false), 5);
+
+    searchIndex.findCandidates("somedirectory_1", false);
+    QCOMPARE(countCandidates(searchIndex, artItemsModelMock, "somedirectory_1", false), 5);
+
+    searchIndex.findCandidates("nothinglikethis", false);
+    QVERIFY(searchIndex.hasCandidates());
+    QCOMPARE(countCandidates(searchIndex, artItemsModelMock, "nothinglikethis", false), 0);
+}
+
+void SearchIndexTests::shortTermCandidatesTest() {
+    DECLARE_MODELS_AND_GENERATE(10);
+
+    searchIndex.findCandidates("fo", false);
+    QCOMPARE(countCandidates(searchIndex, artItemsModelMock, "fo", false), 5);
+
+    searchIndex.findCandidates("e", false);
+    QCOMPARE(countCandidates(searchIndex, artItemsModelMock, "e", false), 10);
+}
+
+void SearchIndexTests::andOrCandidatesTest() {
+    DECLARE_MODELS_AND_GENERATE(10);
+
+    searchIndex.findCandidates("sunset rock", true);
+    QCOMPARE(countCandidates(searchIndex, artItemsModelMock, "sunset rock", true), 0);
+
+    searchIndex.findCandidates("sunset rock", false);
+    QCOMPARE(countCandidates(searchIndex, artItemsModelMock, "sunset rock", false), 10);
+
+    searchIndex.findCandidates("sunset beach", true);
+    QCOMPARE(countCandidates(searchIndex, artItemsModelMock, "sunset beach", true), 5);
+
+    // different mode or term is never narrowed
+    QCOMPARE(countCandidates(searchIndex, artItemsModelMock, "sunset beach", false), 10);
+    QCOMPARE(countCandidates(searchIndex, artItemsModelMock, "sunset", true), 10);
+}
+
+void SearchIndexTests::reservedTermsAreNotNarrowedTest() {
+    DECLARE_MODELS_AND_GENERATE(10);
+
+    searchIndex.findCandidates("sunset x:modified", false);
+    QVERIFY(!searchIndex.hasCandidates());
+    QCOMPARE(countCandidates(searchIndex, artItemsModelMock, "sunset x:modified", false), 10);
+
+    searchIndex.findCandidates("sunset x:modified", true);
+    QVERIFY(searchIndex.hasCandidates());
+    QCOMPARE(countCandidates(searchIndex, artItemsModelMock, "sunset x:modified", true), 5);
+}
+
+void SearchIndexTests::editedArtworkStaysCandidateTest() {
+    DECLARE_MODELS_AND_GENERATE(10);
+
+    searchIndex.findCandidates("sunset", false);
+    Models::ArtworkMetadata *metadata = artItemsModelMock.getArtwork(1);
+    QVERIFY(!searchIndex.isCandidate(metadata, "sunset", false));
+
+    metadata->appendKeyword("sunset");
+    QVERIFY(searchIndex.isCandidate(metadata, "sunset", false));
+
+    searchIndex.update(&artItemsModelMock);
+    searchIndex.findCandidates("sunset", false);
+    QVERIFY(searchIndex.isCandidate(metadata, "sunset", false));
+    QCOMPARE(countCandidates(searchIndex, artItemsModelMock, "sunset", false), 6);
+
+    metadata->clearKeywords();
+    metadata->setTitle("");
+    searchIndex.update(&artItemsModelMock);
+    searchIndex.findCandidates("mountain", false);
+    QVERIFY(!searchIndex.isCandidate(metadata, "mountain", false));
+}
+
+void SearchIndexTests::removedArtworksAreSweptTest() {
+    DECLARE_MODELS_AND_GENERATE(10);
+
+    QCOMPARE(searchIndex.getIndexedArtworksCount(), 10);
+
+    artItemsModelMock.removeArtworks(QVector<QPair<int, int> >() << qMakePair(0, 4));
+    searchIndex.update(&artItemsModelMock);
+    QCOMPARE(searchIndex.getIndexedArtworksCount(), 5);
+
+    searchIndex.findCandidates("sunset", false);
+    QCOMPARE(countCandidates(searchIndex, artItemsModelMock, "sunset", false), 2);
+}
@@ -0,0 +1,19 @@
+#ifndef SEARCHINDEXTESTS_H
+#define SEARCHINDEXTESTS_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class SearchIndexTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void substringCandidatesTest();
+    void shortTermCandidatesTest();
+    void andOrCandidatesTest();
+    void reservedTermsAreNotNarrowedTest();
+    void editedArtworkStaysCandidateTest();
+    void removedArtworksAreSweptTest();
+};
+
+#endif // SEARCHINDEXTESTS_H
@@ -0,0 +1,100 @@
+#include "spellcheckbatch_tests.h"
+#include "../../xpiks-qt/SpellCheck/spellcheckbatch.h"
+#include "../../xpiks-qt/SpellCheck/spellcheckitem.h"
+#include "../../xpiks-qt/Common/basickeywordsmodel.h"
+#include "../../xpiks-qt/Common/flags.h"
+
+namespace {
+    std::shared_ptr<SpellCheck::ISpellCheckItem> createItem(Common::BasicKeywordsModel &model) {
+        return std::shared_ptr<SpellCheck::ISpellCheckItem>(
+                    new SpellCheck::SpellCheckItem(&model, Common::SpellCheckFlags::Keywords));
+    }
+
+    int checkWords(SpellCheck::SpellCheckBatch &batch, const QString &wrongWord) {
+        const QVector<QString> &words = batch.getWordsToCheck();
+        const int size = words.size();
+
+        for (int i = 0; i < size; ++i) {
+            batch.setVerdict(i, words.at(i) != wrongWord);
+        }
+
+        return size;
+    }
+}
+
+void SpellCheckBatchTests::sharedWordsAreCheckedOnceTest() {
+    Common::BasicKeywordsModel first(m_FakeHold), second(m_FakeHold), third(m_FakeHold);
+    first.appendKeywords(QStringList() << "sunny day" << "beach" << "wrongword");
+    second.appendKeywords(QStringList() << "beach" << "sunny" << "wrongword");
+    third.appendKeywords(QStringList() << "day" << "sea");
+
+    std::vector<std::shared_ptr<SpellCheck::ISpellCheckItem> > items;
+    items.push_back(createItem(first));
+    items.push_back(createItem(second));
+    items.push_back(createItem(third));
+
+    SpellCheck::SpellCheckBatch batch(items);
+    const int checksCount = checkWords(batch, "wrongword");
+
+    QCOMPARE(batch.getTotalWordsCount(), 9);
+    QCOMPARE(checksCount, 5);
+    QCOMPARE(batch.getItems().size(), (size_t)3);
+    QCOMPARE(batch.getWrongWords(), QStringList() << "wrongword");
+}
+
+void SpellCheckBatchTests::verdictsAreFannedOutPerIndexTest() {
+    Common::BasicKeywordsModel first(m_FakeHold), second(m_FakeHold);
+    first.appendKeywords(QStringList() << "sunny day" << "wrongword" << "beach");
+    second.appendKeywords(QStringList() << "wrongword" << "day");
+
+    std::vector<std::shared_ptr<SpellCheck::ISpellCheckItem> > items;
+    items.push_back(createItem(first));
+    items.push_back(createItem(second));
+
+    SpellCheck::SpellCheckBatch batch(items);
+    QCOMPARE(checkWords(batch, "wrongword"), 4);
+    batch.fanOutVerdicts();
+
+    auto &firstQueries = batch.getItems().at(0)->getQueries();
+    QCOMPARE(firstQueries.size(), (size_t)4);
+    QCOMPARE(firstQueries[0]->m_Word, QString("sunny"));
+    QCOMPARE(firstQueries[0]->m_Index, 0);
+    QVERIFY(firstQueries[0]->m_IsCorrect);
+    QCOMPARE(firstQueries[1]->m_Word, QString("day"));
+    QCOMPARE(firstQueries[1]->m_Index, 0);
+    QVERIFY(firstQueries[1]->m_IsCorrect);
+    QCOMPARE(firstQueries[2]->m_Index, 1);
+    QVERIFY(!firstQueries[2]->m_IsCorrect);
+    QCOMPARE(firstQueries[3]->m_Index, 2);
+    QVERIFY(firstQueries[3]->m_IsCorrect);
+
+    auto &secondQueries = batch.getItems().at(1)->getQueries();
+    QCOMPARE(secondQueries.size(), (size_t)2);
+    QCOMPARE(secondQueries[0]->m_Index, 0);
+    QVERIFY(!secondQueries[0]->m_IsCorrect);
+    QCOMPARE(secondQueries[1]->m_Index, 1);
+    QVERIFY(secondQueries[1]->m_IsCorrect);
+
+    QVERIFY(!batch.getItems().at(0)->getIsCorrect("wrongword"));
+    QVERIFY(!batch.getItems().at(1)->getIsCorrect("wrongword"));
+    QVERIFY(batch.getItems().at(1)->getIsCorrect("day"));
+}
+
+void SpellCheckBatchTests::emptyItemsAreKeptTest() {
+    Common::BasicKeywordsModel empty(m_FakeHold), other(m_FakeHold);
+    other.appendKeywords(QStringList() << "keyword");
+
+    std::vector<std::shared_ptr<SpellCheck::ISpellCheckItem> > items;
+    items.push_back(createItem(empty));
+    items.push_back(createItem(other));
+
+    SpellCheck::SpellCheckBatch batch(items);
+    QCOMPARE(checkWords(batch, "wrongword"), 1);
+    batch.fanOutVerdicts();
+
+    // every item submits its results even without words
+    QCOMPARE(batch.getItems().size(), (size_t)2);
+    QVERIFY(batch.getItems().at(0)->getQueries().empty());
+    QVERIFY(batch.getItems().at(1)->getIsCorrect("keyword"));
+    QVERIFY(batch.getWrongWords().isEmpty());
+}
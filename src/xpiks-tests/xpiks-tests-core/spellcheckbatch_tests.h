@@ -0,0 +1,20 @@
+#ifndef SPELLCHECKBATCHTESTS_H
+#define SPELLCHECKBATCHTESTS_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+#include "../../xpiks-qt/Common/hold.h"
+
+class SpellCheckBatchTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void sharedWordsAreCheckedOnceTest();
+    void verdictsAreFannedOutPerIndexTest();
+    void emptyItemsAreKeptTest();
+
+private:
+    Common::Hold m_FakeHold;
+};
+
+#endif // SPELLCHECKBATCHTESTS_H
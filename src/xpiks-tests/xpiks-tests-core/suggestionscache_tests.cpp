@@ -0,0 +1,138 @@
+#include "suggestionscache_tests.h"
+#include <QTemporaryDir>
+#include <QFile>
+#include "../../xpiks-qt/SpellCheck/suggestionscache.h"
+#include "../../xpiks-qt/SpellCheck/suggestionsworker.h"
+
+void SuggestionsCacheTests::restoreAfterReopenTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journalPath = dir.path() + "/suggestions.cache";
+
+    {
+        SpellCheck::SuggestionsCache cache;
+        cache.setJournalPath(journalPath);
+        cache.load("en_US.dic:100:1");
+        cache.insert("wrod", QStringList() << "word" << "wood");
+        cache.insert("tset", QStringList() << "test");
+    }
+
+    QVERIFY(QFile::exists(journalPath));
+
+    SpellCheck::SuggestionsCache cache;
+    cache.setJournalPath(journalPath);
+    cache.load("en_US.dic:100:1");
+
+    QStringList suggestions;
+    QCOMPARE(cache.size(), 2);
+    QVERIFY(cache.tryGetSuggestions("wrod", suggestions));
+    QCOMPARE(suggestions, QStringList() << "word" << "wood");
+    QVERIFY(cache.tryGetSuggestions("tset", suggestions));
+    QCOMPARE(suggestions, QStringList() << "test");
+}
+
+void SuggestionsCacheTests::otherDictionaryDiscardsCacheTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journalPath = dir.path() + "/suggestions.cache";
+
+    {
+        SpellCheck::SuggestionsCache cache;
+        cache.setJournalPath(journalPath);
+        cache.load("en_US.dic:100:1");
+        cache.insert("wrod", QStringList() << "word");
+    }
+
+    {
+        SpellCheck::SuggestionsCache cache;
+        cache.setJournalPath(journalPath);
+        cache.load("en_US.dic:200:2");
+        QCOMPARE(cache.size(), 0);
+        QVERIFY(!cache.contains("wrod"));
+        cache.insert("tset", QStringList() << "test");
+    }
+
+    SpellCheck::SuggestionsCache cache;
+    cache.setJournalPath(journalPath);
+    cache.load("en_US.dic:200:2");
+    QCOMPARE(cache.size(), 1);
+    QVERIFY(cache.contains("tset"));
+}
+
+void SuggestionsCacheTests::evictsInsteadOfClearingTest() {
+    SpellCheck::SuggestionsCache cache(10);
+
+    for (int i = 0; i < 100; ++i) {
+        cache.insert(QString("word%1").arg(i), QStringList() << QString::number(i));
+        QVERIFY(cache.size() <= 10);
+    }
+
+    // latest entries are always available after eviction
+    QVERIFY(cache.size() >= 5);
+    QVERIFY(cache.contains("word99"));
+    QVERIFY(cache.contains("word95"));
+    QVERIFY(!cache.contains("word0"));
+}
+
+void SuggestionsCacheTests::recentlyUsedSurviveEvictionTest() {
+    SpellCheck::SuggestionsCache cache(10);
+
+    cache.insert("frequent", QStringList() << "frequently");
+
+    QStringList suggestions;
+    for (int i = 0; i < 100; ++i) {
+        cache.insert(QString("word%1").arg(i), QStringList());
+        QVERIFY(cache.tryGetSuggestions("frequent", suggestions));
+    }
+
+    QCOMPARE(suggestions, QStringList() << "frequently");
+}
+
+void SuggestionsCacheTests::compactionKeepsEntriesTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString journalPath = dir.path() + "/suggestions.cache";
+    const int cacheSize = 100;
+    const int wordsCount = 5000;
+
+    {
+        SpellCheck::SuggestionsCache cache(cacheSize);
+        cache.setJournalPath(journalPath);
+        cache.load("en_US.dic:100:1");
+
+        for (int i = 0; i < wordsCount; ++i) {
+            cache.insert(QString("word%1").arg(i), QStringList() << QString::number(i));
+        }
+    }
+
+    const qint64 compactedSize = QFile(journalPath).size();
+
+    SpellCheck::SuggestionsCache cache(cacheSize);
+    cache.setJournalPath(journalPath);
+    cache.load("en_US.dic:100:1");
+
+    QStringList suggestions;
+    QVERIFY(cache.size() <= cacheSize);
+    QVERIFY(cache.tryGetSuggestions(QString("word%1").arg(wordsCount - 1), suggestions));
+    QCOMPARE(suggestions, QStringList() << QString::number(wordsCount - 1));
+
+    // journal does not keep all evicted entries
+    QVERIFY(compactedSize < 50 * wordsCount);
+}
+
+void SuggestionsCacheTests::prefetchSkipsCachedWordsTest() {
+    SpellCheck::SuggestionsWorker worker;
+    worker.getCache().insert("wrod", QStringList() << "word");
+
+    int queued = worker.prefetchSuggestions(QStringList() << "wrod" << "tset" << "tset" << "keywrod");
+    QCOMPARE(queued, 2);
+    QVERIFY(worker.hasPendingJobs());
+
+    queued = worker.prefetchSuggestions(QStringList() << "wrod");
+    QCOMPARE(queued, 0);
+
+    QStringList suggestions;
+    QVERIFY(worker.tryGetSuggestions("wrod", suggestions));
+    QCOMPARE(suggestions, QStringList() << "word");
+    QVERIFY(!worker.hasSuggestions("tset"));
+}
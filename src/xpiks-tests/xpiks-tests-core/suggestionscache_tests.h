@@ -0,0 +1,19 @@
+#ifndef SUGGESTIONSCACHETESTS_H
+#define SUGGESTIONSCACHETESTS_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class SuggestionsCacheTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void restoreAfterReopenTest();
+    void otherDictionaryDiscardsCacheTest();
+    void evictsInsteadOfClearingTest();
+    void recentlyUsedSurviveEvictionTest();
+    void compactionKeepsEntriesTest();
+    void prefetchSkipsCachedWordsTest();
+};
+
+#endif // SUGGESTIONSCACHETESTS_H
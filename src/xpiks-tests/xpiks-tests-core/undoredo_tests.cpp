@@ -13,6 +13,7 @@
 #include "../../xpiks-qt/Models/previewmetadataelement.h"
 #include "../../xpiks-qt/Commands/pastekeywordscommand.h"
 #include "../../xpiks-qt/Commands/findandreplacecommand.h"
+#include "../../xpiks-qt/Commands/deletekeywordscommand.h"
 #include "../../xpiks-qt/Models/filteredartitemsproxymodel.h"
 
 #define SETUP_TEST \
@@ -396,3 +397,73 @@ void UndoRedoTests::undoReplaceCommandTest() {
         QVERIFY(!artItemsMock.getArtwork(i)->isModified());
     }
 }
+
+void UndoRedoTests::undoDeleteKeywordsTest() {
+    SETUP_TEST;
+    int itemsToAdd = 5;
+    commandManagerMock.generateAndAddArtworks(itemsToAdd);
+
+    QStringList originalKeywords = QString("test1,test2,test3,test4,test5").split(',');
+    std::vector<Models::MetadataElement> infos;
+
+    for (int i = 0; i < itemsToAdd; ++i) {
+        artItemsMock.getArtwork(i)->initialize("title", "description", originalKeywords);
+        infos.emplace_back(artItemsMock.getArtwork(i), i);
+    }
+
+    QSet<QString> keywordsToDelete = QSet<QString>() << "test1" << "test4";
+    std::shared_ptr<Commands::DeleteKeywordsCommand> deleteCommand(new Commands::DeleteKeywordsCommand(infos, keywordsToDelete, false));
+    auto result = commandManagerMock.processCommand(deleteCommand);
+
+    for (int i = 0; i < itemsToAdd; ++i) {
+        QCOMPARE(artItemsMock.getArtwork(i)->getKeywords(), QString("test2,test3,test5").split(','));
+    }
+
+    bool undoStatus = undoRedoManager.undoLastAction();
+    QVERIFY(undoStatus);
+
+    for (int i = 0; i < itemsToAdd; ++i) {
+        QCOMPARE(artItemsMock.getArtwork(i)->getKeywords(), originalKeywords);
+        QCOMPARE(artItemsMock.getArtwork(i)->getTitle(), QString("title"));
+        QVERIFY(!artItemsMock.getArtwork(i)->isModified());
+    }
+}
+
+void UndoRedoTests::undoPartialReplaceTest() {
+    SETUP_TEST;
+    int itemsToAdd = 6;
+    Models::FilteredArtItemsProxyModel filteredItemsModel;
+    filteredItemsModel.setSourceModel(artItemsModel);
+    commandManagerMock.InjectDependency(&filteredItemsModel);
+    commandManagerMock.generateAndAddArtworks(itemsToAdd);
+
+    for (int i = 0; i < itemsToAdd; i++) {
+        Models::ArtworkMetadata *metadata = artItemsModel->getArtwork(i);
+        QString description = (i % 2 == 0) ? "ReplaceMe" : "Other";
+        metadata->initialize("title", description, QStringList() << "keyword" << QString("other%1").arg(i));
+    }
+
+    QString replaceFrom = "Replace";
+    auto flags = Common::SearchFlags::CaseSensitive | Common::SearchFlags::Description;
+    std::vector<Models::PreviewMetadataElement> artWorksInfo;
+    for (int i = 0; i < itemsToAdd; ++i) {
+        artWorksInfo.emplace_back(artItemsModel->getArtwork(i), i);
+    }
+
+    std::shared_ptr<Commands::FindAndReplaceCommand> replaceCommand(new Commands::FindAndReplaceCommand(artWorksInfo, replaceFrom, "Replaced", flags));
+    auto result = commandManagerMock.processCommand(replaceCommand);
+
+    for (int i = 0; i < itemsToAdd; i += 2) {
+        QCOMPARE(artItemsMock.getArtwork(i)->getDescription(), QString("ReplacedMe"));
+    }
+
+    bool undoStatus = undoRedoManager.undoLastAction();
+    QVERIFY(undoStatus);
+
+    for (int i = 0; i < itemsToAdd; ++i) {
+        Models::ArtworkMetadata *metadata = artItemsMock.getArtwork(i);
+        QCOMPARE(metadata->getDescription(), (i % 2 == 0) ? QString("ReplaceMe") : QString("Other"));
+        QCOMPARE(metadata->getKeywords(), QStringList() << "keyword" << QString("other%1").arg(i));
+        QVERIFY(!metadata->isModified());
+    }
+}
@@ -19,6 +19,8 @@ private slots:
     void undoClearAllTest();
     void undoClearKeywordsTest();
     void undoReplaceCommandTest();
+    void undoDeleteKeywordsTest();
+    void undoPartialReplaceTest();
 };
 
 #endif // UNDOREDOTESTS_H
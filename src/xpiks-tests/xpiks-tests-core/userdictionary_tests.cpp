@@ -0,0 +1,144 @@
+#include "userdictionary_tests.h"
+#include <QTemporaryDir>
+#include <QFile>
+#include <QTextStream>
+#include "../../xpiks-qt/SpellCheck/userdictionary.h"
+
+void UserDictionaryTests::addWordsIgnoresCaseTest() {
+    SpellCheck::UserDictionary dictionary;
+    dictionary.addWords(QStringList() << "Xpiks" << "xpiks" << "keyword");
+
+    QCOMPARE(dictionary.size(), 2);
+    QVERIFY(dictionary.contains("XPIKS"));
+    QVERIFY(dictionary.contains("Keyword"));
+    QCOMPARE(dictionary.getWords(), QStringList() << "Xpiks" << "keyword");
+}
+
+void UserDictionaryTests::restoreAfterReopenTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString compiledPath = dir.path() + "/userdict.compiled";
+    const QString journalPath = dir.path() + "/userdict.journal";
+
+    {
+        SpellCheck::UserDictionary dictionary;
+        dictionary.setPaths(compiledPath, journalPath);
+        QVERIFY(!dictionary.load());
+        dictionary.addWord("first");
+        dictionary.addWords(QStringList() << "second" << "third");
+    }
+
+    QVERIFY(QFile::exists(compiledPath));
+
+    SpellCheck::UserDictionary dictionary;
+    dictionary.setPaths(compiledPath, journalPath);
+    QVERIFY(dictionary.load());
+
+    QCOMPARE(dictionary.getWords(), QStringList() << "first" << "second" << "third");
+    QVERIFY(dictionary.contains("Second"));
+}
+
+void UserDictionaryTests::resetWritesDifferenceTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString compiledPath = dir.path() + "/userdict.compiled";
+    const QString journalPath = dir.path() + "/userdict.journal";
+
+    {
+        SpellCheck::UserDictionary dictionary;
+        dictionary.setPaths(compiledPath, journalPath);
+        dictionary.load();
+        dictionary.addWords(QStringList() << "one" << "two" << "three");
+        dictionary.close();
+
+        dictionary.load();
+        dictionary.reset(QStringList() << "three" << "four" << "one");
+
+        QCOMPARE(dictionary.getWords(), QStringList() << "one" << "three" << "four");
+    }
+
+    SpellCheck::UserDictionary dictionary;
+    dictionary.setPaths(compiledPath, journalPath);
+    dictionary.load();
+
+    QCOMPARE(dictionary.getWords(), QStringList() << "one" << "three" << "four");
+    QVERIFY(!dictionary.contains("two"));
+}
+
+void UserDictionaryTests::clearIsPersistedTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString compiledPath = dir.path() + "/userdict.compiled";
+    const QString journalPath = dir.path() + "/userdict.journal";
+
+    {
+        SpellCheck::UserDictionary dictionary;
+        dictionary.setPaths(compiledPath, journalPath);
+        dictionary.load();
+        dictionary.addWords(QStringList() << "one" << "two");
+        dictionary.clear();
+        dictionary.addWord("three");
+    }
+
+    SpellCheck::UserDictionary dictionary;
+    dictionary.setPaths(compiledPath, journalPath);
+    dictionary.load();
+
+    QCOMPARE(dictionary.getWords(), QStringList() << "three");
+}
+
+void UserDictionaryTests::importTextDictionaryTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString textPath = dir.path() + "/userdict.dic";
+
+    {
+        QFile file(textPath);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QTextStream stream(&file);
+        stream << "Xpiks" << endl << "microstock" << endl;
+    }
+
+    {
+        SpellCheck::UserDictionary dictionary;
+        dictionary.setPaths(dir.path() + "/userdict.compiled", dir.path() + "/userdict.journal");
+        QVERIFY(!dictionary.load());
+        QVERIFY(dictionary.importWords(textPath));
+        QCOMPARE(dictionary.size(), 2);
+    }
+
+    SpellCheck::UserDictionary dictionary;
+    dictionary.setPaths(dir.path() + "/userdict.compiled", dir.path() + "/userdict.journal");
+    QVERIFY(dictionary.load());
+    QCOMPARE(dictionary.getWords(), QStringList() << "Xpiks" << "microstock");
+}
+
+void UserDictionaryTests::unreadableSnapshotIsKeptTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString compiledPath = dir.path() + "/userdict.compiled";
+    const QString journalPath = dir.path() + "/userdict.journal";
+    const QByteArray garbage("not a dictionary");
+
+    {
+        QFile compiledFile(compiledPath);
+        QVERIFY(compiledFile.open(QIODevice::WriteOnly));
+        compiledFile.write(garbage);
+    }
+
+    {
+        SpellCheck::UserDictionary dictionary;
+        dictionary.setPaths(compiledPath, journalPath);
+        QVERIFY(!dictionary.load());
+        dictionary.addWord("word");
+    }
+
+    QFile backupFile(compiledPath + ".unreadable");
+    QVERIFY(backupFile.open(QIODevice::ReadOnly));
+    QCOMPARE(backupFile.readAll(), garbage);
+
+    SpellCheck::UserDictionary dictionary;
+    dictionary.setPaths(compiledPath, journalPath);
+    QVERIFY(dictionary.load());
+    QCOMPARE(dictionary.getWords(), QStringList() << "word");
+}
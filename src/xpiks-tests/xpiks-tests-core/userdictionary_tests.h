@@ -0,0 +1,19 @@
+#ifndef USERDICTIONARYTESTS_H
+#define USERDICTIONARYTESTS_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class UserDictionaryTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void addWordsIgnoresCaseTest();
+    void restoreAfterReopenTest();
+    void resetWritesDifferenceTest();
+    void clearIsPersistedTest();
+    void importTextDictionaryTest();
+    void unreadableSnapshotIsKeptTest();
+};
+
+#endif // USERDICTIONARYTESTS_H
@@ -0,0 +1,103 @@
+#include "wordsverdictcache_tests.h"
+#include "../../xpiks-qt/SpellCheck/wordsverdictcache.h"
+
+void WordsVerdictCacheTests::storesBothVerdictsTest() {
+    SpellCheck::WordsVerdictCache cache;
+    bool isCorrect = false;
+
+    QVERIFY(!cache.tryGetVerdict("keyword", isCorrect));
+
+    cache.storeVerdict("keyword", true);
+    cache.storeVerdict("kyeword", false);
+
+    QVERIFY(cache.tryGetVerdict("keyword", isCorrect));
+    QVERIFY(isCorrect);
+    QVERIFY(cache.tryGetVerdict("kyeword", isCorrect));
+    QVERIFY(!isCorrect);
+    QCOMPARE(cache.size(), 2);
+}
+
+void WordsVerdictCacheTests::invalidateIgnoresCaseTest() {
+    SpellCheck::WordsVerdictCache cache;
+    bool isCorrect = false;
+
+    cache.storeVerdict("Xpiks", false);
+    cache.storeVerdict("xpiks", false);
+    cache.storeVerdict("keyword", true);
+
+    int removed = cache.invalidate(QStringList() << "XPIKS");
+
+    QCOMPARE(removed, 2);
+    QVERIFY(!cache.tryGetVerdict("Xpiks", isCorrect));
+    QVERIFY(!cache.tryGetVerdict("xpiks", isCorrect));
+    QVERIFY(cache.tryGetVerdict("keyword", isCorrect));
+}
+
+void WordsVerdictCacheTests::invalidateMixedCaseVariantsTest() {
+    SpellCheck::WordsVerdictCache cache;
+    bool isCorrect = false;
+
+    cache.storeVerdict("XpIkS", false);
+    cache.storeVerdict("XPIKS", false);
+    cache.storeVerdict("xpiks", false);
+    cache.storeVerdict("XPIKS", true);
+    cache.storeVerdict("Other", true);
+
+    QCOMPARE(cache.invalidate(QStringList() << "xpiks"), 3);
+    QCOMPARE(cache.size(), 1);
+    QVERIFY(cache.tryGetVerdict("Other", isCorrect));
+
+    cache.storeVerdict("XpIkS", true);
+    QCOMPARE(cache.invalidate(QStringList() << "Xpiks"), 1);
+    QCOMPARE(cache.invalidate(QStringList() << "other"), 1);
+    QCOMPARE(cache.size(), 0);
+}
+
+void WordsVerdictCacheTests::invalidateAfterEvictionTest() {
+    const int maxSize = 64;
+    SpellCheck::WordsVerdictCache cache(maxSize);
+    QStringList words;
+
+    for (int i = 0; i < 10*maxSize; ++i) {
+        QString word = QString("Word%1").arg(i);
+        cache.storeVerdict(word, true);
+        words.append(word.toLower());
+    }
+
+    const int cachedCount = cache.size();
+    QVERIFY(cachedCount <= maxSize);
+
+    QCOMPARE(cache.invalidate(words), cachedCount);
+    QCOMPARE(cache.size(), 0);
+}
+
+void WordsVerdictCacheTests::cacheIsBoundedTest() {
+    const int maxSize = 320;
+    SpellCheck::WordsVerdictCache cache(maxSize);
+
+    for (int i = 0; i < 10*maxSize; ++i) {
+        cache.storeVerdict(QString("word%1").arg(i), (i % 2) == 0);
+    }
+
+    QVERIFY(cache.size() <= maxSize);
+    QVERIFY(cache.size() > 0);
+}
+
+void WordsVerdictCacheTests::hitRateTest() {
+    SpellCheck::WordsVerdictCache cache;
+    bool isCorrect = false;
+
+    cache.storeVerdict("keyword", true);
+
+    QVERIFY(cache.tryGetVerdict("keyword", isCorrect));
+    QVERIFY(cache.tryGetVerdict("keyword", isCorrect));
+    QVERIFY(cache.tryGetVerdict("keyword", isCorrect));
+    QVERIFY(!cache.tryGetVerdict("other", isCorrect));
+
+    QCOMPARE(cache.getHitsCount(), 3);
+    QCOMPARE(cache.getMissesCount(), 1);
+    QCOMPARE(cache.getHitRate(), 0.75);
+
+    cache.clear();
+    QCOMPARE(cache.getHitRate(), 0.0);
+}
@@ -0,0 +1,19 @@
+#ifndef WORDSVERDICTCACHETESTS_H
+#define WORDSVERDICTCACHETESTS_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+
+class WordsVerdictCacheTests: public QObject
+{
+    Q_OBJECT
+private slots:
+    void storesBothVerdictsTest();
+    void invalidateIgnoresCaseTest();
+    void invalidateMixedCaseVariantsTest();
+    void invalidateAfterEvictionTest();
+    void cacheIsBoundedTest();
+    void hitRateTest();
+};
+
+#endif // WORDSVERDICTCACHETESTS_H
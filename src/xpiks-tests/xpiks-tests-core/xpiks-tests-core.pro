@@ -82,6 +82,8 @@ SOURCES += main.cpp \
     addcommand_tests.cpp \
     ../../xpiks-qt/Models/artitemsmodel.cpp \
         ../../xpiks-qt/Models/filteredartitemsproxymodel.cpp \
+        ../../xpiks-qt/Models/searchindex.cpp \
+        ../../xpiks-qt/Models/filterengine.cpp \
     ../../xpiks-qt/Commands/addartworkscommand.cpp \
     ../../xpiks-qt/Models/artworksprocessor.cpp \
     ../../xpiks-qt/Models/combinedartworksmodel.cpp \
@@ -98,6 +100,10 @@ SOURCES += main.cpp \
     removecommand_tests.cpp \
     vectorfilenames_tests.cpp \
     ../../xpiks-qt/Helpers/filenameshelpers.cpp \
+    ../../xpiks-qt/Helpers/filehelpers.cpp \
+    ../../xpiks-qt/Helpers/recordjournal.cpp \
+    ../../xpiks-qt/Helpers/directoryscanner.cpp \
+    ../../xpiks-qt/Helpers/fileswatcher.cpp \
     ../../xpiks-qt/Helpers/helpersqmlwrapper.cpp \
     ../../xpiks-qt/Models/recentdirectoriesmodel.cpp \
     ../../xpiks-qt/Helpers/keywordshelpers.cpp \
@@ -106,10 +112,17 @@ SOURCES += main.cpp \
     ../../xpiks-qt/SpellCheck/spellcheckworker.cpp \
     ../../xpiks-qt/SpellCheck/spellchecksuggestionmodel.cpp \
     ../../xpiks-qt/MetadataIO/backupsaverservice.cpp \
+    ../../xpiks-qt/MetadataIO/backupjournal.cpp \
     ../../xpiks-qt/MetadataIO/backupsaverworker.cpp \
     ../../xpiks-qt/SpellCheck/spellcheckiteminfo.cpp \
     ../../xpiks-qt/SpellCheck/spellsuggestionsitem.cpp \
     ../../xpiks-qt/Common/basickeywordsmodel.cpp \
+    ../../xpiks-qt/Common/keywordspool.cpp \
+    ../../xpiks-qt/SpellCheck/wordsverdictcache.cpp \
+    ../../xpiks-qt/SpellCheck/spellcheckbatch.cpp \
+    ../../xpiks-qt/SpellCheck/suggestionsworker.cpp \
+    ../../xpiks-qt/SpellCheck/suggestionscache.cpp \
+    ../../xpiks-qt/SpellCheck/userdictionary.cpp \
     ../../xpiks-qt/Common/basicmetadatamodel.cpp \
     ../../xpiks-qt/SpellCheck/spellcheckerrorshighlighter.cpp \
     artworkmetadata_tests.cpp \
@@ -125,6 +138,9 @@ SOURCES += main.cpp \
     ../../xpiks-qt/Suggestion/locallibrary.cpp \
     ../../xpiks-qt/Suggestion/libraryloaderworker.cpp \
     ../../xpiks-qt/MetadataIO/metadatawritingworker.cpp \
+    ../../xpiks-qt/MetadataIO/exiftoolprocess.cpp \
+    ../../xpiks-qt/MetadataIO/exiftooljsonparser.cpp \
+    ../../xpiks-qt/MetadataIO/metadatareadcache.cpp \
     filteredmodel_tests.cpp \
     conectivityhelpers_tests.cpp \
     ../../xpiks-qt/Conectivity/conectivityhelpers.cpp \
@@ -158,6 +174,20 @@ SOURCES += main.cpp \
     preset_tests.cpp \
     ../../xpiks-qt/Commands/expandpresetcommand.cpp \
     quickbuffer_tests.cpp \
+    exiftooljsonparser_tests.cpp \
+    metadatareadcache_tests.cpp \
+    backupjournal_tests.cpp \
+    recordjournal_tests.cpp \
+    directoryscanner_tests.cpp \
+    fileswatcher_tests.cpp \
+    searchindex_tests.cpp \
+    filterengine_tests.cpp \
+    keywordspool_tests.cpp \
+    wordsverdictcache_tests.cpp \
+    userdictionary_tests.cpp \
+    suggestionscache_tests.cpp \
+    itemprocessingworker_tests.cpp \
+    spellcheckbatch_tests.cpp \
     ../../xpiks-qt/QuickBuffer/currenteditableartwork.cpp \
     ../../xpiks-qt/QuickBuffer/currenteditableproxyartwork.cpp \
     ../../xpiks-qt/QuickBuffer/quickbuffer.cpp \
@@ -179,6 +209,8 @@ HEADERS += \
     addcommand_tests.h \
     ../../xpiks-qt/Models/artitemsmodel.h \
         ../../xpiks-qt/Models/filteredartitemsproxymodel.h \
+        ../../xpiks-qt/Models/searchindex.h \
+        ../../xpiks-qt/Models/filterengine.h \
     Mocks/artitemsmodelmock.h \
     ../../xpiks-qt/Commands/addartworkscommand.h \
     ../../xpiks-qt/Models/artworksprocessor.h \
@@ -197,9 +229,19 @@ HEADERS += \
     Mocks/artworkmetadatamock.h \
     removecommand_tests.h \
     ../../xpiks-qt/Common/basickeywordsmodel.h \
+    ../../xpiks-qt/Common/keywordspool.h \
+    ../../xpiks-qt/SpellCheck/wordsverdictcache.h \
+    ../../xpiks-qt/SpellCheck/spellcheckbatch.h \
+    ../../xpiks-qt/SpellCheck/suggestionsworker.h \
+    ../../xpiks-qt/SpellCheck/suggestionscache.h \
+    ../../xpiks-qt/SpellCheck/userdictionary.h \
     ../../xpiks-qt/Common/basicmetadatamodel.h \
     vectorfilenames_tests.h \
     ../../xpiks-qt/Helpers/filenameshelpers.h \
+    ../../xpiks-qt/Helpers/filehelpers.h \
+    ../../xpiks-qt/Helpers/recordjournal.h \
+    ../../xpiks-qt/Helpers/directoryscanner.h \
+    ../../xpiks-qt/Helpers/fileswatcher.h \
     ../../xpiks-qt/Helpers/helpersqmlwrapper.h \
     ../../xpiks-qt/Models/recentdirectoriesmodel.h \
     ../../xpiks-qt/Helpers/keywordshelpers.h \
@@ -209,6 +251,7 @@ HEADERS += \
     ../../xpiks-qt/SpellCheck/spellcheckworker.h \
     ../../xpiks-qt/SpellCheck/spellchecksuggestionmodel.h \
     ../../xpiks-qt/MetadataIO/backupsaverservice.h \
+    ../../xpiks-qt/MetadataIO/backupjournal.h \
     ../../xpiks-qt/MetadataIO/backupsaverworker.h \
     ../../xpiks-qt/Conectivity/analyticsuserevent.h \
     ../../xpiks-qt/SpellCheck/spellcheckiteminfo.h \
@@ -228,6 +271,9 @@ HEADERS += \
     ../../xpiks-qt/Suggestion/locallibrary.h \
     ../../xpiks-qt/Suggestion/libraryloaderworker.h \
     ../../xpiks-qt/MetadataIO/metadatawritingworker.h \
+    ../../xpiks-qt/MetadataIO/exiftoolprocess.h \
+    ../../xpiks-qt/MetadataIO/exiftooljsonparser.h \
+    ../../xpiks-qt/MetadataIO/metadatareadcache.h \
     filteredmodel_tests.h \
     ../../xpiks-qt/Common/baseentity.h \
     ../../xpiks-qt/Common/defines.h \
@@ -277,6 +323,20 @@ HEADERS += \
     preset_tests.h \
     ../../xpiks-qt/Commands/expandpresetcommand.h \
     quickbuffer_tests.h \
+    exiftooljsonparser_tests.h \
+    metadatareadcache_tests.h \
+    backupjournal_tests.h \
+    recordjournal_tests.h \
+    directoryscanner_tests.h \
+    fileswatcher_tests.h \
+    searchindex_tests.h \
+    filterengine_tests.h \
+    keywordspool_tests.h \
+    wordsverdictcache_tests.h \
+    userdictionary_tests.h \
+    suggestionscache_tests.h \
+    itemprocessingworker_tests.h \
+    spellcheckbatch_tests.h \
     ../../xpiks-qt/QuickBuffer/currenteditableartwork.h \
     ../../xpiks-qt/QuickBuffer/currenteditableproxyartwork.h \
     ../../xpiks-qt/QuickBuffer/icurrenteditable.h \
@@ -30,6 +30,12 @@ SOURCES += main.cpp \
     ../../xpiks-qt/Commands/pastekeywordscommand.cpp \
     ../../xpiks-qt/Commands/removeartworkscommand.cpp \
     ../../xpiks-qt/Common/basickeywordsmodel.cpp \
+    ../../xpiks-qt/Common/keywordspool.cpp \
+    ../../xpiks-qt/SpellCheck/wordsverdictcache.cpp \
+    ../../xpiks-qt/SpellCheck/spellcheckbatch.cpp \
+    ../../xpiks-qt/SpellCheck/suggestionsworker.cpp \
+    ../../xpiks-qt/SpellCheck/suggestionscache.cpp \
+    ../../xpiks-qt/SpellCheck/userdictionary.cpp \
     ../../xpiks-qt/Common/basicmetadatamodel.cpp \
     ../../xpiks-qt/Conectivity/conectivityhelpers.cpp \
     ../../xpiks-qt/Conectivity/curlftpuploader.cpp \
@@ -42,6 +48,10 @@ SOURCES += main.cpp \
     ../../xpiks-qt/Encryption/aes-qt.cpp \
     ../../xpiks-qt/Encryption/secretsmanager.cpp \
     ../../xpiks-qt/Helpers/filenameshelpers.cpp \
+    ../../xpiks-qt/Helpers/filehelpers.cpp \
+    ../../xpiks-qt/Helpers/recordjournal.cpp \
+    ../../xpiks-qt/Helpers/directoryscanner.cpp \
+    ../../xpiks-qt/Helpers/fileswatcher.cpp \
     ../../xpiks-qt/Helpers/filterhelpers.cpp \
     ../../xpiks-qt/Helpers/globalimageprovider.cpp \
     ../../xpiks-qt/Helpers/helpersqmlwrapper.cpp \
@@ -55,10 +65,14 @@ SOURCES += main.cpp \
     ../../xpiks-qt/Helpers/ziphelper.cpp \
     ../../xpiks-qt/Conectivity/updateservice.cpp \
     ../../xpiks-qt/MetadataIO/backupsaverservice.cpp \
+    ../../xpiks-qt/MetadataIO/backupjournal.cpp \
     ../../xpiks-qt/MetadataIO/backupsaverworker.cpp \
     ../../xpiks-qt/MetadataIO/metadataiocoordinator.cpp \
     ../../xpiks-qt/MetadataIO/metadatareadingworker.cpp \
     ../../xpiks-qt/MetadataIO/metadatawritingworker.cpp \
+    ../../xpiks-qt/MetadataIO/exiftoolprocess.cpp \
+    ../../xpiks-qt/MetadataIO/exiftooljsonparser.cpp \
+    ../../xpiks-qt/MetadataIO/metadatareadcache.cpp \
     ../../xpiks-qt/MetadataIO/saverworkerjobitem.cpp \
     ../../xpiks-qt/Models/artitemsmodel.cpp \
     ../../xpiks-qt/Models/artworkmetadata.cpp \
@@ -67,6 +81,8 @@ SOURCES += main.cpp \
     ../../xpiks-qt/Models/artworkuploader.cpp \
     ../../xpiks-qt/Models/combinedartworksmodel.cpp \
     ../../xpiks-qt/Models/filteredartitemsproxymodel.cpp \
+    ../../xpiks-qt/Models/searchindex.cpp \
+    ../../xpiks-qt/Models/filterengine.cpp \
     ../../xpiks-qt/Models/languagesmodel.cpp \
     ../../xpiks-qt/Models/logsmodel.cpp \
     ../../xpiks-qt/Models/recentdirectoriesmodel.cpp \
@@ -124,6 +140,7 @@ SOURCES += main.cpp \
     undoaddwithvectorstest.cpp \
     ../../xpiks-qt/MetadataIO/exiv2readingworker.cpp \
     ../../xpiks-qt/MetadataIO/readingorchestrator.cpp \
+    ../../xpiks-qt/MetadataIO/exiv2metadatacache.cpp \
     ../../xpiks-qt/MetadataIO/exiv2writingworker.cpp \
     ../../xpiks-qt/MetadataIO/writingorchestrator.cpp \
     ../../xpiks-qt/Common/flags.cpp \
@@ -194,6 +211,12 @@ HEADERS += \
     ../../xpiks-qt/Commands/removeartworkscommand.h \
     ../../xpiks-qt/Common/baseentity.h \
     ../../xpiks-qt/Common/basickeywordsmodel.h \
+    ../../xpiks-qt/Common/keywordspool.h \
+    ../../xpiks-qt/SpellCheck/wordsverdictcache.h \
+    ../../xpiks-qt/SpellCheck/spellcheckbatch.h \
+    ../../xpiks-qt/SpellCheck/suggestionsworker.h \
+    ../../xpiks-qt/SpellCheck/suggestionscache.h \
+    ../../xpiks-qt/SpellCheck/userdictionary.h \
     ../../xpiks-qt/Common/basicmetadatamodel.h \
     ../../xpiks-qt/Common/defines.h \
     ../../xpiks-qt/Common/flags.h \
@@ -220,6 +243,10 @@ HEADERS += \
     ../../xpiks-qt/Helpers/clipboardhelper.h \
     ../../xpiks-qt/Helpers/constants.h \
     ../../xpiks-qt/Helpers/filenameshelpers.h \
+    ../../xpiks-qt/Helpers/filehelpers.h \
+    ../../xpiks-qt/Helpers/recordjournal.h \
+    ../../xpiks-qt/Helpers/directoryscanner.h \
+    ../../xpiks-qt/Helpers/fileswatcher.h \
     ../../xpiks-qt/Helpers/filterhelpers.h \
     ../../xpiks-qt/Helpers/globalimageprovider.h \
     ../../xpiks-qt/Helpers/helpersqmlwrapper.h \
@@ -233,10 +260,14 @@ HEADERS += \
     ../../xpiks-qt/Helpers/ziphelper.h \
     ../../xpiks-qt/Conectivity/updateservice.h \
     ../../xpiks-qt/MetadataIO/backupsaverservice.h \
+    ../../xpiks-qt/MetadataIO/backupjournal.h \
     ../../xpiks-qt/MetadataIO/backupsaverworker.h \
     ../../xpiks-qt/MetadataIO/metadataiocoordinator.h \
     ../../xpiks-qt/MetadataIO/metadatareadingworker.h \
     ../../xpiks-qt/MetadataIO/metadatawritingworker.h \
+    ../../xpiks-qt/MetadataIO/exiftoolprocess.h \
+    ../../xpiks-qt/MetadataIO/exiftooljsonparser.h \
+    ../../xpiks-qt/MetadataIO/metadatareadcache.h \
     ../../xpiks-qt/MetadataIO/saverworkerjobitem.h \
     ../../xpiks-qt/Common/abstractlistmodel.h \
     ../../xpiks-qt/Models/metadataelement.h \
@@ -248,6 +279,8 @@ HEADERS += \
     ../../xpiks-qt/Models/combinedartworksmodel.h \
     ../../xpiks-qt/Models/exportinfo.h \
     ../../xpiks-qt/Models/filteredartitemsproxymodel.h \
+    ../../xpiks-qt/Models/searchindex.h \
+    ../../xpiks-qt/Models/filterengine.h \
     ../../xpiks-qt/Models/languagesmodel.h \
     ../../xpiks-qt/Models/logsmodel.h \
     ../../xpiks-qt/Models/recentdirectoriesmodel.h \
@@ -314,12 +347,15 @@ HEADERS += \
     ../../xpiks-qt/Helpers/remoteconfig.h \
     autocompletebasictest.h \
     ../../xpiks-qt/Common/hold.h \
+    ../../xpiks-qt/Common/sharedworkqueue.h \
     ../../xpiks-qt/Models/imageartwork.h \
     undoaddwithvectorstest.h \
     ../../xpiks-qt/MetadataIO/exiv2readingworker.h \
     ../../xpiks-qt/MetadataIO/imetadatareader.h \
     ../../xpiks-qt/MetadataIO/importdataresult.h \
     ../../xpiks-qt/MetadataIO/readingorchestrator.h \
+    ../../xpiks-qt/MetadataIO/importresultscollector.h \
+    ../../xpiks-qt/MetadataIO/exiv2metadatacache.h \
     ../../xpiks-qt/MetadataIO/exiv2writingworker.h \
     ../../xpiks-qt/MetadataIO/imetadatawriter.h \
     ../../xpiks-qt/MetadataIO/exiv2tagnames.h \